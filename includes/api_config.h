@@ -11,11 +11,11 @@
 
 #if defined(__LPC11E6X__)
 
-#include "arm_cortex_m0plus.h"
+#include "architecture/arm_cortex_m0plus.h"
 
 #elif defined(__ARCH_AMD64__)
 
-#include "intel_x86_64.h"
+#include "architecture/intel_x86_64.h"
 
 #elif defined(PART_TM4C123GH6PM)
 
@@ -0,0 +1,83 @@
+/**************************************************************************//**
+ * @file     arm_cortex_m0plus.h
+ * @brief    MCU: ARM Cortex-M0+ (e.g. NXP LPC11E6x)
+ * @date     October/2026
+ * @author   Artur Rodrigues
+ ******************************************************************************/
+
+#ifndef INC_ARCH_ARM_CORTEX_M0PLUS_H_
+#define INC_ARCH_ARM_CORTEX_M0PLUS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#define STATIC static
+#define EXTERN extern
+#define INLINE inline
+
+/** There's no data cache: there's nothing to gain by padding to a line */
+#define ARCH_CACHE_LINE_SZ  ( 4 )
+
+/**
+ * Critical sections mask all interruptions (PRIMASK): ARMv6-M has no BASEPRI.
+ * Keep them short. Nestable.
+ */
+#define ARCH_HAS_CRIT
+
+/** Lock. A single core: the interruption mask is enough, nothing to store */
+typedef struct
+{
+    uint8_t rsvd;
+}arch_lock_t;
+
+#define ARCH_LOCK_INIT      { 0 }
+
+/** State saved when entering a critical section */
+typedef uint32_t arch_crit_t;
+
+static INLINE arch_crit_t Arch_CritEnter(arch_lock_t *pLock)
+{
+    uint32_t old;
+
+    (void)pLock;
+    __asm volatile ( "mrs %0, primask" : "=r" (old) );
+    __asm volatile ( "cpsid i" : : : "memory" );
+
+    return old;
+}
+
+static INLINE void Arch_CritExit(arch_lock_t *pLock, arch_crit_t pSt)
+{
+    (void)pLock;
+    __asm volatile ( "msr primask, %0" : : "r" (pSt) : "memory" );
+}
+
+/**
+ * ARMv6-M has no exclusive accesses (LDREX/STREX): the __atomic read-modify-write
+ * builtins become calls to __atomic_fetch_or_4 and the like, which bare-metal
+ * libraries don't provide. These mask the interruptions instead, which also
+ * orders the accesses: the memory order is not needed.
+ */
+#define ARCH_ATOMIC_OR32( __ptr, __mask, __order )  Arch_AtomicOr32( (__ptr), (__mask) )
+#define ARCH_ATOMIC_AND32( __ptr, __mask, __order ) Arch_AtomicAnd32( (__ptr), (__mask) )
+
+static INLINE void Arch_AtomicOr32(volatile uint32_t *pPtr, uint32_t pMask)
+{
+    arch_crit_t st = Arch_CritEnter( NULL );
+
+    *pPtr |= pMask;
+    Arch_CritExit( NULL, st );
+}
+
+static INLINE void Arch_AtomicAnd32(volatile uint32_t *pPtr, uint32_t pMask)
+{
+    arch_crit_t st = Arch_CritEnter( NULL );
+
+    *pPtr &= pMask;
+    Arch_CritExit( NULL, st );
+}
+
+
+
+#endif /* INC_ARCH_ARM_CORTEX_M0PLUS_H_ */
@@ -0,0 +1,107 @@
+/**************************************************************************//**
+ * @file     intel_x86_64.h
+ * @brief    Host: x86-64 (Linux gateway and host builds)
+ * @date     October/2026
+ * @author   Artur Rodrigues
+ ******************************************************************************/
+
+#ifndef INC_ARCH_INTEL_X86_64_H_
+#define INC_ARCH_INTEL_X86_64_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <sched.h>
+
+#define STATIC static
+#define EXTERN extern
+#define INLINE inline
+
+/** Size of a data cache line (bytes) */
+#define ARCH_CACHE_LINE_SZ  ( 64 )
+
+/**
+ * Critical sections take a recursive spinlock: the same thread may enter
+ * again while it holds it. A waiting thread yields the CPU after a few spins,
+ * in case the holder was preempted. Signal handlers must not use them.
+ */
+#define ARCH_HAS_CRIT
+
+#if !defined(ARCH_LOCK_SPINS)
+#define ARCH_LOCK_SPINS     ( 64 )
+#endif
+
+/** Lock */
+typedef struct
+{
+    volatile uintptr_t owner;   ///< Holder thread, 0 when free
+    uint32_t depth;             ///< Nesting depth of the holder
+}arch_lock_t;
+
+#define ARCH_LOCK_INIT      { 0, 0 }
+
+/** State saved when entering a critical section. Not used: the lock keeps the depth. */
+typedef uint32_t arch_crit_t;
+
+/*
+ * Thread identity: the thread control block address, unique per live thread
+ */
+static INLINE uintptr_t _arch_self(void)
+{
+    uintptr_t self;
+
+    __asm volatile ( "mov %%fs:0, %0" : "=r" (self) );
+    return self;
+}
+
+static INLINE arch_crit_t Arch_CritEnter(arch_lock_t *pLock)
+{
+    uintptr_t self = _arch_self();
+    uintptr_t exp;
+    uint32_t spins = 0;
+
+    if( __atomic_load_n( &pLock->owner, __ATOMIC_RELAXED ) == self )
+    {
+        pLock->depth++;
+        return 0;
+    }
+
+    for(;;)
+    {
+        exp = 0;
+        if( __atomic_compare_exchange_n( &pLock->owner, &exp, self, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+        {
+            break;
+        }
+        //espera sem escrever na linha do lock
+        while( __atomic_load_n( &pLock->owner, __ATOMIC_RELAXED ) != 0 )
+        {
+            if( ++spins < ARCH_LOCK_SPINS )
+            {
+                __builtin_ia32_pause();
+            }
+            else
+            {
+                spins = 0;
+                sched_yield();
+            }
+        }
+    }
+
+    pLock->depth = 1;
+    return 0;
+}
+
+static INLINE void Arch_CritExit(arch_lock_t *pLock, arch_crit_t pSt)
+{
+    (void)pSt;
+
+    if( --pLock->depth == 0 )
+    {
+        __atomic_store_n( &pLock->owner, 0, __ATOMIC_RELEASE );
+    }
+}
+
+
+
+#endif /* INC_ARCH_INTEL_X86_64_H_ */
@@ -16,6 +16,70 @@
 #define EXTERN extern
 #define INLINE inline
 
+/** There's no data cache: there's nothing to gain by padding to a line */
+#define ARCH_CACHE_LINE_SZ  ( 4 )
+
+/** RAM kept across resets. The linker command file must place .noinit as NOLOAD */
+#define ATTR_NOINIT         __attribute__(( section( ".noinit" ) ))
+
+/**
+ * Critical sections mask interruptions by priority (BASEPRI): those with a
+ * priority value lower than ARCH_CRIT_BASEPRI (e.g. motor control at 0) are
+ * never delayed, and must not touch data protected by the critical sections.
+ * The TM4C123 implements 3 priority bits (7:5). Nestable.
+ */
+#if !defined(ARCH_CRIT_BASEPRI)
+#define ARCH_CRIT_BASEPRI   ( 1 << 5 )
+#endif
+
+#define ARCH_HAS_CRIT
+
+/** Lock. A single core: the interruption mask is enough, nothing to store */
+typedef struct
+{
+    uint8_t rsvd;
+}arch_lock_t;
+
+#define ARCH_LOCK_INIT      { 0 }
+
+/** State saved when entering a critical section */
+typedef uint32_t arch_crit_t;
+
+static INLINE arch_crit_t Arch_CritEnter(arch_lock_t *pLock)
+{
+    uint32_t old;
+#if defined(__TI_COMPILER_VERSION__)
+    uint32_t pm;
+#endif
+
+    (void)pLock;
+#if defined(__TI_COMPILER_VERSION__)
+    //sem BASEPRI_MAX: o PRIMASK cobre a leitura e a restauração de um nível mais restrito
+    pm = _disable_interrupts();
+    old = _set_interrupt_priority( ARCH_CRIT_BASEPRI );
+    if( (old != 0) && (old < ARCH_CRIT_BASEPRI) )
+    {
+        _set_interrupt_priority( old );
+    }
+    _restore_interrupts( pm );
+#else
+    __asm volatile ( "mrs %0, basepri" : "=r" (old) );
+    //BASEPRI_MAX só aumenta a restrição: aninha sem comparar
+    __asm volatile ( "msr basepri_max, %0" : : "r" (ARCH_CRIT_BASEPRI) : "memory" );
+#endif
+    return old;
+}
+
+static INLINE void Arch_CritExit(arch_lock_t *pLock, arch_crit_t pSt)
+{
+    (void)pLock;
+#if defined(__TI_COMPILER_VERSION__)
+    _set_interrupt_priority( pSt );
+#else
+    __asm volatile ( "msr basepri, %0" : : "r" (pSt) : "memory" );
+#endif
+}
+
 
 
 #endif /* INC_ARCH_TI_TM4C123GH6PM_H_ */
@@ -0,0 +1,143 @@
+/**************************************************************************//**
+ * @file     bitstream.h
+ * @brief    Functions prototypes for a bitstream writer and reader.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * Packs and unpacks fields of 1 to 32 bits into a byte ring buffer or a
+ * linear buffer. Like #EntropyPool_Store32, bits are stored LSB first: the
+ * first field starts at bit 0 of the first byte.
+ *
+ * Fields go through a 64-bit accumulator, which moves 32-bit words to and
+ * from the buffer, instead of one bit per iteration.
+ *
+ * A stream is either a writer or a reader. The ring buffer, when used, must
+ * have 1-byte elements and the stream must be its only producer (writer) or
+ * consumer (reader).
+ *
+ ******************************************************************************/
+
+#ifndef INCLUDES_COMMON_BITSTREAM_H_
+#define INCLUDES_COMMON_BITSTREAM_H_
+
+#include "api_config.h"
+#include "common/ring_buffer.h"
+
+/**
+ * @addtogroup COMMON_GROUP
+ * @{
+ */
+
+/**
+ * Bitstream structure
+ */
+typedef struct
+{
+    uint64_t acc;       ///< Bits not moved to (writer) or taken from (reader) the buffer yet
+    uint8_t nBits;      ///< Number of bits in the accumulator
+    bool_t init;        ///< flag indicating initialized
+    uint8_t *buf;       ///< Linear buffer, or #NULL
+    ringbuff_t *rb;     ///< Ring buffer, or #NULL
+    uint32_t pos;       ///< Linear buffer: next byte
+    uint32_t room;      ///< Bytes known to be free (writer) or available (reader)
+    uint32_t total;     ///< Bits written or read so far
+}bitstream_t;
+
+/**
+ * Initializes a writer over a linear buffer
+ *
+ * @param[in,out]   pBs         : Pointer to the structure #bitstream_t
+ * @param[out]      pBuff       : Pointer to a RAM location
+ * @param[in]       pSz         : Size of RAM location
+ */
+void BitStream_WrInit(bitstream_t *pBs, void *pBuff, uint32_t pSz);
+
+/**
+ * Initializes a writer over a byte ring buffer
+ *
+ * @note A ring of elements wider than a byte leaves the stream uninitialized:
+ * every call on it returns 0.
+ *
+ * @param[in,out]   pBs         : Pointer to the structure #bitstream_t
+ * @param[in,out]   pRb         : Pointer to an initialized #ringbuff_t
+ */
+void BitStream_WrInitRing(bitstream_t *pBs, ringbuff_t *pRb);
+
+/**
+ * Initializes a reader over a linear buffer
+ *
+ * @param[in,out]   pBs         : Pointer to the structure #bitstream_t
+ * @param[in]       pBuff       : Pointer to the stream bytes
+ * @param[in]       pSz         : Number of bytes
+ */
+void BitStream_RdInit(bitstream_t *pBs, const void *pBuff, uint32_t pSz);
+
+/**
+ * Initializes a reader over a byte ring buffer
+ *
+ * @note A ring of elements wider than a byte leaves the stream uninitialized:
+ * every call on it returns 0.
+ *
+ * @param[in,out]   pBs         : Pointer to the structure #bitstream_t
+ * @param[in,out]   pRb         : Pointer to an initialized #ringbuff_t
+ */
+void BitStream_RdInitRing(bitstream_t *pBs, ringbuff_t *pRb);
+
+/**
+ * Writes a field
+ *
+ * @note The field is all-or-nothing: it is only written if all of its bits fit.
+ *
+ * @param[in,out]   pBs         : Pointer to the structure #bitstream_t
+ * @param[in]       pVal        : Field value, in the low bits. Higher bits are ignored.
+ * @param[in]       pBits       : Field size (bits). 1 to 32
+ *
+ * @return number of bits written
+ */
+uint32_t BitStream_Wr(bitstream_t *pBs, uint32_t pVal, uint8_t pBits);
+
+/**
+ * Writes the bits still in the accumulator, completing the last byte with zeros
+ *
+ * @param[in,out]   pBs         : Pointer to the structure #bitstream_t
+ *
+ * @return number of bytes written
+ */
+uint32_t BitStream_Flush(bitstream_t *pBs);
+
+/**
+ * Reads a field
+ *
+ * @note The field is all-or-nothing: nothing is consumed if there are not enough bits.
+ *
+ * @param[in,out]   pBs         : Pointer to the structure #bitstream_t
+ * @param[out]      pVal        : Field value
+ * @param[in]       pBits       : Field size (bits). 1 to 32
+ *
+ * @return number of bits read
+ */
+uint32_t BitStream_Rd(bitstream_t *pBs, uint32_t *pVal, uint8_t pBits);
+
+/**
+ * Skips the reader to the next byte boundary
+ *
+ * @param[in,out]   pBs         : Pointer to the structure #bitstream_t
+ *
+ * @return number of bits skipped
+ */
+uint32_t BitStream_RdAlign(bitstream_t *pBs);
+
+/**
+ * Gets the number of bits written or read so far
+ *
+ * @param[in,out]   pBs         : Pointer to the structure #bitstream_t
+ *
+ * @return number of bits
+ */
+uint32_t BitStream_Bits(bitstream_t *pBs);
+
+/**
+ * @}
+ */
+
+#endif /* INCLUDES_COMMON_BITSTREAM_H_ */
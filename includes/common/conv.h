@@ -10,6 +10,23 @@
 #define INCLUDES_COMMON_CONV_H_
 
 #include "api_config.h"
+#include "common/ring_buffer.h"
+
+/**
+ * Output formats of the array conversions
+ */
+#define CONV_ARR_CSV    ( 0 )   ///< v0,v1,v2 or, with keys, k0=v0,k1=v1,k2=v2
+#define CONV_ARR_JSON   ( 1 )   ///< [v0,v1,v2] or, with keys, {"k0":v0,"k1":v1,"k2":v2}
+
+/**
+ * Array conversion format
+ */
+typedef struct
+{
+    const char_t * const *keys; ///< One key per value, or #NULL for no keys
+    char_t sep;                 ///< Separator between fields (CSV only; JSON uses ',')
+    uint8_t fmt;                ///< #CONV_ARR_CSV or #CONV_ARR_JSON
+}conv_arrfmt_t;
 
 /**
  * Converts an integer (with signal) to a string.
@@ -22,4 +39,48 @@
  */
 res_t Conv_IntToStr( int32_t pVal, char_t *pStrTo, uint8_t pStrMaxLen );
 
+/**
+ * Converts an integer (with signal) array to a single line, e.g. a telemetry
+ * record. The length is computed first, from the digit count of each value,
+ * so nothing is written on overflow. Digits are then written right to left,
+ * straight to the output.
+ *
+ * @param[in]   pVals               Int values
+ * @param[in]   pN                  Number of values
+ * @param[in]   pFmt                Format, or #NULL for CSV with ',' and no keys
+ * @param[out]  pStrTo              Converted string
+ * @param[in]   pStrMaxLen          Max number of chars in the string (without the trailing 0)
+ * @param[out]  pLen                Number of chars in the string. May be #NULL.
+ *
+ * @return #RES_SUCCESS when conversion is properly done, #RES_ERR_OVERFLOW when
+ * the string does not fit.
+ */
+res_t Conv_IntArrToStr( const int32_t *pVals, uint32_t pN, const conv_arrfmt_t *pFmt, char_t *pStrTo, uint32_t pStrMaxLen, uint32_t *pLen );
+
+/**
+ * Same as #Conv_IntArrToStr, for integers without signal.
+ */
+res_t Conv_UIntArrToStr( const uint32_t *pVals, uint32_t pN, const conv_arrfmt_t *pFmt, char_t *pStrTo, uint32_t pStrMaxLen, uint32_t *pLen );
+
+/**
+ * Converts an integer (with signal) array to a single line, written in place
+ * to a reservation of a ring buffer of chars and committed. There's no
+ * trailing 0.
+ *
+ * @param[in,out]   pRb             Ring buffer, with 1-byte elements
+ * @param[in]   pVals               Int values
+ * @param[in]   pN                  Number of values
+ * @param[in]   pFmt                Format, or #NULL for CSV with ',' and no keys
+ * @param[out]  pLen                Number of chars written. May be #NULL.
+ *
+ * @return #RES_SUCCESS when conversion is properly done, #RES_ERR_OVERFLOW when
+ * the line does not fit in the free space, #RES_ERR_SZ when the elements are not chars.
+ */
+res_t Conv_IntArrToRing( ringbuff_t *pRb, const int32_t *pVals, uint32_t pN, const conv_arrfmt_t *pFmt, uint32_t *pLen );
+
+/**
+ * Same as #Conv_IntArrToRing, for integers without signal.
+ */
+res_t Conv_UIntArrToRing( ringbuff_t *pRb, const uint32_t *pVals, uint32_t pN, const conv_arrfmt_t *pFmt, uint32_t *pLen );
+
 #endif /* INCLUDES_COMMON_CONV_H_ */
@@ -0,0 +1,148 @@
+/**************************************************************************//**
+ * @file     crc.h
+ * @brief    Functions prototypes for CRC16 and CRC32 checksums.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * - CRC16: CCITT polynomial 0x1021, initial value 0xFFFF, not reflected
+ *   (CRC-16/CCITT-FALSE, check value 0x29B1)
+ * - CRC32: IEEE 802.3 polynomial, reflected (0xEDB88320), initial value and
+ *   final XOR 0xFFFFFFFF (check value 0xCBF43926)
+ *
+ * The implementation is chosen at compile time with #CRC_IMPL, trading flash
+ * for speed:
+ * - #CRC_IMPL_BITWISE: no table
+ * - #CRC_IMPL_TABLE: one 256-entry table per CRC (512 bytes + 1 KiB)
+ * - #CRC_IMPL_SLICE8: eight 256-entry tables per CRC (4 KiB + 8 KiB), 8 bytes per step
+ *
+ * Incremental use: `crc = Crc32_Start(); crc = Crc32_Update(crc, ...); ...;
+ * crc = Crc32_End(crc);`
+ *
+ ******************************************************************************/
+
+#ifndef INCLUDES_COMMON_CRC_H_
+#define INCLUDES_COMMON_CRC_H_
+
+#include "api_config.h"
+#include "common/ring_buffer.h"
+
+/**
+ * @addtogroup COMMON_GROUP
+ * @{
+ */
+
+#define CRC_IMPL_BITWISE    0   ///< Bit by bit, no table
+#define CRC_IMPL_TABLE      1   ///< Byte by byte, 256-entry table
+#define CRC_IMPL_SLICE8     2   ///< 8 bytes at a time, eight 256-entry tables
+
+#ifndef CRC_IMPL
+#define CRC_IMPL            CRC_IMPL_TABLE
+#endif
+
+/**
+ * Gets the initial CRC16 value
+ *
+ * @return CRC16 to be given to #Crc16_Update
+ */
+uint16_t Crc16_Start(void);
+
+/**
+ * Updates a CRC16 with a block of data
+ *
+ * @param[in]       pCrc        : Current CRC16
+ * @param[in]       pData       : Pointer to the data
+ * @param[in]       pLen        : Number of bytes
+ *
+ * @return updated CRC16
+ */
+uint16_t Crc16_Update(uint16_t pCrc, const void *pData, uint32_t pLen);
+
+/**
+ * Updates a CRC16 with elements of a ring buffer, in place
+ *
+ * @note THERE WILL BE NO MEMORY COPY. The elements stay in the buffer.
+ *
+ * @param[in]       pCrc        : Current CRC16
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_t
+ * @param[in]       pIdx        : Index of the first element, 0 being the oldest element
+ * @param[in]       pN          : Number of elements. Limited to the elements in the buffer.
+ *
+ * @return updated CRC16
+ */
+uint16_t Crc16_RingBuff(uint16_t pCrc, ringbuff_t *pRb, uint32_t pIdx, uint32_t pN);
+
+/**
+ * Finishes a CRC16
+ *
+ * @param[in]       pCrc        : Current CRC16
+ *
+ * @return final CRC16
+ */
+uint16_t Crc16_End(uint16_t pCrc);
+
+/**
+ * Computes the CRC16 of a block of data
+ *
+ * @param[in]       pData       : Pointer to the data
+ * @param[in]       pLen        : Number of bytes
+ *
+ * @return CRC16
+ */
+uint16_t Crc16(const void *pData, uint32_t pLen);
+
+/**
+ * Gets the initial CRC32 value
+ *
+ * @return CRC32 to be given to #Crc32_Update
+ */
+uint32_t Crc32_Start(void);
+
+/**
+ * Updates a CRC32 with a block of data
+ *
+ * @param[in]       pCrc        : Current CRC32
+ * @param[in]       pData       : Pointer to the data
+ * @param[in]       pLen        : Number of bytes
+ *
+ * @return updated CRC32
+ */
+uint32_t Crc32_Update(uint32_t pCrc, const void *pData, uint32_t pLen);
+
+/**
+ * Updates a CRC32 with elements of a ring buffer, in place
+ *
+ * @note THERE WILL BE NO MEMORY COPY. The elements stay in the buffer.
+ *
+ * @param[in]       pCrc        : Current CRC32
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_t
+ * @param[in]       pIdx        : Index of the first element, 0 being the oldest element
+ * @param[in]       pN          : Number of elements. Limited to the elements in the buffer.
+ *
+ * @return updated CRC32
+ */
+uint32_t Crc32_RingBuff(uint32_t pCrc, ringbuff_t *pRb, uint32_t pIdx, uint32_t pN);
+
+/**
+ * Finishes a CRC32
+ *
+ * @param[in]       pCrc        : Current CRC32
+ *
+ * @return final CRC32
+ */
+uint32_t Crc32_End(uint32_t pCrc);
+
+/**
+ * Computes the CRC32 of a block of data
+ *
+ * @param[in]       pData       : Pointer to the data
+ * @param[in]       pLen        : Number of bytes
+ *
+ * @return CRC32
+ */
+uint32_t Crc32(const void *pData, uint32_t pLen);
+
+/**
+ * @}
+ */
+
+#endif /* INCLUDES_COMMON_CRC_H_ */
@@ -11,6 +11,13 @@
 
 #include "api_config.h"
 
+/**
+ * Entropy pool structure
+ *
+ * @note Define ENTROPYPOOL_FREE_RUNNING to make head and tail free-running
+ * counters: occupancy is tail - head and there's no full flag to keep. In
+ * that mode the pool size is rounded down to a power of 2.
+ */
 typedef struct
 {
     struct
@@ -19,8 +26,16 @@ typedef struct
         uint32_t head;
         uint32_t tail;
         uint32_t sz;
+#if defined(ENTROPYPOOL_FREE_RUNNING)
+        uint32_t mask;
+#endif
     }buff;
     uint32_t entropy_cur;
+    struct
+    {
+        uint8_t acc;    //bits left from bytes read by #EntropyPool_RdBits
+        uint8_t n;      //number of bits in acc
+    }rd;
 
     uint32_t full;
     enum
@@ -137,6 +152,34 @@ uint32_t EntropyPool_RdOne(entropy_pool_t *pPool, void *pEl);
  */
 uint32_t EntropyPool_RdOnePtr(entropy_pool_t *pPool, void **pEl);
 
+/**
+ * Reads bits of entropy. Bits left from a byte are kept for the next call, so
+ * no entropy is wasted on small draws.
+ *
+ * @param[in,out]   pPool       : Pointer to the structure #entropy_pool_t
+ * @param[out]      pVal        : Bits read, on the LSBs
+ * @param[in]       pBits       : Number of bits. Max is 32
+ *
+ * @return  Number of bits read: pBits, or 0 if there's not enough entropy
+ */
+uint32_t EntropyPool_RdBits(entropy_pool_t *pPool, uint32_t *pVal, uint8_t pBits);
+
+/**
+ * Reads an unbiased random integer in [0, pN), with Lemire's multiply-shift
+ * method: a k-bit draw x gives (x * pN) >> k, rejected when the low k bits of
+ * the product fall below 2^k mod pN. The number of bits k per draw is chosen
+ * to minimize the expected bits consumed, rejections included.
+ *
+ * @note If the pool runs out during the rejections, the bits drawn are lost.
+ *
+ * @param[in,out]   pPool       : Pointer to the structure #entropy_pool_t
+ * @param[in]       pN          : Range size. Must be at least 1
+ * @param[out]      pVal        : Random integer
+ *
+ * @return  Number of integers read: 1, or 0 if there's not enough entropy
+ */
+uint32_t EntropyPool_RdRange(entropy_pool_t *pPool, uint32_t pN, uint32_t *pVal);
+
 /**
  * Checks maximum bits allowed on this pool
  *
@@ -151,7 +194,7 @@ uint32_t EntropyPool_BitsMax(entropy_pool_t *pPool);
  *
  * @param[in,out]   pPool       : Pointer to the structure #entropy_pool_t
  *
- * @return  Number of bits stored on the pool
+ * @return  Number of bits stored on the pool, including those left by #EntropyPool_RdBits
  */
 uint32_t EntropyPool_Bits(entropy_pool_t *pPool);
 
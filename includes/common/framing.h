@@ -0,0 +1,129 @@
+/**************************************************************************//**
+ * @file     framing.h
+ * @brief    Functions prototypes for COBS and SLIP framing over ring buffers.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * Encoders and decoders work on ring buffer segments: delimiters and escape
+ * bytes are found with memchr and the bytes in between are moved with memcpy,
+ * straight into a region reserved in the output ring buffer
+ * (#RingBuff_WrReserve).
+ *
+ * Decoding is resumable: the input is consumed as it arrives, and a partially
+ * received frame is kept, uncommitted, in the output ring buffer. Only whole
+ * frames are committed, so a bad or oversized frame is dropped without ever
+ * reaching the consumer.
+ *
+ * All ring buffers must have 1-byte elements, and each output ring buffer
+ * must have a single producer.
+ *
+ ******************************************************************************/
+
+#ifndef INCLUDES_COMMON_FRAMING_H_
+#define INCLUDES_COMMON_FRAMING_H_
+
+#include "api_config.h"
+#include "common/ring_buffer.h"
+
+/**
+ * @addtogroup COMMON_GROUP
+ * @{
+ */
+
+#define SLIP_END            0xC0    ///< SLIP frame delimiter
+#define SLIP_ESC            0xDB    ///< SLIP escape
+#define SLIP_ESC_END        0xDC    ///< Escaped #SLIP_END
+#define SLIP_ESC_ESC        0xDD    ///< Escaped #SLIP_ESC
+
+/**
+ * Frame decoder state, shared by COBS and SLIP
+ */
+typedef struct
+{
+    uint32_t len;       ///< Frame bytes decoded so far, reserved and not committed
+    uint8_t rem;        ///< COBS: bytes left in the current block
+    uint8_t code;       ///< COBS: code of the current block. SLIP: escape pending
+    bool_t skip;        ///< Dropping bytes until the next delimiter
+}framing_dec_t;
+
+/**
+ * Initializes the decoder
+ *
+ * @param[in,out]   pDec        : Pointer to the structure #framing_dec_t
+ */
+void Framing_DecInit(framing_dec_t *pDec);
+
+/**
+ * Encodes a frame with COBS, followed by a 0x00 delimiter
+ *
+ * @note The frame is all-or-nothing: it is written only if it fits in @p pOut.
+ * Use #RingBuff_PeekSegs to encode a frame held in a ring buffer.
+ *
+ * @param[in]       pVec        : Pointer to a #ringbuff_vec_t list with the frame bytes
+ * @param[in]       pVecN       : Number of vectors in the list
+ * @param[in,out]   pOut        : Ring buffer receiving the encoded frame
+ *
+ * @return
+ * - #RES_SUCCESS when the frame is written
+ * - #RES_ERR_BUSY when it does not fit in @p pOut
+ * - #RES_ERR_SZ when the elements of @p pOut are not bytes
+ * - #RES_ERROR on invalid parameters
+ */
+res_t Cobs_Encode(const ringbuff_vec_t *pVec, uint32_t pVecN, ringbuff_t *pOut);
+
+/**
+ * Decodes COBS frames, until the end of a frame or of the input
+ *
+ * @param[in,out]   pDec        : Pointer to the structure #framing_dec_t
+ * @param[in,out]   pIn         : Ring buffer with the encoded bytes. Bytes decoded are consumed.
+ * @param[in,out]   pOut        : Ring buffer receiving the decoded frames
+ * @param[out]      pLen        : Length of the frame committed to @p pOut. Can be #NULL
+ *
+ * @return
+ * - #RES_SUCCESS when a frame is committed to @p pOut
+ * - #RES_ERR_NO_MORE_RECORDS when the input is exhausted
+ * - #RES_ERR_BUSY when @p pOut is full. Call again when there is room.
+ * - #RES_ERR_OVERFLOW when the frame can never fit in @p pOut. It is dropped.
+ * - #RES_ERR_FORMAT when the frame is malformed. It is dropped.
+ * - #RES_ERR_SZ when the elements of a ring buffer are not bytes
+ * - #RES_ERROR on invalid parameters
+ */
+res_t Cobs_Decode(framing_dec_t *pDec, ringbuff_t *pIn, ringbuff_t *pOut, uint32_t *pLen);
+
+/**
+ * Encodes a frame with SLIP, between two #SLIP_END delimiters
+ *
+ * @note The frame is all-or-nothing: it is written only if it fits in @p pOut.
+ * Use #RingBuff_PeekSegs to encode a frame held in a ring buffer.
+ *
+ * @param[in]       pVec        : Pointer to a #ringbuff_vec_t list with the frame bytes
+ * @param[in]       pVecN       : Number of vectors in the list
+ * @param[in,out]   pOut        : Ring buffer receiving the encoded frame
+ *
+ * @return
+ * - #RES_SUCCESS when the frame is written
+ * - #RES_ERR_BUSY when it does not fit in @p pOut
+ * - #RES_ERR_SZ when the elements of @p pOut are not bytes
+ * - #RES_ERROR on invalid parameters
+ */
+res_t Slip_Encode(const ringbuff_vec_t *pVec, uint32_t pVecN, ringbuff_t *pOut);
+
+/**
+ * Decodes SLIP frames, until the end of a frame or of the input
+ *
+ * @note Empty frames are skipped.
+ *
+ * @param[in,out]   pDec        : Pointer to the structure #framing_dec_t
+ * @param[in,out]   pIn         : Ring buffer with the encoded bytes. Bytes decoded are consumed.
+ * @param[in,out]   pOut        : Ring buffer receiving the decoded frames
+ * @param[out]      pLen        : Length of the frame committed to @p pOut. Can be #NULL
+ *
+ * @return same as #Cobs_Decode
+ */
+res_t Slip_Decode(framing_dec_t *pDec, ringbuff_t *pIn, ringbuff_t *pOut, uint32_t *pLen);
+
+/**
+ * @}
+ */
+
+#endif /* INCLUDES_COMMON_FRAMING_H_ */
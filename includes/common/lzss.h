@@ -0,0 +1,133 @@
+/**************************************************************************//**
+ * @file     lzss.h
+ * @brief    Functions prototypes for a streaming LZSS compressor and decompressor.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * The codec reads its input from a byte #ringbuff_t and writes its output to
+ * another one, a bit at a time with no heap and a bounded amount of work per
+ * call, so it can be polled from a low-priority task.
+ *
+ * Stream format (bits are packed MSB first):
+ * - `1` + 8 bits: literal byte
+ * - `0` + #LZSS_WINDOW_BITS bits (offset - 1) + #LZSS_LOOKAHEAD_BITS bits
+ *   (length - 1): copy of previous output
+ *
+ * The encoder flushes with zero bits at the end of a stream; they are shorter
+ * than any token, so the decoder just waits for more input. Both sides must be
+ * built with the same window and lookahead sizes, and a stream must be decoded
+ * by a freshly initialized decoder.
+ *
+ * RAM: 2 * window bytes for the encoder, 1 * window bytes for the decoder.
+ *
+ ******************************************************************************/
+
+#ifndef INCLUDES_COMMON_LZSS_H_
+#define INCLUDES_COMMON_LZSS_H_
+
+#include "api_config.h"
+#include "common/ring_buffer.h"
+
+/**
+ * @addtogroup COMMON_GROUP
+ * @{
+ */
+
+#ifndef LZSS_WINDOW_BITS
+#define LZSS_WINDOW_BITS        8   ///< Window of 2^bits bytes
+#endif
+
+#ifndef LZSS_LOOKAHEAD_BITS
+#define LZSS_LOOKAHEAD_BITS     4   ///< Matches up to 2^bits bytes
+#endif
+
+#define LZSS_WINDOW_SZ          ( 1U << LZSS_WINDOW_BITS )
+#define LZSS_LOOKAHEAD_SZ       ( 1U << LZSS_LOOKAHEAD_BITS )
+
+STATIC_ASSERT( (LZSS_WINDOW_BITS >= 4) && (LZSS_WINDOW_BITS <= 14), lzss_window_bits_out_of_range );
+STATIC_ASSERT( (LZSS_LOOKAHEAD_BITS >= 3) && (LZSS_LOOKAHEAD_BITS < LZSS_WINDOW_BITS), lzss_lookahead_bits_out_of_range );
+
+/**
+ * Encoder structure
+ */
+typedef struct
+{
+    uint8_t buf[2 * LZSS_WINDOW_SZ];    ///< History followed by the input not encoded yet
+    uint16_t fill;                      ///< Bytes in the buffer
+    uint16_t pos;                       ///< Next byte to be encoded
+    uint32_t acc;                       ///< Bits not written yet
+    uint8_t nBits;                      ///< Number of bits in the accumulator
+}lzss_enc_t;
+
+/**
+ * Decoder structure
+ */
+typedef struct
+{
+    uint8_t win[LZSS_WINDOW_SZ];        ///< Last bytes decoded
+    uint16_t wPos;                      ///< Next position in the window
+    uint16_t off;                       ///< Offset of the pending copy
+    uint16_t cnt;                       ///< Bytes left in the pending copy
+    uint32_t acc;                       ///< Bits read and not decoded yet
+    uint8_t nBits;                      ///< Number of bits in the accumulator
+    uint8_t state;                      ///< Next field to be decoded
+}lzss_dec_t;
+
+/**
+ * Initializes the encoder for a new stream
+ *
+ * @param[in,out]   pEnc        : Pointer to the structure #lzss_enc_t
+ */
+void Lzss_EncInit(lzss_enc_t *pEnc);
+
+/**
+ * Compresses bytes from a ring buffer into another one
+ *
+ * @note Both ring buffers must have 1-byte elements.
+ *
+ * @param[in,out]   pEnc        : Pointer to the structure #lzss_enc_t
+ * @param[in,out]   pIn         : Ring buffer with the bytes to be compressed
+ * @param[in,out]   pOut        : Ring buffer receiving the compressed stream
+ * @param[in]       pBudget     : Max number of input bytes compressed in this call
+ * @param[in]       pFinish     : If true, no more input will come: the stream is closed
+ * once @p pIn is drained
+ *
+ * @return
+ * - #RES_SUCCESS when the stream is closed. The encoder is ready for a new stream.
+ * - #RES_ERR_NO_MORE_RECORDS when it needs more input
+ * - #RES_ERR_BUSY when the budget is spent or @p pOut is full
+ * - #RES_ERR_SZ when the elements of a ring buffer are not bytes
+ * - #RES_ERROR on invalid parameters
+ */
+res_t Lzss_EncPoll(lzss_enc_t *pEnc, ringbuff_t *pIn, ringbuff_t *pOut, uint32_t pBudget, bool_t pFinish);
+
+/**
+ * Initializes the decoder for a new stream
+ *
+ * @param[in,out]   pDec        : Pointer to the structure #lzss_dec_t
+ */
+void Lzss_DecInit(lzss_dec_t *pDec);
+
+/**
+ * Decompresses a stream from a ring buffer into another one
+ *
+ * @note Both ring buffers must have 1-byte elements.
+ *
+ * @param[in,out]   pDec        : Pointer to the structure #lzss_dec_t
+ * @param[in,out]   pIn         : Ring buffer with the compressed stream
+ * @param[in,out]   pOut        : Ring buffer receiving the decompressed bytes
+ * @param[in]       pBudget     : Max number of bytes decompressed in this call
+ *
+ * @return
+ * - #RES_ERR_NO_MORE_RECORDS when it needs more input
+ * - #RES_ERR_BUSY when the budget is spent or @p pOut is full
+ * - #RES_ERR_SZ when the elements of a ring buffer are not bytes
+ * - #RES_ERROR on invalid parameters
+ */
+res_t Lzss_DecPoll(lzss_dec_t *pDec, ringbuff_t *pIn, ringbuff_t *pOut, uint32_t pBudget);
+
+/**
+ * @}
+ */
+
+#endif /* INCLUDES_COMMON_LZSS_H_ */
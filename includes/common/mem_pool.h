@@ -0,0 +1,161 @@
+/**************************************************************************//**
+ * @file     mem_pool.h
+ * @brief    Functions prototypes for a fixed-block memory pool.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * Blocks have a fixed size and are carved from a caller-supplied buffer. Free
+ * blocks are kept in a list embedded in the blocks themselves, so allocating
+ * and releasing are O(1) and there's no fragmentation.
+ *
+ * Define MEMPOOL_LOCKFREE to make the free list lock-free (compare-and-swap
+ * with an ABA tag). Then #MemPool_Alloc and #MemPool_Release can be called
+ * from ISRs and threads without turning off interruptions. It needs a target
+ * with atomic compare-and-swap (Cortex-M3/M4, x86-64).
+ *
+ ******************************************************************************/
+
+#ifndef INCLUDES_COMMON_MEM_POOL_H_
+#define INCLUDES_COMMON_MEM_POOL_H_
+
+#include "api_config.h"
+
+/**
+ * @addtogroup COMMON_GROUP
+ * @{
+ */
+
+#if !defined(MEMPOOL_ALIGN)
+/** Blocks alignment (bytes). Must be a power of 2. */
+#define MEMPOOL_ALIGN       ( sizeof(void*) )
+#endif
+
+/** Invalid block index */
+#define MEMPOOL_NONE        ( 0xFFFFU )
+
+/** Maximum number of blocks in a pool */
+#define MEMPOOL_BLOCKS_MAX  ( MEMPOOL_NONE )
+
+/** Block index, a small handle to a block */
+typedef uint16_t mempool_idx_t;
+
+/**
+ * Memory pool structure
+ */
+typedef struct
+{
+    void *data;                 ///< Blocks storage, aligned
+    uint32_t bSz;               ///< Size of a single block (bytes)
+    uint32_t n;                 ///< Number of blocks
+    volatile uint32_t free;     ///< First free block. Upper half is an ABA tag
+    volatile uint32_t used;     ///< Number of blocks in use
+    volatile uint32_t hwm;      ///< High-water mark of blocks in use
+    bool_t init;                ///< flag indicating initialized
+}mem_pool_t;
+
+/**
+ * Initializes the structure
+ *
+ * @param[in,out]   pPool       : Pointer to the structure #mem_pool_t
+ * @param[in]       pBuff       : Pointer to a RAM location
+ * @param[in]       pSz         : Size of RAM location
+ * @param[in]       pBlkSz      : Size of a single block. It is rounded up to #MEMPOOL_ALIGN
+ *
+ * @return The number of blocks this pool holds
+ */
+uint32_t MemPool_Init(mem_pool_t *pPool, void * const pBuff, uint32_t pSz, uint32_t pBlkSz);
+
+/**
+ * Allocates a block
+ *
+ * @param[in,out]   pPool       : Pointer to the structure #mem_pool_t
+ *
+ * @return pointer to the block, or #NULL if there's no free block
+ */
+void *MemPool_Alloc(mem_pool_t *pPool);
+
+/**
+ * Releases a block, returning it to the pool
+ *
+ * @note A block released twice is NOT detected while other blocks are in
+ * use: it goes into the free list twice and two later allocations return it.
+ * Only a release with no block in use is refused.
+ *
+ * @param[in,out]   pPool       : Pointer to the structure #mem_pool_t
+ * @param[in]       pBlk        : Pointer to the block
+ *
+ * @return #RES_SUCCESS when released, #RES_ERR_FORMAT if the pointer is not a block of this pool,
+ * #RES_ERROR if no block is in use (a repeated release).
+ */
+res_t MemPool_Release(mem_pool_t *pPool, void *pBlk);
+
+/**
+ * Gets the index of a block
+ *
+ * @param[in,out]   pPool       : Pointer to the structure #mem_pool_t
+ * @param[in]       pBlk        : Pointer to the block
+ *
+ * @return block index, or #MEMPOOL_NONE if the pointer is not a block of this pool.
+ */
+mempool_idx_t MemPool_Idx(mem_pool_t *pPool, const void *pBlk);
+
+/**
+ * Gets a block by its index
+ *
+ * @param[in,out]   pPool       : Pointer to the structure #mem_pool_t
+ * @param[in]       pIdx        : Block index
+ *
+ * @return pointer to the block, or #NULL if the index is invalid
+ */
+void *MemPool_Ptr(mem_pool_t *pPool, mempool_idx_t pIdx);
+
+/**
+ * Gets size of a single block
+ *
+ * @param[in,out]   pPool       : Pointer to the structure #mem_pool_t
+ *
+ * @return block size (bytes)
+ */
+uint32_t MemPool_BlkSz(mem_pool_t *pPool);
+
+/**
+ * Gets number of blocks
+ *
+ * @param[in,out]   pPool       : Pointer to the structure #mem_pool_t
+ *
+ * @return maximum number of blocks
+ */
+uint32_t MemPool_Sz(mem_pool_t *pPool);
+
+/**
+ * Gets number of blocks in use
+ *
+ * @param[in,out]   pPool       : Pointer to the structure #mem_pool_t
+ *
+ * @return number of blocks allocated
+ */
+uint32_t MemPool_Used(mem_pool_t *pPool);
+
+/**
+ * Gets number of free blocks
+ *
+ * @param[in,out]   pPool       : Pointer to the structure #mem_pool_t
+ *
+ * @return number of free blocks
+ */
+uint32_t MemPool_Free(mem_pool_t *pPool);
+
+/**
+ * Gets the maximum number of blocks ever in use at the same time
+ *
+ * @param[in,out]   pPool       : Pointer to the structure #mem_pool_t
+ *
+ * @return high-water mark of blocks in use
+ */
+uint32_t MemPool_HighWater(mem_pool_t *pPool);
+
+/**
+ * @}
+ */
+
+#endif /* INCLUDES_COMMON_MEM_POOL_H_ */
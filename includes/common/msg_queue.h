@@ -0,0 +1,138 @@
+/**************************************************************************//**
+ * @file     msg_queue.h
+ * @brief    Functions prototypes for a zero-copy message queue.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * Payloads live in the blocks of a #mem_pool_t. Only small handles (block
+ * index and payload length) go through the #ringbuff_t, so a payload is
+ * written once, in place, by the producer and is never copied between tasks.
+ *
+ * Typical flow:
+ * - producer: #MsgQueue_Alloc, fill the block, #MsgQueue_Send
+ * - consumer: #MsgQueue_Recv, process the block, #MsgQueue_Release
+ *
+ * Many queues can share the same pool. As with #ringbuff_t, it does NOT turn
+ * off interruptions.
+ *
+ ******************************************************************************/
+
+#ifndef INCLUDES_COMMON_MSG_QUEUE_H_
+#define INCLUDES_COMMON_MSG_QUEUE_H_
+
+#include "api_config.h"
+#include "common/ring_buffer.h"
+#include "common/mem_pool.h"
+
+/**
+ * @addtogroup COMMON_GROUP
+ * @{
+ */
+
+/**
+ * Message handle, the element of the queue ring buffer
+ */
+typedef struct
+{
+    mempool_idx_t idx;  ///< Block index
+    uint16_t len;       ///< Payload length (bytes)
+}msgq_hnd_t;
+
+/**
+ * Message queue structure
+ */
+typedef struct
+{
+    ringbuff_t rb;      ///< Ring buffer of #msgq_hnd_t
+    mem_pool_t *pool;   ///< Pool holding the payloads
+}msg_queue_t;
+
+/**
+ * Initializes the structure
+ *
+ * @param[in,out]   pQ          : Pointer to the structure #msg_queue_t
+ * @param[in]       pPool       : Pointer to an initialized #mem_pool_t
+ * @param[in]       pBuff       : Pointer to a RAM location for the handles
+ * @param[in]       pSz         : Size of RAM location
+ *
+ * @return The number of messages this queue holds
+ */
+uint32_t MsgQueue_Init(msg_queue_t *pQ, mem_pool_t *pPool, void * const pBuff, uint32_t pSz);
+
+/**
+ * Allocates a message block from the queue's pool, to be filled in place
+ *
+ * @param[in,out]   pQ          : Pointer to the structure #msg_queue_t
+ *
+ * @return pointer to the block, or #NULL if the pool is exhausted
+ */
+void *MsgQueue_Alloc(msg_queue_t *pQ);
+
+/**
+ * Enqueues a message block. There will be no memory copy.
+ *
+ * @note When the queue is full, the block is not enqueued and the caller keeps its ownership.
+ *
+ * @param[in,out]   pQ          : Pointer to the structure #msg_queue_t
+ * @param[in]       pMsg        : Pointer to a block from #MsgQueue_Alloc
+ * @param[in]       pLen        : Payload length. Must not exceed the pool block size.
+ *
+ * @return number of messages enqueued
+ */
+uint32_t MsgQueue_Send(msg_queue_t *pQ, void *pMsg, uint16_t pLen);
+
+/**
+ * Dequeues a message block. There will be no memory copy.
+ *
+ * @note The block must be given back by #MsgQueue_Release once processed.
+ *
+ * @param[in,out]   pQ          : Pointer to the structure #msg_queue_t
+ * @param[out]      pLen        : Payload length. Can be #NULL
+ *
+ * @return pointer to the block, or #NULL if the queue is empty
+ */
+void *MsgQueue_Recv(msg_queue_t *pQ, uint16_t *pLen);
+
+/**
+ * Gets the next message block, leaving it in the queue.
+ *
+ * @param[in,out]   pQ          : Pointer to the structure #msg_queue_t
+ * @param[out]      pLen        : Payload length. Can be #NULL
+ *
+ * @return pointer to the block, or #NULL if the queue is empty
+ */
+void *MsgQueue_Peek(msg_queue_t *pQ, uint16_t *pLen);
+
+/**
+ * Gives a message block back to the queue's pool
+ *
+ * @param[in,out]   pQ          : Pointer to the structure #msg_queue_t
+ * @param[in]       pMsg        : Pointer to the block
+ *
+ * @return #RES_SUCCESS when released, #RES_ERR_FORMAT if the pointer is not a block of the pool.
+ */
+res_t MsgQueue_Release(msg_queue_t *pQ, void *pMsg);
+
+/**
+ * Gets number of messages in the queue
+ *
+ * @param[in,out]   pQ          : Pointer to the structure #msg_queue_t
+ *
+ * @return number of messages enqueued
+ */
+uint32_t MsgQueue_Used(msg_queue_t *pQ);
+
+/**
+ * Gets number of free message slots in the queue
+ *
+ * @param[in,out]   pQ          : Pointer to the structure #msg_queue_t
+ *
+ * @return number of free slots
+ */
+uint32_t MsgQueue_Free(msg_queue_t *pQ);
+
+/**
+ * @}
+ */
+
+#endif /* INCLUDES_COMMON_MSG_QUEUE_H_ */
@@ -0,0 +1,161 @@
+/**************************************************************************//**
+ * @file     prio_queue.h
+ * @brief    Functions prototypes for a priority queue.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * Elements have a fixed size and live in a caller-supplied buffer, as with
+ * #ringbuff_t, but come out smallest key first. The key is the first 32-bit
+ * word of the element (e.g. a deadline tick), so elements must be a multiple
+ * of 4 bytes.
+ *
+ * The elements form a 4-ary min-heap: the 4 children of a node sit side by
+ * side, so a level of the descent touches one cache line (or a couple of
+ * them) instead of two scattered ones, and the tree is half as deep as a
+ * binary heap. Push and pop are O(log n). A batch push of at least as many
+ * elements as stored appends them and rebuilds the heap in O(n).
+ *
+ * Equal keys come out in no particular order. Keys are compared as unsigned
+ * numbers: with wrapping tick counters, keep the pending deadlines within
+ * 2^31 ticks and store them relative to a base.
+ *
+ * As with #ringbuff_t, it does NOT turn off interruptions.
+ *
+ ******************************************************************************/
+
+#ifndef INCLUDES_COMMON_PRIO_QUEUE_H_
+#define INCLUDES_COMMON_PRIO_QUEUE_H_
+
+#include "api_config.h"
+
+/**
+ * @addtogroup COMMON_GROUP
+ * @{
+ */
+
+/** Number of children of a node */
+#define PRIOQ_ARITY     ( 4 )
+
+/** Key of an element */
+#define PRIOQ_KEY( __el )   ( *(const uint32_t *)(__el) )
+
+/**
+ * Priority queue structure
+ */
+typedef struct
+{
+    void *data;         ///< Elements, in heap order
+    uint32_t eSz;       ///< Size of a single element (bytes)
+    uint32_t n;         ///< Number of elements the queue holds
+    uint32_t used;      ///< Number of elements stored
+    bool_t init;        ///< flag indicating initialized
+}prioq_t;
+
+/**
+ * Initializes the structure
+ *
+ * @param[in,out]   pQ          : Pointer to the structure #prioq_t
+ * @param[in]       pBuff       : Pointer to a RAM location
+ * @param[in]       pSz         : Size of RAM location
+ * @param[in]       pElSz       : Size of a single element. Multiple of 4, key first
+ *
+ * @return The number of elements this queue holds, or 0 on failure
+ */
+uint32_t PrioQ_Init(prioq_t *pQ, void * const pBuff, uint32_t pSz, uint32_t pElSz);
+
+/**
+ * Inserts an element. O(log n).
+ *
+ * @param[in,out]   pQ          : Pointer to the structure #prioq_t
+ * @param[in]       pEl         : Pointer to the element
+ *
+ * @return #RES_SUCCESS, #RES_ERR_OVERFLOW if full, #RES_ERROR on bad parameters
+ */
+res_t PrioQ_Push(prioq_t *pQ, const void *pEl);
+
+/**
+ * Inserts N elements, all or none. When N is at least the number of elements
+ * stored, the heap is rebuilt at once in O(n); otherwise they are inserted
+ * one by one.
+ *
+ * @param[in,out]   pQ          : Pointer to the structure #prioq_t
+ * @param[in]       pEls        : Pointer to an element vector
+ * @param[in]       pN          : Number of elements
+ *
+ * @return #RES_SUCCESS, #RES_ERR_OVERFLOW if they don't fit, #RES_ERROR on bad parameters
+ */
+res_t PrioQ_PushMany(prioq_t *pQ, const void *pEls, uint32_t pN);
+
+/**
+ * Removes the element with the smallest key. O(log n).
+ *
+ * @param[in,out]   pQ          : Pointer to the structure #prioq_t
+ * @param[out]      pEl         : Pointer to the output element. May be #NULL to discard it.
+ *
+ * @return #RES_SUCCESS, #RES_ERR_NO_MORE_RECORDS if empty, #RES_ERROR on bad parameters
+ */
+res_t PrioQ_Pop(prioq_t *pQ, void *pEl);
+
+/**
+ * Removes, smallest first, the elements with key up to pKey, e.g. the
+ * deadlines already due.
+ *
+ * @param[in,out]   pQ          : Pointer to the structure #prioq_t
+ * @param[in]       pKey        : Highest key to remove
+ * @param[out]      pEls        : Pointer to an element vector. May be #NULL to discard them.
+ * @param[in]       pMax        : Maximum number of elements to remove
+ *
+ * @return number of elements removed
+ */
+uint32_t PrioQ_PopUntil(prioq_t *pQ, uint32_t pKey, void *pEls, uint32_t pMax);
+
+/**
+ * Gets the element with the smallest key, leaving it in the queue
+ *
+ * @param[in,out]   pQ          : Pointer to the structure #prioq_t
+ *
+ * @note THERE WILL BE NO MEMORY COPY. Do not change the key.
+ *
+ * @return pointer to the element, or #NULL if empty
+ */
+void *PrioQ_Peek(prioq_t *pQ);
+
+/**
+ * Removes all the elements
+ *
+ * @param[in,out]   pQ          : Pointer to the structure #prioq_t
+ */
+void PrioQ_Flush(prioq_t *pQ);
+
+/**
+ * Gets number of elements stored
+ *
+ * @param[in,out]   pQ          : Pointer to the structure #prioq_t
+ *
+ * @return number of elements stored
+ */
+uint32_t PrioQ_Used(prioq_t *pQ);
+
+/**
+ * Gets number of free slots
+ *
+ * @param[in,out]   pQ          : Pointer to the structure #prioq_t
+ *
+ * @return number of elements that can be pushed
+ */
+uint32_t PrioQ_Free(prioq_t *pQ);
+
+/**
+ * Gets the queue size
+ *
+ * @param[in,out]   pQ          : Pointer to the structure #prioq_t
+ *
+ * @return number of elements the queue holds
+ */
+uint32_t PrioQ_Sz(prioq_t *pQ);
+
+/**
+ * @}
+ */
+
+#endif /* INCLUDES_COMMON_PRIO_QUEUE_H_ */
@@ -10,6 +10,7 @@
 #ifndef __RINGBUFF_BUFFER_H_
 #define __RINGBUFF_BUFFER_H_
 
+#include <string.h>
 #include "api_config.h"
 
 
@@ -18,8 +19,27 @@
  * @{
  */
 
+/** Maximum size of a single element (bytes) */
+#define RINGBUFF_ELEMENT_MAX    ( 63 )
+
+/** Returned by the search functions when no element matches */
+#define RINGBUFF_NOT_FOUND      ( UINT32_MAX )
+
 /**
  * Ring buffer structure
+ *
+ * @note By default head and tail are byte offsets and a flag tells full from
+ * empty. Define RINGBUFF_FREE_RUNNING to make them free-running element
+ * counters instead: occupancy is simply tail - head, with no flag and no
+ * branches, and the wrap is applied only to compute addresses. In that mode
+ * the number of elements is rounded down to a power of 2.
+ *
+ * @note Define RINGBUFF_TRACE_ENABLE to record writes, reads and lost elements
+ * in the trace buffer (see trace.h). The inline API and the
+ * RINGBUFF_STATIC_DEFINE accessors are not traced.
+ *
+ * @note Define RINGBUFF_NOTIFY to have writes set bits in a flag word (see
+ * #RingBuff_SetNotify), e.g. to mark the consumer task ready.
  */
 typedef struct
 {
@@ -27,11 +47,27 @@ typedef struct
     uint32_t head;  ///< First element ID
     uint32_t tail;  ///< Last element ID
     uint32_t sz;    ///< Buffer size (bytes)
-    uint8_t full    :1; ///< flag indicating full
+#if defined(RINGBUFF_FREE_RUNNING)
+    uint32_t mask;  ///< Number of elements - 1
+#endif
+#if defined(RINGBUFF_NOTIFY)
+    volatile uint32_t *ntf; ///< Flags set on writes, or #NULL
+    uint32_t ntfMask;       ///< Bits set in *ntf
+#endif
+    uint8_t full    :1; ///< flag indicating full. Not used with RINGBUFF_FREE_RUNNING
     uint8_t init    :1; ///< flag indicating initialized
     uint8_t eSz     :6; ///< size of a single element(bytes)
 }ringbuff_t;
 
+/**
+ * Scatter/gather vector, used by #RingBuff_WrV and #RingBuff_RdV
+ */
+typedef struct
+{
+    void *ptr;      ///< Pointer to an element vector
+    uint32_t n;     ///< Number of elements in the vector
+}ringbuff_vec_t;
+
 /**
  * Initializes the structure
  *
@@ -77,9 +113,52 @@ uint32_t RingBuff_WrOne(ringbuff_t *pRb, void * const pEl, bool_t pOw );
  *
  * @return number of elements inserted
  */
-//FIXME esta chamando varias vezes a função de escrever um só! corrigir!
 uint32_t RingBuff_WrMany(ringbuff_t *pRb, const void * const pWrBuff, uint32_t pN, bool_t pOw );
 
+/**
+ * Write the elements of many vectors in the ring buffer, as a single batch
+ *
+ * @note The batch is all-or-nothing: either every vector is written or none is.
+ * With overwrite, the oldest elements are discarded to make room for the batch.
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_t
+ * @param[in]       pVec        : Pointer to a #ringbuff_vec_t list
+ * @param[in]       pVecN       : Number of vectors in the list
+ * @param[in]       pOw         : If the batch does not fit, #true overwrites the oldest elements.
+ * #false does not write the batch.
+ *
+ * @return number of elements inserted, or 0 if the batch was not admitted
+ */
+uint32_t RingBuff_WrV(ringbuff_t *pRb, const ringbuff_vec_t *pVec, uint32_t pVecN, bool_t pOw );
+
+/**
+ * Reserves free slots to be filled in place, without writing them yet
+ *
+ * @note The slots are only added to the buffer by #RingBuff_WrCommit. Until
+ * then, a new reservation gives the same slots again, so a producer can fill
+ * them across many calls.
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_t
+ * @param[in]       pN          : Number of elements
+ * @param[out]      pSegs       : Segments. The second one is empty when the slots
+ * do not cross the end of the buffer.
+ *
+ * @note THERE WILL BE NO MEMORY COPY
+ *
+ * @return number of slots reserved, limited to the free slots
+ */
+uint32_t RingBuff_WrReserve(ringbuff_t *pRb, uint32_t pN, ringbuff_vec_t pSegs[2]);
+
+/**
+ * Adds the first N reserved slots to the buffer
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_t
+ * @param[in]       pN          : Number of elements filled by the producer
+ *
+ * @return number of elements inserted
+ */
+uint32_t RingBuff_WrCommit(ringbuff_t *pRb, uint32_t pN);
+
 /**
  * Gets the next element from the ring buffer by its pointer.
  *
@@ -119,6 +198,86 @@ uint32_t RingBuff_RdOne(ringbuff_t *pRb, void *pEl);
  */
 uint32_t RingBuff_RdAdvance(ringbuff_t *pRb, void *pRdBuff, uint32_t pN);
 
+/**
+ * Gets the newest N elements from the ring buffer, oldest first, leaving them
+ * in the buffer. Two memcpy at most, straight from behind the tail.
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_t
+ * @param[out]      pRdBuff     : Pointer to an element vector
+ * @param[in]       pN          : Number of elements to read
+ *
+ * @return number of elements read, limited to the elements stored
+ */
+uint32_t RingBuff_RdLatest(ringbuff_t *pRb, void *pRdBuff, uint32_t pN);
+
+#if defined(RINGBUFF_FREE_RUNNING)
+/**
+ * Same as #RingBuff_RdLatest, while an ISR on the same core writes in overwrite
+ * mode. The tail is read before and after the copy; when the producer got to
+ * the copied elements, the copy is retried.
+ *
+ * @note Only with RINGBUFF_FREE_RUNNING: it needs the free-running tail to
+ * tell how many elements were written during the copy.
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_t
+ * @param[out]      pRdBuff     : Pointer to an element vector
+ * @param[in]       pN          : Number of elements to read
+ * @param[in]       pTries      : Maximum number of copies
+ *
+ * @return number of elements read, or 0 if no copy was consistent
+ */
+uint32_t RingBuff_RdLatestSnap(ringbuff_t *pRb, void *pRdBuff, uint32_t pN, uint32_t pTries);
+#endif
+
+/**
+ * Gets the element at an index from the ring buffer by its pointer, leaving it in the buffer.
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_t
+ * @param[in]       pIdx        : Element index, 0 being the oldest element
+ *
+ * @note THERE WILL BE NO MEMORY COPY
+ *
+ * @return pointer to the element, or #NULL if there's no element at the index
+ */
+void *RingBuff_PeekAt(ringbuff_t *pRb, uint32_t pIdx);
+
+/**
+ * Gets the contiguous segments holding N elements, leaving them in the buffer.
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_t
+ * @param[in]       pIdx        : Index of the first element, 0 being the oldest element
+ * @param[in]       pN          : Number of elements
+ * @param[out]      pSegs       : Segments. The second one is empty when the elements
+ * do not cross the end of the buffer.
+ *
+ * @note THERE WILL BE NO MEMORY COPY
+ *
+ * @return number of elements in the segments
+ */
+uint32_t RingBuff_PeekSegs(ringbuff_t *pRb, uint32_t pIdx, uint32_t pN, ringbuff_vec_t pSegs[2]);
+
+/**
+ * Searches for a byte in the elements of the ring buffer, without reading them.
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_t
+ * @param[in]       pFrom       : Index of the first element to search
+ * @param[in]       pByte       : Byte to search for, in any position of an element
+ *
+ * @return index of the first element holding the byte, or #RINGBUFF_NOT_FOUND
+ */
+uint32_t RingBuff_FindByte(ringbuff_t *pRb, uint32_t pFrom, uint8_t pByte);
+
+/**
+ * Searches for an element in the ring buffer, without reading it.
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_t
+ * @param[in]       pFrom       : Index of the first element to search
+ * @param[in]       pEl         : Pointer to the element to search for
+ *
+ * @return index of the first matching element, or #RINGBUFF_NOT_FOUND
+ */
+uint32_t RingBuff_FindElem(ringbuff_t *pRb, uint32_t pFrom, const void *pEl);
+
 /**
  * Gets N elements from the ring buffer
  *
@@ -131,6 +290,20 @@ uint32_t RingBuff_RdAdvance(ringbuff_t *pRb, void *pRdBuff, uint32_t pN);
  */
 uint32_t RingBuff_RdMany(ringbuff_t *pRb, void *pRdBuff, uint32_t pN);
 
+/**
+ * Gets elements from the ring buffer into many vectors, as a single batch
+ *
+ * @note The batch is all-or-nothing: if there are not enough elements to fill
+ * every vector, nothing is read.
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_t
+ * @param[in]       pVec        : Pointer to a #ringbuff_vec_t list
+ * @param[in]       pVecN       : Number of vectors in the list
+ *
+ * @return number of elements read, or 0 if there are not enough elements
+ */
+uint32_t RingBuff_RdV(ringbuff_t *pRb, const ringbuff_vec_t *pVec, uint32_t pVecN);
+
 /**
  * Discards N elements from the ring buffer
  *
@@ -193,6 +366,474 @@ bool_t RingBuff_IsFull(ringbuff_t *pRb);
  */
 uint32_t RingBuff_Sz(ringbuff_t *pRb);
 
+#if defined(RINGBUFF_NOTIFY)
+/**
+ * Sets the flags that every successful write ORs with a mask, atomically. Call
+ * it after #RingBuff_Init.
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_t
+ * @param[in,out]   pFlags      : Pointer to the flag word, or #NULL to stop notifying
+ * @param[in]       pMask       : Bits to set
+ */
+void RingBuff_SetNotify(ringbuff_t *pRb, volatile uint32_t *pFlags, uint32_t pMask);
+#endif
+
+#if defined(ARCH_HAS_CRIT)
+/*
+ * Locked variants, for a producer and a consumer in different contexts (main
+ * loop and ISR, or two host threads). The lock is held only to read and to
+ * update the indexes, never during the copy: each side copies into the region
+ * it owns. There's no overwrite mode, so the producer never moves the head.
+ * The lock may be shared by several ring buffers.
+ */
+
+/**
+ * Writes N elements, holding the lock only around the index updates
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_t
+ * @param[in,out]   pLock       : Lock, see #Arch_CritEnter
+ * @param[in]       pWrBuff     : Pointer to the element vector
+ * @param[in]       pN          : Number of elements
+ *
+ * @return number of elements written, limited to the free slots
+ */
+uint32_t RingBuff_WrManyLocked(ringbuff_t *pRb, arch_lock_t *pLock, const void * const pWrBuff, uint32_t pN);
+
+/**
+ * Writes one element, holding the lock only around the index updates
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_t
+ * @param[in,out]   pLock       : Lock, see #Arch_CritEnter
+ * @param[in]       pEl         : Pointer to the element
+ *
+ * @return number of elements written
+ */
+uint32_t RingBuff_WrOneLocked(ringbuff_t *pRb, arch_lock_t *pLock, const void * const pEl);
+
+/**
+ * Reads up to N elements, holding the lock only around the index updates
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_t
+ * @param[in,out]   pLock       : Lock, see #Arch_CritEnter
+ * @param[out]      pRdBuff     : Pointer to the element vector. If #NULL, the elements are discarded.
+ * @param[in]       pN          : Number of elements
+ *
+ * @return number of elements read
+ */
+uint32_t RingBuff_RdManyLocked(ringbuff_t *pRb, arch_lock_t *pLock, void *pRdBuff, uint32_t pN);
+
+/**
+ * Reads one element, holding the lock only around the index updates
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_t
+ * @param[in,out]   pLock       : Lock, see #Arch_CritEnter
+ * @param[out]      pEl         : Pointer to the element. If #NULL, the element is discarded.
+ *
+ * @return number of elements read
+ */
+uint32_t RingBuff_RdOneLocked(ringbuff_t *pRb, arch_lock_t *pLock, void *pEl);
+
+/**
+ * Gets number of elements in the ring buffer, under the lock
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_t
+ * @param[in,out]   pLock       : Lock, see #Arch_CritEnter
+ *
+ * @return number of elements stored
+ */
+uint32_t RingBuff_UsedLocked(ringbuff_t *pRb, arch_lock_t *pLock);
+#endif
+
+
+/*
+ * Index cores, shared by the functions above and by the inline API. The
+ * geometry comes as parameters (see _RINGBUFF_GEOM), so the compiler folds it
+ * when it is constant. They do not validate the structure.
+ */
+
+#if defined(RINGBUFF_FREE_RUNNING)
+#define _RINGBUFF_GEOM( __rb )  (__rb)->sz, (__rb)->eSz, (__rb)->mask
+#else
+#define _RINGBUFF_GEOM( __rb )  (__rb)->sz, (__rb)->eSz, 0
+#endif
+
+static INLINE uint32_t _ringbuff_updateIndex( uint32_t pId, uint32_t pUpdateSz, uint32_t pMaxSz )
+{
+    pId += pUpdateSz;
+
+    if( pId >= pMaxSz )
+    {
+        pId -= pMaxSz;
+    }
+
+    return pId;
+}
+
+#if defined(RINGBUFF_FREE_RUNNING)
+
+static INLINE uint32_t _ringbuff_usedK( const ringbuff_t *pRb, uint32_t pSz, uint32_t pElSz, uint32_t pMask )
+{
+    (void)pSz; (void)pElSz; (void)pMask;
+    return pRb->tail - pRb->head;
+}
+
+static INLINE bool_t _ringbuff_isFullK( const ringbuff_t *pRb, uint32_t pSz, uint32_t pElSz, uint32_t pMask )
+{
+    (void)pSz; (void)pElSz;
+    return (bool_t)( (pRb->tail - pRb->head) > pMask );
+}
+
+static INLINE uint32_t _ringbuff_headOffK( const ringbuff_t *pRb, uint32_t pSz, uint32_t pElSz, uint32_t pMask )
+{
+    (void)pSz;
+    return (pRb->head & pMask) * pElSz;
+}
+
+static INLINE uint32_t _ringbuff_tailOffK( const ringbuff_t *pRb, uint32_t pSz, uint32_t pElSz, uint32_t pMask )
+{
+    (void)pSz;
+    return (pRb->tail & pMask) * pElSz;
+}
+
+static INLINE void _ringbuff_advHeadK( ringbuff_t *pRb, uint32_t pN, uint32_t pSz, uint32_t pElSz, uint32_t pMask )
+{
+    (void)pSz; (void)pElSz; (void)pMask;
+    pRb->head += pN;
+}
+
+static INLINE void _ringbuff_advTailK( ringbuff_t *pRb, uint32_t pN, uint32_t pSz, uint32_t pElSz, uint32_t pMask )
+{
+    (void)pSz; (void)pElSz; (void)pMask;
+    pRb->tail += pN;
+}
+
+static INLINE void _ringbuff_resetK( ringbuff_t *pRb )
+{
+    pRb->head = pRb->tail = pRb->full = 0;
+}
+
+#else
+
+static INLINE uint32_t _ringbuff_usedK( const ringbuff_t *pRb, uint32_t pSz, uint32_t pElSz, uint32_t pMask )
+{
+    (void)pMask;
+
+    if( pRb->tail > pRb->head )
+    {
+        return ((pRb->tail - pRb->head) / pElSz);
+    }
+    else if( (pRb->head == pRb->tail) && !(pRb->full) )
+    {
+        return 0;
+    }
+    else
+    {
+        return ((pSz - (pRb->head - pRb->tail)) / pElSz);
+    }
+}
+
+static INLINE bool_t _ringbuff_isFullK( const ringbuff_t *pRb, uint32_t pSz, uint32_t pElSz, uint32_t pMask )
+{
+    (void)pSz; (void)pElSz; (void)pMask;
+    return (bool_t)( pRb->full );
+}
+
+static INLINE uint32_t _ringbuff_headOffK( const ringbuff_t *pRb, uint32_t pSz, uint32_t pElSz, uint32_t pMask )
+{
+    (void)pSz; (void)pElSz; (void)pMask;
+    return pRb->head;
+}
+
+static INLINE uint32_t _ringbuff_tailOffK( const ringbuff_t *pRb, uint32_t pSz, uint32_t pElSz, uint32_t pMask )
+{
+    (void)pSz; (void)pElSz; (void)pMask;
+    return pRb->tail;
+}
+
+static INLINE void _ringbuff_advHeadK( ringbuff_t *pRb, uint32_t pN, uint32_t pSz, uint32_t pElSz, uint32_t pMask )
+{
+    (void)pMask;
+
+    if( pN > 0 )
+    {
+        pRb->head = _ringbuff_updateIndex( pRb->head, pN * pElSz, pSz );
+        pRb->full = 0;
+    }
+}
+
+static INLINE void _ringbuff_advTailK( ringbuff_t *pRb, uint32_t pN, uint32_t pSz, uint32_t pElSz, uint32_t pMask )
+{
+    (void)pMask;
+
+    if( pN > 0 )
+    {
+        pRb->tail = _ringbuff_updateIndex( pRb->tail, pN * pElSz, pSz );
+        pRb->full = pRb->head == pRb->tail;
+    }
+}
+
+static INLINE void _ringbuff_resetK( ringbuff_t *pRb )
+{
+    pRb->head = pRb->tail = pRb->full = 0;
+}
+
+#endif /* RINGBUFF_FREE_RUNNING */
+
+static INLINE void _ringbuff_notifyK( ringbuff_t *pRb )
+{
+#if defined(RINGBUFF_NOTIFY)
+    if( pRb->ntf != NULL )
+    {
+        ARCH_ATOMIC_OR32( pRb->ntf, pRb->ntfMask, __ATOMIC_RELEASE );
+    }
+#else
+    (void)pRb;
+#endif
+}
+
+static INLINE uint32_t _ringbuff_wrOneK( ringbuff_t *pRb, const void *pEl, bool_t pOw, uint32_t pSz, uint32_t pElSz, uint32_t pMask )
+{
+    if( _ringbuff_isFullK( pRb, pSz, pElSz, pMask ) )
+    {
+        if( !pOw )
+        {
+            return 0;
+        }
+        //sobrescreve o início do buffer
+        _ringbuff_advHeadK( pRb, 1, pSz, pElSz, pMask );
+    }
+
+    memcpy( &((uint8_t*)pRb->data)[ _ringbuff_tailOffK( pRb, pSz, pElSz, pMask ) ], pEl, pElSz );
+
+    _ringbuff_advTailK( pRb, 1, pSz, pElSz, pMask );
+    _ringbuff_notifyK( pRb );
+
+    return 1;
+}
+
+static INLINE void *_ringbuff_rdOnePtrK( ringbuff_t *pRb, uint32_t pSz, uint32_t pElSz, uint32_t pMask )
+{
+    uint8_t *ptr;
+
+    if( _ringbuff_usedK( pRb, pSz, pElSz, pMask ) == 0 )
+    {
+        return NULL;
+    }
+
+    ptr = &((uint8_t*)pRb->data)[ _ringbuff_headOffK( pRb, pSz, pElSz, pMask ) ];
+
+    _ringbuff_advHeadK( pRb, 1, pSz, pElSz, pMask );
+
+    return ptr;
+}
+
+static INLINE uint32_t _ringbuff_rdOneK( ringbuff_t *pRb, void *pEl, uint32_t pSz, uint32_t pElSz, uint32_t pMask )
+{
+    void *ptr = _ringbuff_rdOnePtrK( pRb, pSz, pElSz, pMask );
+
+    if( ptr == NULL )
+    {
+        return 0;
+    }
+    if( pEl != NULL )
+    {
+        memcpy( pEl, ptr, pElSz );
+    }
+
+    return 1;
+}
+
+#if defined(RINGBUFF_FREE_RUNNING)
+#define _RINGBUFF_STATIC_MASK( __nEls )     .mask = (__nEls) - 1,
+#define _RINGBUFF_STATIC_NELS_OK( __nEls )  ( ((__nEls) & ((__nEls) - 1)) == 0 )
+#else
+#define _RINGBUFF_STATIC_MASK( __nEls )
+#define _RINGBUFF_STATIC_NELS_OK( __nEls )  ( 1 )
+#endif
+
+#define _RINGBUFF_STATIC_GEOM( __name, __elType, __nEls ) \
+    sizeof(__name##_data), sizeof(__elType), ((__nEls) - 1)
+
+/**
+ * Defines a ring buffer whose capacity and element size are compile-time
+ * constants: its storage and an already initialized #ringbuff_t, so there's
+ * no need to call #RingBuff_Init.
+ *
+ * The structure works with every RingBuff_* function. The macro also defines
+ * specialized inline functions, in which the compiler folds the geometry
+ * into constants:
+ * - uint32_t __name##_WrOne(const __elType *pEl, bool_t pOw)
+ * - uint32_t __name##_RdOne(__elType *pEl)
+ * - __elType *__name##_RdOnePtr(void)
+ * - uint32_t __name##_Used(void)
+ * - uint32_t __name##_Free(void)
+ *
+ * With RINGBUFF_FREE_RUNNING, the number of elements must be a power of 2.
+ *
+ * The storage is an array of __elType, so every element is aligned for its
+ * type by construction: there's nothing to check.
+ *
+ * Usage, at file scope: RINGBUFF_STATIC_DEFINE( uartRx, uint8_t, 128 );
+ *
+ * @param           __name      : Name of the #ringbuff_t. The storage is __name##_data
+ * @param           __elType    : Element type
+ * @param           __nEls      : Number of elements
+ */
+#define RINGBUFF_STATIC_DEFINE( __name, __elType, __nEls )                                                    \
+    static __elType __name##_data[ (__nEls) ];                                                                \
+    static ringbuff_t __name =                                                                                \
+    {                                                                                                         \
+        .data = __name##_data,                                                                                \
+        .head = 0,                                                                                            \
+        .tail = 0,                                                                                            \
+        .sz = (uint32_t)sizeof(__name##_data),                                                                \
+        _RINGBUFF_STATIC_MASK( __nEls )                                                                       \
+        .full = 0,                                                                                            \
+        .init = 1,                                                                                            \
+        .eSz = sizeof(__elType),                                                                              \
+    };                                                                                                        \
+    static INLINE uint32_t __name##_WrOne( const __elType *pEl, bool_t pOw )                                  \
+    {                                                                                                         \
+        return _ringbuff_wrOneK( &__name, pEl, pOw, _RINGBUFF_STATIC_GEOM( __name, __elType, __nEls ) );      \
+    }                                                                                                         \
+    static INLINE uint32_t __name##_RdOne( __elType *pEl )                                                    \
+    {                                                                                                         \
+        return _ringbuff_rdOneK( &__name, pEl, _RINGBUFF_STATIC_GEOM( __name, __elType, __nEls ) );           \
+    }                                                                                                         \
+    static INLINE __elType *__name##_RdOnePtr( void )                                                         \
+    {                                                                                                         \
+        return (__elType *)_ringbuff_rdOnePtrK( &__name, _RINGBUFF_STATIC_GEOM( __name, __elType, __nEls ) ); \
+    }                                                                                                         \
+    static INLINE uint32_t __name##_Used( void )                                                              \
+    {                                                                                                         \
+        return _ringbuff_usedK( &__name, _RINGBUFF_STATIC_GEOM( __name, __elType, __nEls ) );                 \
+    }                                                                                                         \
+    static INLINE uint32_t __name##_Free( void )                                                              \
+    {                                                                                                         \
+        return (__nEls) - _ringbuff_usedK( &__name, _RINGBUFF_STATIC_GEOM( __name, __elType, __nEls ) );      \
+    }                                                                                                         \
+    STATIC_ASSERT( (sizeof(__elType) > 0) && (sizeof(__elType) <= RINGBUFF_ELEMENT_MAX),                      \
+                   __name##_element_size_fits_eSz );                                                          \
+    STATIC_ASSERT( ((__nEls) > 0) && ((uint64_t)(__nEls) * sizeof(__elType) <= UINT32_MAX),                   \
+                   __name##_storage_size_fits_sz );                                                           \
+    STATIC_ASSERT( _RINGBUFF_STATIC_NELS_OK( __nEls ),                                                        \
+                   __name##_free_running_needs_power_of_2_elements )
+
+
+#if defined(RINGBUFF_INLINE_API)
+
+/*
+ * Inline API: static inline versions of the hot functions, with no nested
+ * calls. RINGBUFF_INLINE_CHECKS selects if they validate the structure like
+ * the functions above do. By default they do, unless NDEBUG is defined.
+ */
+
+#if !defined(RINGBUFF_INLINE_CHECKS)
+#if defined(NDEBUG)
+#define RINGBUFF_INLINE_CHECKS  ( 0 )
+#else
+#define RINGBUFF_INLINE_CHECKS  ( 1 )
+#endif
+#endif
+
+#if ( RINGBUFF_INLINE_CHECKS )
+#define _RINGBUFF_INLINE_CHECK( __rb )  if( ((__rb) == NULL) || !(__rb)->init ) { return 0; }
+#else
+#define _RINGBUFF_INLINE_CHECK( __rb )
+#endif
+
+static INLINE uint32_t RingBuff_WrOneInline(ringbuff_t *pRb, void * const pEl, bool_t pOw )
+{
+    _RINGBUFF_INLINE_CHECK( pRb );
+    return _ringbuff_wrOneK( pRb, pEl, pOw, _RINGBUFF_GEOM( pRb ) );
+}
+
+static INLINE uint32_t RingBuff_RdOnePtrInline(ringbuff_t *pRb, void **pEl)
+{
+    void *ptr;
+
+    _RINGBUFF_INLINE_CHECK( pRb );
+
+    ptr = _ringbuff_rdOnePtrK( pRb, _RINGBUFF_GEOM( pRb ) );
+    if( ptr == NULL )
+    {
+        return 0;
+    }
+    if( pEl != NULL )
+    {
+        *pEl = ptr;
+    }
+
+    return 1;
+}
+
+static INLINE uint32_t RingBuff_RdOneInline(ringbuff_t *pRb, void *pEl)
+{
+    _RINGBUFF_INLINE_CHECK( pRb );
+    return _ringbuff_rdOneK( pRb, pEl, _RINGBUFF_GEOM( pRb ) );
+}
+
+static INLINE uint32_t RingBuff_UsedInline(ringbuff_t *pRb)
+{
+    _RINGBUFF_INLINE_CHECK( pRb );
+    return _ringbuff_usedK( pRb, _RINGBUFF_GEOM( pRb ) );
+}
+
+static INLINE uint32_t RingBuff_SzInline(ringbuff_t *pRb)
+{
+    _RINGBUFF_INLINE_CHECK( pRb );
+#if defined(RINGBUFF_FREE_RUNNING)
+    return pRb->mask + 1;
+#else
+    return pRb->sz / pRb->eSz;
+#endif
+}
+
+static INLINE uint32_t RingBuff_FreeInline(ringbuff_t *pRb)
+{
+    _RINGBUFF_INLINE_CHECK( pRb );
+#if defined(RINGBUFF_FREE_RUNNING)
+    return pRb->mask + 1 - _ringbuff_usedK( pRb, _RINGBUFF_GEOM( pRb ) );
+#else
+    return (pRb->sz / pRb->eSz) - _ringbuff_usedK( pRb, _RINGBUFF_GEOM( pRb ) );
+#endif
+}
+
+static INLINE bool_t RingBuff_IsEmptyInline(ringbuff_t *pRb)
+{
+#if ( RINGBUFF_INLINE_CHECKS )
+    if( (pRb == NULL) || !pRb->init )
+    {
+        return true;
+    }
+#endif
+    return (bool_t)( _ringbuff_usedK( pRb, _RINGBUFF_GEOM( pRb ) ) == 0 );
+}
+
+static INLINE bool_t RingBuff_IsFullInline(ringbuff_t *pRb)
+{
+#if ( RINGBUFF_INLINE_CHECKS )
+    if( (pRb == NULL) || !pRb->init )
+    {
+        return true;
+    }
+#endif
+    return _ringbuff_isFullK( pRb, _RINGBUFF_GEOM( pRb ) );
+}
+
+#if !defined(RINGBUFF_IMPL)
+#define RingBuff_WrOne      RingBuff_WrOneInline
+#define RingBuff_RdOnePtr   RingBuff_RdOnePtrInline
+#define RingBuff_RdOne      RingBuff_RdOneInline
+#define RingBuff_Used       RingBuff_UsedInline
+#define RingBuff_Sz         RingBuff_SzInline
+#define RingBuff_Free       RingBuff_FreeInline
+#define RingBuff_IsEmpty    RingBuff_IsEmptyInline
+#define RingBuff_IsFull     RingBuff_IsFullInline
+#endif
+
+#endif /* RINGBUFF_INLINE_API */
+
 
 /**
  * @}
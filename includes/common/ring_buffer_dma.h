@@ -0,0 +1,156 @@
+/**************************************************************************//**
+ * @file     ring_buffer_dma.h
+ * @brief    Functions prototypes for a FIFO ring buffer filled by a DMA in
+ * circular mode.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * The ring storage IS the DMA target. The producer is the hardware: the write
+ * position comes from a callback returning the DMA remaining-transfer count,
+ * plus the number of laps counted by #RingBuffDma_LapIsr, which is called
+ * from the DMA-complete interruption and does nothing but increment a counter.
+ * The consumer reads straight from DMA memory; there's no copy in the ISR.
+ *
+ * If the hardware gets more than a lap ahead of the consumer, the overrun is
+ * detected, the unread data is dropped and the overrun counter is incremented.
+ *
+ * The consumer must run at a lower priority than the DMA-complete
+ * interruption: while the lap is not counted, a DMA that just wrapped is only
+ * told apart from one at the start of its lap if the consumer is less than a
+ * lap behind.
+ *
+ * For ping-pong (two half-buffer) transfers, make the callback return the
+ * remaining count of the whole lap (e.g. the count of the first half plus
+ * half the buffer while the first half is active) and call
+ * #RingBuffDma_LapIsr on the completion of the second half only.
+ *
+ ******************************************************************************/
+
+#ifndef INCLUDES_COMMON_RING_BUFFER_DMA_H_
+#define INCLUDES_COMMON_RING_BUFFER_DMA_H_
+
+#include "api_config.h"
+
+/**
+ * @addtogroup COMMON_GROUP
+ * @{
+ */
+
+/**
+ * Gets the number of elements the DMA still has to transfer in the current lap.
+ *
+ * @param[in]       pCtx        : User context given to #RingBuffDma_Init
+ *
+ * @return remaining transfers, from the number of elements (lap start) down to 0
+ */
+typedef uint32_t (*ringbuff_dma_remaining_t)(void *pCtx);
+
+/**
+ * DMA ring buffer structure
+ */
+typedef struct
+{
+    void *data;                         ///< DMA target
+    uint32_t n;                         ///< Number of elements (transfers in a lap)
+    ringbuff_dma_remaining_t remaining; ///< Remaining-transfer count callback
+    void *ctx;                          ///< Callback context
+    volatile uint32_t laps;             ///< Laps completed, counted by #RingBuffDma_LapIsr
+    uint32_t head;                      ///< Elements read (free-running)
+    uint32_t headSlot;                  ///< Slot of the next element to read
+    uint32_t tail;                      ///< Elements written by the DMA (free-running), as last seen
+    uint32_t overruns;                  ///< Number of overruns detected
+    uint8_t eSz;                        ///< size of a single element(bytes)
+    bool_t init;                        ///< flag indicating initialized
+}ringbuff_dma_t;
+
+/**
+ * Initializes the structure. Call it before starting the DMA.
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_dma_t
+ * @param[in]       pBuff       : Pointer to the DMA target
+ * @param[in]       pSz         : Size of the DMA target
+ * @param[in]       pElSz       : Size of a single element (DMA transfer)
+ * @param[in]       pRemaining  : Remaining-transfer count callback
+ * @param[in]       pCtx        : Callback context. Can be #NULL
+ *
+ * @return The number of elements this ring buffer holds
+ */
+uint32_t RingBuffDma_Init(ringbuff_dma_t *pRb, void * const pBuff, uint32_t pSz, uint8_t pElSz,
+                          ringbuff_dma_remaining_t pRemaining, void *pCtx);
+
+/**
+ * Counts a completed DMA lap. Call it from the DMA-complete interruption.
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_dma_t
+ */
+void RingBuffDma_LapIsr(ringbuff_dma_t *pRb);
+
+/**
+ * Gets number of elements written by the DMA and not read yet
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_dma_t
+ *
+ * @return number of elements stored
+ */
+uint32_t RingBuffDma_Used(ringbuff_dma_t *pRb);
+
+/**
+ * Gets N elements from the ring buffer
+ *
+ * @note If the DMA overwrites the elements while they are copied, nothing is
+ * read and the overrun is counted.
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_dma_t
+ * @param[in,out]   pRdBuff     : Pointer to an element vector
+ * @param[in]       pN          : Number of elements to read
+ *
+ * @return number of elements read
+ */
+uint32_t RingBuffDma_RdMany(ringbuff_dma_t *pRb, void *pRdBuff, uint32_t pN);
+
+/**
+ * Gets the contiguous run of unread elements, leaving them in the buffer.
+ * Release them with #RingBuffDma_Discard once processed.
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_dma_t
+ * @param[out]      pEl         : Pointer to point to the DMA memory where the elements are.
+ *
+ * @note THERE WILL BE NO MEMORY COPY
+ *
+ * @return number of contiguous elements
+ */
+uint32_t RingBuffDma_RdPtr(ringbuff_dma_t *pRb, void **pEl);
+
+/**
+ * Discards N elements from the ring buffer
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_dma_t
+ * @param[in]       pN          : Number of elements to discard
+ *
+ * @return number of elements discarded
+ */
+uint32_t RingBuffDma_Discard(ringbuff_dma_t *pRb, uint32_t pN);
+
+/**
+ * Gets number of overruns detected
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_dma_t
+ *
+ * @return number of overruns
+ */
+uint32_t RingBuffDma_Overruns(ringbuff_dma_t *pRb);
+
+/**
+ * Gets elements max size
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_dma_t
+ *
+ * @return maximum number of elements
+ */
+uint32_t RingBuffDma_Sz(ringbuff_dma_t *pRb);
+
+/**
+ * @}
+ */
+
+#endif /* INCLUDES_COMMON_RING_BUFFER_DMA_H_ */
@@ -0,0 +1,146 @@
+/**************************************************************************//**
+ * @file     ring_buffer_mc.h
+ * @brief    Functions prototypes for a multicore single-producer/single-consumer
+ * FIFO ring buffer.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * Same idea as #ringbuff_t, laid out for a producer and a consumer running on
+ * different cores:
+ * - the consumer state (head) and the producer state (tail) sit on separate
+ *   cache lines, so a write does not invalidate the consumer's line and the
+ *   other way round;
+ * - each side keeps a cached copy of the other side's index, and only reloads
+ *   it when the ring looks full (producer) or empty (consumer);
+ * - head and tail are free-running element counters, so there's no shared
+ *   full flag. The number of elements is rounded down to a power of 2.
+ *
+ * Lock-free for exactly one producer and one consumer. There's no overwrite.
+ *
+ ******************************************************************************/
+
+#ifndef INCLUDES_COMMON_RING_BUFFER_MC_H_
+#define INCLUDES_COMMON_RING_BUFFER_MC_H_
+
+#include "api_config.h"
+
+/**
+ * @addtogroup COMMON_GROUP
+ * @{
+ */
+
+/**
+ * Multicore ring buffer structure
+ */
+typedef struct
+{
+    struct
+    {
+        void *data;                 ///< Data in buffer
+        uint32_t mask;              ///< Number of elements - 1
+        uint8_t eSz;                ///< size of a single element(bytes)
+        bool_t init;                ///< flag indicating initialized
+    }cfg ATTR_ALIGNED(ARCH_CACHE_LINE_SZ);  ///< Read-only after init, shared by both sides
+
+    struct
+    {
+        volatile uint32_t head;     ///< Elements read so far
+        uint32_t tailCache;         ///< Last tail seen by the consumer
+    }rd ATTR_ALIGNED(ARCH_CACHE_LINE_SZ);   ///< Written by the consumer only
+
+    struct
+    {
+        volatile uint32_t tail;     ///< Elements written so far
+        uint32_t headCache;         ///< Last head seen by the producer
+    }wr ATTR_ALIGNED(ARCH_CACHE_LINE_SZ);   ///< Written by the producer only
+}ringbuff_mc_t;
+
+/**
+ * Initializes the structure
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_mc_t
+ * @param[in]       pBuff       : Pointer to a RAM location
+ * @param[in]       pSz         : Size of RAM location
+ * @param[in]       pElSz       : Size element of a single element
+ *
+ * @return The number of elements this ring buffer holds (a power of 2)
+ */
+uint32_t RingBuffMc_Init(ringbuff_mc_t *pRb, void * const pBuff, uint32_t pSz, uint8_t pElSz);
+
+/**
+ * Write an element in the ring buffer. Producer side.
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_mc_t
+ * @param[in]       pEl         : Pointer to the input element
+ *
+ * @return number of elements inserted
+ */
+uint32_t RingBuffMc_WrOne(ringbuff_mc_t *pRb, const void * const pEl);
+
+/**
+ * Write many elements in the ring buffer. Producer side.
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_mc_t
+ * @param[in]       pWrBuff     : Pointer to an element vector
+ * @param[in]       pN          : Number of elements to insert
+ *
+ * @return number of elements inserted. It can be less than pN if the buffer fills up.
+ */
+uint32_t RingBuffMc_WrMany(ringbuff_mc_t *pRb, const void * const pWrBuff, uint32_t pN);
+
+/**
+ * Gets the next element from the ring buffer. Consumer side.
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_mc_t
+ * @param[in,out]   pEl         : Pointer to the RAM where the element is copied.
+ * It can be #NULL, so the element will be simply discarded.
+ *
+ * @return number of elements read
+ */
+uint32_t RingBuffMc_RdOne(ringbuff_mc_t *pRb, void *pEl);
+
+/**
+ * Gets N elements from the ring buffer. Consumer side.
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_mc_t
+ * @param[in,out]   pRdBuff     : Pointer to an element vector. If #NULL,
+ * no memory copy is made and the elements will be discarded.
+ * @param[in]       pN          : Number of elements to read
+ *
+ * @return number of elements read
+ */
+uint32_t RingBuffMc_RdMany(ringbuff_mc_t *pRb, void *pRdBuff, uint32_t pN);
+
+/**
+ * Gets number of elements in the ring buffer. Exact only on the producer or
+ * consumer side; elsewhere it's a snapshot.
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_mc_t
+ *
+ * @return number of elements stored
+ */
+uint32_t RingBuffMc_Used(ringbuff_mc_t *pRb);
+
+/**
+ * Gets number of free slots
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_mc_t
+ *
+ * @return number of free slots
+ */
+uint32_t RingBuffMc_Free(ringbuff_mc_t *pRb);
+
+/**
+ * Gets elements max size
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_mc_t
+ *
+ * @return maximum number of elements
+ */
+uint32_t RingBuffMc_Sz(ringbuff_mc_t *pRb);
+
+/**
+ * @}
+ */
+
+#endif /* INCLUDES_COMMON_RING_BUFFER_MC_H_ */
@@ -0,0 +1,171 @@
+/**************************************************************************//**
+ * @file     ring_buffer_pers.h
+ * @brief    Functions prototypes for a persistent FIFO ring buffer.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * The control block lives at the start of the storage region, so the whole
+ * ring survives a reset when the region does: RAM kept across resets
+ * (#ATTR_NOINIT) on target, or an mmap()ed file on Linux.
+ *
+ * At boot, #RingBuffPers_Attach validates the control block in O(1) and picks
+ * up where the ring was, with no replay or rebuild. The control block has two
+ * slots (head, tail, sequence number and CRC32), written alternately after
+ * each element, so a reset in the middle of an update leaves the previous
+ * slot valid. When full, the oldest element is dropped from the control block
+ * before its slot is overwritten: a reset never exposes a torn element.
+ *
+ * The region must be aligned to 4 bytes. Indexes are free-running and the
+ * number of elements is rounded down to a power of 2. As with #ringbuff_t, it
+ * does NOT turn off interruptions.
+ *
+ ******************************************************************************/
+
+#ifndef INCLUDES_COMMON_RING_BUFFER_PERS_H_
+#define INCLUDES_COMMON_RING_BUFFER_PERS_H_
+
+#include "api_config.h"
+
+/**
+ * @addtogroup COMMON_GROUP
+ * @{
+ */
+
+#define RINGBUFF_PERS_MAGIC     0x53504252UL    ///< "RBPS"
+
+/**
+ * Control block slot
+ */
+typedef struct
+{
+    uint32_t seq;       ///< Update counter: the newest valid slot wins
+    uint32_t head;      ///< Elements read so far
+    uint32_t tail;      ///< Elements written so far
+    uint32_t crc;       ///< CRC32 of the slot and of the geometry
+}ringbuff_pers_slot_t;
+
+/**
+ * Control block, at the start of the storage region
+ */
+typedef struct
+{
+    uint32_t magic;                 ///< #RINGBUFF_PERS_MAGIC
+    uint32_t n;                     ///< Number of elements
+    uint32_t eSz;                   ///< Size of a single element (bytes)
+    uint32_t rsvd;
+    ringbuff_pers_slot_t slot[2];   ///< Written alternately
+}ringbuff_pers_hdr_t;
+
+/**
+ * Persistent ring buffer structure
+ */
+typedef struct
+{
+    volatile ringbuff_pers_hdr_t *hdr;  ///< Control block in the region
+    uint8_t *data;                      ///< Data in the region
+    uint32_t head;                      ///< Elements read so far
+    uint32_t tail;                      ///< Elements written so far
+    uint32_t seq;                       ///< Sequence number of the newest slot
+    uint32_t mask;                      ///< Number of elements - 1
+    uint8_t eSz;                        ///< size of a single element(bytes)
+    bool_t init;                        ///< flag indicating initialized
+}ringbuff_pers_t;
+
+/**
+ * Attaches to a storage region, keeping its contents when they are valid
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_pers_t
+ * @param[in]       pRegion     : Pointer to the storage region, control block included
+ * @param[in]       pSz         : Size of the region
+ * @param[in]       pElSz       : Size of a single element
+ *
+ * @return
+ * - #RES_SUCCESS when the region held a valid ring, which is kept
+ * - #RES_ERR_FORMAT when it did not. The region is formatted as an empty ring.
+ * - #RES_ERR_SZ when the region cannot hold a single element
+ * - #RES_ERROR on invalid parameters
+ */
+res_t RingBuffPers_Attach(ringbuff_pers_t *pRb, void * const pRegion, uint32_t pSz, uint8_t pElSz);
+
+/**
+ * Discards all elements, rewriting the control block
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_pers_t
+ */
+void RingBuffPers_Format(ringbuff_pers_t *pRb);
+
+/**
+ * Write an element in the ring buffer
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_pers_t
+ * @param[in]       pEl         : Pointer to the input element
+ * @param[in]       pOw         : If true, overwrites the oldest element when full
+ *
+ * @return number of elements inserted
+ */
+uint32_t RingBuffPers_WrOne(ringbuff_pers_t *pRb, const void * const pEl, bool_t pOw);
+
+/**
+ * Gets an element from the ring buffer
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_pers_t
+ * @param[out]      pEl         : Pointer to the output element. Can be #NULL
+ *
+ * @return number of elements read
+ */
+uint32_t RingBuffPers_RdOne(ringbuff_pers_t *pRb, void *pEl);
+
+/**
+ * Gets the element at an index by its pointer, leaving it in the buffer.
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_pers_t
+ * @param[in]       pIdx        : Element index, 0 being the oldest element
+ *
+ * @note THERE WILL BE NO MEMORY COPY
+ *
+ * @return pointer to the element, or #NULL if there's no element at the index
+ */
+void *RingBuffPers_PeekAt(ringbuff_pers_t *pRb, uint32_t pIdx);
+
+/**
+ * Discards N elements from the ring buffer
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_pers_t
+ * @param[in]       pN          : Number of elements
+ *
+ * @return number of elements discarded
+ */
+uint32_t RingBuffPers_Discard(ringbuff_pers_t *pRb, uint32_t pN);
+
+/**
+ * Gets number of elements in the ring buffer
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_pers_t
+ *
+ * @return number of elements stored
+ */
+uint32_t RingBuffPers_Used(ringbuff_pers_t *pRb);
+
+/**
+ * Gets number of free slots
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_pers_t
+ *
+ * @return number of free slots
+ */
+uint32_t RingBuffPers_Free(ringbuff_pers_t *pRb);
+
+/**
+ * Gets elements max size
+ *
+ * @param[in,out]   pRb         : Pointer to the structure #ringbuff_pers_t
+ *
+ * @return maximum number of elements
+ */
+uint32_t RingBuffPers_Sz(ringbuff_pers_t *pRb);
+
+/**
+ * @}
+ */
+
+#endif /* INCLUDES_COMMON_RING_BUFFER_PERS_H_ */
@@ -0,0 +1,163 @@
+/**************************************************************************//**
+ * @file     ring_stats.h
+ * @brief    Functions prototypes for sliding-window statistics over a ring buffer.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * The window is a #ringbuff_t of int32_t samples (e.g. the last N ADC
+ * readings). The statistics are updated when a sample enters and when it
+ * leaves the window, so each of them costs O(1) amortized per sample instead
+ * of re-reading the whole window:
+ * - running sum and sum of squares, for the mean and the RMS
+ * - monotonic deques, for the minimum and the maximum
+ *
+ * In overwrite mode the oldest sample is peeked and taken out of the
+ * statistics before it is overwritten, so implicit evictions are accounted.
+ *
+ * The sums wrap modulo 2^64, and subtracting an evicted sample undoes its
+ * addition exactly: the results are right as long as the sum of squares of
+ * the samples in the window fits in 64 bits.
+ *
+ * The samples must only be written and read through these functions. As with
+ * #ringbuff_t, it does NOT turn off interruptions.
+ *
+ ******************************************************************************/
+
+#ifndef INCLUDES_COMMON_RING_STATS_H_
+#define INCLUDES_COMMON_RING_STATS_H_
+
+#include "api_config.h"
+#include "common/ring_buffer.h"
+
+/**
+ * @addtogroup COMMON_GROUP
+ * @{
+ */
+
+/**
+ * Entry of a monotonic deque
+ */
+typedef struct
+{
+    uint32_t seq;       ///< Sequence number of the sample
+    int32_t val;        ///< Sample value
+}ringstats_ent_t;
+
+/**
+ * Monotonic deque, circular over a caller-supplied vector
+ */
+typedef struct
+{
+    ringstats_ent_t *ent;   ///< Entry vector
+    uint32_t sz;            ///< Number of entries in the vector
+    uint32_t first;         ///< Position of the front entry
+    uint32_t n;             ///< Number of entries in the deque
+}ringstats_deque_t;
+
+/**
+ * Sliding-window statistics structure
+ */
+typedef struct
+{
+    ringbuff_t rb;              ///< Ring buffer of int32_t samples
+    ringstats_deque_t min;      ///< Increasing values: the front is the minimum
+    ringstats_deque_t max;      ///< Decreasing values: the front is the maximum
+    uint64_t sum;               ///< Sum of the samples (two's complement)
+    uint64_t sumSq;             ///< Sum of the squares of the samples
+    uint32_t wrSeq;             ///< Sequence number of the next sample written
+    uint32_t rdSeq;             ///< Sequence number of the oldest sample
+}ring_stats_t;
+
+/**
+ * Bytes of RAM used per sample of the window
+ */
+#define RINGSTATS_SAMPLE_SZ     ( sizeof(int32_t) + 2*sizeof(ringstats_ent_t) )
+
+/**
+ * Initializes the structure
+ *
+ * @note The RAM location holds both the samples and the deques, see #RINGSTATS_SAMPLE_SZ.
+ *
+ * @param[in,out]   pSt         : Pointer to the structure #ring_stats_t
+ * @param[in]       pBuff       : Pointer to a RAM location, aligned to 4 bytes
+ * @param[in]       pSz         : Size of RAM location
+ *
+ * @return The number of samples of the window
+ */
+uint32_t RingStats_Init(ring_stats_t *pSt, void * const pBuff, uint32_t pSz);
+
+/**
+ * Writes a sample into the window
+ *
+ * @param[in,out]   pSt         : Pointer to the structure #ring_stats_t
+ * @param[in]       pVal        : Sample
+ * @param[in]       pOw         : If true, the oldest sample is evicted when the window is full
+ *
+ * @return number of samples written
+ */
+uint32_t RingStats_Wr(ring_stats_t *pSt, int32_t pVal, bool_t pOw);
+
+/**
+ * Reads and evicts the oldest sample of the window
+ *
+ * @param[in,out]   pSt         : Pointer to the structure #ring_stats_t
+ * @param[out]      pVal        : Sample. Can be #NULL
+ *
+ * @return number of samples read
+ */
+uint32_t RingStats_Rd(ring_stats_t *pSt, int32_t *pVal);
+
+/**
+ * Gets the mean of the window, truncated toward zero
+ *
+ * @param[in,out]   pSt         : Pointer to the structure #ring_stats_t
+ * @param[out]      pMean       : Mean
+ *
+ * @return number of samples in the window. When 0, @p pMean is not written
+ */
+uint32_t RingStats_Mean(ring_stats_t *pSt, int32_t *pMean);
+
+/**
+ * Gets the root mean square of the window, truncated
+ *
+ * @param[in,out]   pSt         : Pointer to the structure #ring_stats_t
+ * @param[out]      pRms        : Root mean square
+ *
+ * @return number of samples in the window. When 0, @p pRms is not written
+ */
+uint32_t RingStats_Rms(ring_stats_t *pSt, uint32_t *pRms);
+
+/**
+ * Gets the minimum of the window
+ *
+ * @param[in,out]   pSt         : Pointer to the structure #ring_stats_t
+ * @param[out]      pMin        : Minimum
+ *
+ * @return number of samples in the window. When 0, @p pMin is not written
+ */
+uint32_t RingStats_Min(ring_stats_t *pSt, int32_t *pMin);
+
+/**
+ * Gets the maximum of the window
+ *
+ * @param[in,out]   pSt         : Pointer to the structure #ring_stats_t
+ * @param[out]      pMax        : Maximum
+ *
+ * @return number of samples in the window. When 0, @p pMax is not written
+ */
+uint32_t RingStats_Max(ring_stats_t *pSt, int32_t *pMax);
+
+/**
+ * Gets number of samples in the window
+ *
+ * @param[in,out]   pSt         : Pointer to the structure #ring_stats_t
+ *
+ * @return number of samples
+ */
+uint32_t RingStats_Used(ring_stats_t *pSt);
+
+/**
+ * @}
+ */
+
+#endif /* INCLUDES_COMMON_RING_STATS_H_ */
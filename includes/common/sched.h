@@ -0,0 +1,185 @@
+/**************************************************************************//**
+ * @file     sched.h
+ * @brief    Functions prototypes for a cooperative, event-driven scheduler.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * Up to 32 run-to-completion tasks, one per priority (0 is the highest). A
+ * ready bitmap holds one bit per task, priority 0 on the MSB, so the next task
+ * to run is the count of leading zeros of the bitmap.
+ *
+ * A task becomes ready when:
+ * - a ring buffer it subscribed to is written (#Sched_Subscribe, needs
+ *   RINGBUFF_NOTIFY), from the main loop or from an interruption
+ * - #Sched_Ready is called
+ * - it returns #SCHED_YIELD
+ *
+ * Its bit is cleared right before it runs, so a write while it runs makes it
+ * run again. Tasks are plain functions; the PT_* macros below turn them into
+ * stackless coroutines (protothreads), whose local variables don't survive a
+ * wait: keep the state in the task context.
+ *
+ * When nothing is ready, #Sched_Run calls the idle hook instead of polling.
+ * An event may arrive between the check and the sleep: the hook must turn
+ * off interruptions, check #Sched_Pending again and only then sleep (on
+ * Cortex-M, WFI wakes with a pending interruption even when masked).
+ *
+ * The bitmap is updated with atomic operations.
+ *
+ ******************************************************************************/
+
+#ifndef INCLUDES_COMMON_SCHED_H_
+#define INCLUDES_COMMON_SCHED_H_
+
+#include "api_config.h"
+#include "common/ring_buffer.h"
+
+/**
+ * @addtogroup COMMON_GROUP
+ * @{
+ */
+
+/** Number of tasks (priorities) */
+#define SCHED_TASKS_MAX     ( 32 )
+
+/**
+ * Task return values
+ */
+#define SCHED_WAIT          ( 0 )   ///< Run again when ready
+#define SCHED_YIELD         ( 1 )   ///< Stays ready: runs again unless a higher priority task is ready
+#define SCHED_DONE          ( 2 )   ///< Finished. Runs from the start when ready
+
+/**
+ * Task function
+ *
+ * @param[in,out]   pCtx        : Task context, given to #Sched_Add
+ *
+ * @return #SCHED_WAIT, #SCHED_YIELD or #SCHED_DONE
+ */
+typedef uint8_t (*sched_task_t)(void *pCtx);
+
+/**
+ * Idle hook, called when no task is ready
+ */
+typedef void (*sched_idle_t)(void);
+
+/**
+ * Scheduler structure
+ */
+typedef struct
+{
+    volatile uint32_t ready;                ///< Ready bitmap, priority 0 on bit 31
+    sched_task_t task[SCHED_TASKS_MAX];     ///< Task of each priority, or #NULL
+    void *ctx[SCHED_TASKS_MAX];             ///< Context of each task
+    sched_idle_t idle;                      ///< Idle hook, or #NULL
+}sched_t;
+
+/**
+ * Protothread state. Lives in the task context.
+ */
+typedef struct
+{
+    uint16_t lc;    ///< Line to resume from
+}pt_t;
+
+/** Initializes a protothread: it runs from #PT_BEGIN next time */
+#define PT_INIT( __pt )             ( (__pt)->lc = 0 )
+
+/** Starts the protothread body. Resumes from the last wait or yield. */
+#define PT_BEGIN( __pt )            switch( (__pt)->lc ) { case 0:
+
+/** Returns #SCHED_WAIT until the condition is true, e.g. !RingBuff_IsEmpty(&rx) */
+#define PT_WAIT_UNTIL( __pt, __cond )                   \
+    do                                                  \
+    {                                                   \
+        (__pt)->lc = __LINE__;                          \
+        if( 0 ) { case __LINE__:; }                     \
+        if( !(__cond) )                                 \
+        {                                               \
+            return SCHED_WAIT;                          \
+        }                                               \
+    } while(0)
+
+/** Returns #SCHED_YIELD, resuming right after it */
+#define PT_YIELD( __pt )                                \
+    do                                                  \
+    {                                                   \
+        (__pt)->lc = __LINE__;                          \
+        return SCHED_YIELD; case __LINE__:;             \
+    } while(0)
+
+/** Ends the protothread body. Returns #SCHED_DONE. */
+#define PT_END( __pt )              } (__pt)->lc = 0; return SCHED_DONE
+
+/**
+ * Initializes the structure
+ *
+ * @param[in,out]   pS          : Pointer to the structure #sched_t
+ * @param[in]       pIdle       : Idle hook, or #NULL to spin
+ */
+void Sched_Init(sched_t *pS, sched_idle_t pIdle);
+
+/**
+ * Adds a task. It starts not ready.
+ *
+ * @param[in,out]   pS          : Pointer to the structure #sched_t
+ * @param[in]       pPrio       : Priority, 0 (highest) to #SCHED_TASKS_MAX - 1
+ * @param[in]       pTask       : Task function
+ * @param[in]       pCtx        : Task context
+ *
+ * @return #RES_SUCCESS, #RES_ERR_BUSY if the priority is taken, #RES_ERROR on bad parameters
+ */
+res_t Sched_Add(sched_t *pS, uint8_t pPrio, sched_task_t pTask, void *pCtx);
+
+#if defined(RINGBUFF_NOTIFY)
+/**
+ * Makes the task ready on every write to the ring buffer. A task may subscribe
+ * to several ring buffers; a ring buffer notifies a single task.
+ *
+ * @note The task is made ready now if the ring buffer is not empty.
+ *
+ * @param[in,out]   pS          : Pointer to the structure #sched_t
+ * @param[in]       pPrio       : Task priority
+ * @param[in,out]   pRb         : Pointer to an initialized #ringbuff_t
+ */
+void Sched_Subscribe(sched_t *pS, uint8_t pPrio, ringbuff_t *pRb);
+#endif
+
+/**
+ * Makes a task ready. Can be called from interruptions.
+ *
+ * @param[in,out]   pS          : Pointer to the structure #sched_t
+ * @param[in]       pPrio       : Task priority
+ */
+void Sched_Ready(sched_t *pS, uint8_t pPrio);
+
+/**
+ * Checks for ready tasks
+ *
+ * @param[in,out]   pS          : Pointer to the structure #sched_t
+ *
+ * @return #true if some task is ready
+ */
+bool_t Sched_Pending(sched_t *pS);
+
+/**
+ * Runs the highest priority ready task, once
+ *
+ * @param[in,out]   pS          : Pointer to the structure #sched_t
+ *
+ * @return number of tasks run: 0 when none was ready
+ */
+uint32_t Sched_RunOne(sched_t *pS);
+
+/**
+ * Runs the ready tasks forever, calling the idle hook when there's none
+ *
+ * @param[in,out]   pS          : Pointer to the structure #sched_t
+ */
+void Sched_Run(sched_t *pS);
+
+/**
+ * @}
+ */
+
+#endif /* INCLUDES_COMMON_SCHED_H_ */
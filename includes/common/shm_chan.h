@@ -0,0 +1,167 @@
+/**************************************************************************//**
+ * @file     shm_chan.h
+ * @brief    Functions prototypes for a cross-process single-producer/single-consumer
+ * channel in POSIX shared memory (Linux host builds).
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * The control block and the data of a ring live in a shared memory object.
+ * Each process maps it at its own address, so the control block holds the
+ * data position as an offset, never as a pointer.
+ *
+ * Indexes follow #ringbuff_mc_t: free-running counters on separate cache
+ * lines, each side caching the other side's index. At steady state, writes
+ * and reads make no system call.
+ *
+ * With SHMCHAN_FUTEX defined, #ShmChan_RdWait sleeps on a futex, and the
+ * producer only makes the wake-up call when the consumer is asleep. Without
+ * it, #ShmChan_RdWait yields the CPU until there's data.
+ *
+ * Lock-free for exactly one producer and one consumer process.
+ *
+ ******************************************************************************/
+
+#ifndef INCLUDES_COMMON_SHM_CHAN_H_
+#define INCLUDES_COMMON_SHM_CHAN_H_
+
+#include "api_config.h"
+
+#if defined(__linux__)
+
+#include <stddef.h>
+
+/**
+ * @addtogroup COMMON_GROUP
+ * @{
+ */
+
+#define SHMCHAN_MAGIC       0x4E414843UL    ///< "CHAN"
+
+/**
+ * Control block, at the start of the shared memory object
+ */
+typedef struct
+{
+    struct
+    {
+        uint32_t magic;             ///< #SHMCHAN_MAGIC, written last by the creator
+        uint32_t mask;              ///< Number of elements - 1
+        uint32_t eSz;               ///< Size of a single element (bytes)
+        uint32_t dataOff;           ///< Offset of the data from the start of the object
+    }cfg ATTR_ALIGNED(ARCH_CACHE_LINE_SZ);  ///< Read-only after creation
+
+    struct
+    {
+        volatile uint32_t head;     ///< Elements read so far
+        volatile uint32_t sleeping; ///< Consumer waiting for the doorbell
+    }rd ATTR_ALIGNED(ARCH_CACHE_LINE_SZ);   ///< Written by the consumer only
+
+    struct
+    {
+        volatile uint32_t tail;     ///< Elements written so far. Also the doorbell.
+    }wr ATTR_ALIGNED(ARCH_CACHE_LINE_SZ);   ///< Written by the producer only
+}shmchan_ctl_t;
+
+/**
+ * Channel handle, private to each process
+ */
+typedef struct
+{
+    shmchan_ctl_t *ctl;             ///< Control block in this process' mapping
+    uint8_t *data;                  ///< Data in this process' mapping
+    size_t mapSz;                   ///< Size of the mapping
+    uint32_t mask;                  ///< Number of elements - 1
+    uint32_t eSz;                   ///< Size of a single element (bytes)
+    uint32_t headCache;             ///< Producer: last head seen
+    uint32_t tailCache;             ///< Consumer: last tail seen
+    bool_t init;                    ///< flag indicating initialized
+}shm_chan_t;
+
+/**
+ * Creates the shared memory object and maps it
+ *
+ * @param[in,out]   pCh         : Pointer to the structure #shm_chan_t
+ * @param[in]       pName       : Object name, as in shm_open() ("/name")
+ * @param[in]       pN          : Number of elements. Rounded down to a power of 2
+ * @param[in]       pElSz       : Size of a single element
+ *
+ * @return The number of elements the channel holds, or 0 on failure (e.g. the object already exists)
+ */
+uint32_t ShmChan_Create(shm_chan_t *pCh, const char_t *pName, uint32_t pN, uint32_t pElSz);
+
+/**
+ * Maps an object made by #ShmChan_Create in another process
+ *
+ * @param[in,out]   pCh         : Pointer to the structure #shm_chan_t
+ * @param[in]       pName       : Object name, as in shm_open() ("/name")
+ *
+ * @return The number of elements the channel holds, or 0 on failure
+ */
+uint32_t ShmChan_Open(shm_chan_t *pCh, const char_t *pName);
+
+/**
+ * Unmaps the object. It is kept until #ShmChan_Unlink.
+ *
+ * @param[in,out]   pCh         : Pointer to the structure #shm_chan_t
+ */
+void ShmChan_Close(shm_chan_t *pCh);
+
+/**
+ * Removes the object name. Mappings stay valid until closed.
+ *
+ * @param[in]       pName       : Object name
+ *
+ * @return #RES_SUCCESS, or #RES_ERROR when there's no such object
+ */
+res_t ShmChan_Unlink(const char_t *pName);
+
+/**
+ * Writes N elements. Producer side.
+ *
+ * @param[in,out]   pCh         : Pointer to the structure #shm_chan_t
+ * @param[in]       pWrBuff     : Pointer to the element vector
+ * @param[in]       pN          : Number of elements
+ *
+ * @return number of elements written, limited to the free slots
+ */
+uint32_t ShmChan_Wr(shm_chan_t *pCh, const void *pWrBuff, uint32_t pN);
+
+/**
+ * Reads up to N elements. Consumer side.
+ *
+ * @param[in,out]   pCh         : Pointer to the structure #shm_chan_t
+ * @param[out]      pRdBuff     : Pointer to the element vector. If #NULL, the elements are discarded.
+ * @param[in]       pN          : Number of elements
+ *
+ * @return number of elements read
+ */
+uint32_t ShmChan_Rd(shm_chan_t *pCh, void *pRdBuff, uint32_t pN);
+
+/**
+ * Reads up to N elements, waiting for the first one. Consumer side.
+ *
+ * @param[in,out]   pCh         : Pointer to the structure #shm_chan_t
+ * @param[out]      pRdBuff     : Pointer to the element vector. If #NULL, the elements are discarded.
+ * @param[in]       pN          : Number of elements
+ * @param[in]       pTimeoutMs  : Max wait (ms)
+ *
+ * @return number of elements read, 0 on timeout
+ */
+uint32_t ShmChan_RdWait(shm_chan_t *pCh, void *pRdBuff, uint32_t pN, uint32_t pTimeoutMs);
+
+/**
+ * Gets number of elements in the channel
+ *
+ * @param[in,out]   pCh         : Pointer to the structure #shm_chan_t
+ *
+ * @return number of elements stored
+ */
+uint32_t ShmChan_Used(shm_chan_t *pCh);
+
+/**
+ * @}
+ */
+
+#endif /* __linux__ */
+
+#endif /* INCLUDES_COMMON_SHM_CHAN_H_ */
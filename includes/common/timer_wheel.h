@@ -0,0 +1,171 @@
+/**************************************************************************//**
+ * @file     timer_wheel.h
+ * @brief    Functions prototypes for a hierarchical timer wheel.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * Software timers for retransmissions and timeouts, in ticks. Each level of
+ * the wheel has 64 slots; a slot of level N spans 64^N ticks. A timer goes to
+ * the lowest level that reaches its expiry, so starting and stopping it are
+ * O(1). When level 0 wraps, the current slot of level 1 is cascaded: its
+ * timers are moved to level 0, and so on up. Each timer is cascaded at most
+ * once per level, so ticks are amortized O(1).
+ *
+ * The slots come from a caller-supplied buffer: 64 list heads per level. The
+ * number of levels follows from its size, up to #TWHEEL_LEVELS_MAX. With fewer
+ * levels, timers beyond the range of the top level wait in its farthest slot
+ * and are placed again when it is cascaded.
+ *
+ * Timers are intrusive: #twheel_tmr_t lives in the caller's structure (e.g. a
+ * session), so there's no allocation.
+ *
+ * Expired timers are delivered in batches: once per tick that has any, the
+ * expiry callback is called and takes them with #TimerWheel_PopExpired. A
+ * timer stopped or restarted in the callback leaves the batch.
+ *
+ * As with #ringbuff_t, it does NOT turn off interruptions: call
+ * #TimerWheel_Tick from the main loop with the ticks counted by the ISR.
+ *
+ ******************************************************************************/
+
+#ifndef INCLUDES_COMMON_TIMER_WHEEL_H_
+#define INCLUDES_COMMON_TIMER_WHEEL_H_
+
+#include "api_config.h"
+
+/**
+ * @addtogroup COMMON_GROUP
+ * @{
+ */
+
+#define TWHEEL_SLOT_BITS    ( 6 )
+#define TWHEEL_SLOTS        ( 1UL << TWHEEL_SLOT_BITS )    ///< Slots per level
+
+/** Levels needed to cover 32-bit expiries */
+#define TWHEEL_LEVELS_MAX   ( (32 + TWHEEL_SLOT_BITS - 1) / TWHEEL_SLOT_BITS )
+
+/** Size of the slots buffer for a number of levels (bytes) */
+#define TWHEEL_BUFF_SZ( __levels )  ( (__levels) * TWHEEL_SLOTS * sizeof(void*) )
+
+/**
+ * Timer
+ */
+typedef struct twheel_tmr_s
+{
+    struct twheel_tmr_s *next;      ///< Next timer in the slot
+    struct twheel_tmr_s **pprev;    ///< Link pointing to this timer, #NULL when not running
+    uint32_t expires;               ///< Expiry tick
+    void *ctx;                      ///< User context
+}twheel_tmr_t;
+
+struct twheel_s;
+
+/**
+ * Expiry callback. Called once per tick with expired timers, which it takes
+ * with #TimerWheel_PopExpired. Those not taken are discarded on return.
+ *
+ * @param[in,out]   pW          : Pointer to the structure #twheel_t
+ * @param[in]       pN          : Number of timers expired in this tick
+ * @param[in]       pCtx        : Callback context
+ */
+typedef void (*twheel_expire_t)(struct twheel_s *pW, uint32_t pN, void *pCtx);
+
+/**
+ * Timer wheel structure
+ */
+typedef struct twheel_s
+{
+    twheel_tmr_t **slot;        ///< Slot list heads, level by level
+    twheel_tmr_t *expired;      ///< Batch being delivered
+    twheel_expire_t cb;         ///< Expiry callback
+    void *cbCtx;                ///< Expiry callback context
+    uint32_t now;               ///< Next tick to process
+    uint32_t used;              ///< Number of running timers
+    uint8_t levels;             ///< Number of levels
+    bool_t init;                ///< flag indicating initialized
+}twheel_t;
+
+/**
+ * Initializes the structure
+ *
+ * @param[in,out]   pW          : Pointer to the structure #twheel_t
+ * @param[in]       pBuff       : Pointer to a RAM location, for the slots
+ * @param[in]       pSz         : Size of RAM location. See #TWHEEL_BUFF_SZ
+ * @param[in]       pCb         : Expiry callback
+ * @param[in]       pCtx        : Expiry callback context
+ *
+ * @return The number of levels, or 0 on failure
+ */
+uint32_t TimerWheel_Init(twheel_t *pW, void * const pBuff, uint32_t pSz, twheel_expire_t pCb, void *pCtx);
+
+/**
+ * Initializes a timer, not running
+ *
+ * @param[in,out]   pTmr        : Pointer to the structure #twheel_tmr_t
+ * @param[in]       pCtx        : User context
+ */
+void TimerWheel_TmrInit(twheel_tmr_t *pTmr, void *pCtx);
+
+/**
+ * Starts a timer, or restarts it if running. O(1).
+ *
+ * @param[in,out]   pW          : Pointer to the structure #twheel_t
+ * @param[in,out]   pTmr        : Pointer to an initialized #twheel_tmr_t
+ * @param[in]       pTicks      : Expires on this tick from now: 1 is the next #TimerWheel_Tick. 0 is taken as 1.
+ *
+ * @return #RES_SUCCESS, or #RES_ERROR on bad parameters
+ */
+res_t TimerWheel_Start(twheel_t *pW, twheel_tmr_t *pTmr, uint32_t pTicks);
+
+/**
+ * Stops a timer. O(1).
+ *
+ * @param[in,out]   pW          : Pointer to the structure #twheel_t
+ * @param[in,out]   pTmr        : Pointer to an initialized #twheel_tmr_t
+ *
+ * @return 1 if it was running, 0 otherwise
+ */
+uint32_t TimerWheel_Stop(twheel_t *pW, twheel_tmr_t *pTmr);
+
+/**
+ * Checks if a timer is running
+ *
+ * @param[in]       pTmr        : Pointer to an initialized #twheel_tmr_t
+ *
+ * @return #true if running
+ */
+bool_t TimerWheel_IsRunning(const twheel_tmr_t *pTmr);
+
+/**
+ * Advances the wheel, calling the expiry callback on each tick with expired timers
+ *
+ * @param[in,out]   pW          : Pointer to the structure #twheel_t
+ * @param[in]       pTicks      : Number of ticks elapsed
+ *
+ * @return number of timers expired
+ */
+uint32_t TimerWheel_Tick(twheel_t *pW, uint32_t pTicks);
+
+/**
+ * Takes the next expired timer of the batch. Only valid in the expiry callback.
+ *
+ * @param[in,out]   pW          : Pointer to the structure #twheel_t
+ *
+ * @return pointer to the timer, not running anymore, or #NULL when the batch is over
+ */
+twheel_tmr_t *TimerWheel_PopExpired(twheel_t *pW);
+
+/**
+ * Gets number of running timers
+ *
+ * @param[in,out]   pW          : Pointer to the structure #twheel_t
+ *
+ * @return number of running timers
+ */
+uint32_t TimerWheel_Used(twheel_t *pW);
+
+/**
+ * @}
+ */
+
+#endif /* INCLUDES_COMMON_TIMER_WHEEL_H_ */
@@ -0,0 +1,200 @@
+/**************************************************************************//**
+ * @file     trace.h
+ * @brief    Functions prototypes for a binary event trace buffer.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * Each event is a fixed-size record (timestamp, event ID and two arguments)
+ * written to an overwrite-mode #ringbuff_t: the buffer always holds the most
+ * recent events. A record is built on the stack and stored by the inline ring
+ * core with a constant element size, so #TRACE costs a timestamp read, a
+ * 16-byte copy and an index update.
+ *
+ * Events are grouped in 32 classes. TRACE_ENABLE_MASK has one bit per class,
+ * and #TRACE on a disabled class compiles to nothing.
+ *
+ * The timestamp is TRACE_TIMESTAMP(), by default the function given to
+ * #Trace_Init. Define it to a cycle counter read to save the call, e.g. on
+ * Cortex-M3/M4 with the DWT enabled:
+ *
+ *     #define TRACE_TIMESTAMP()   ( *(volatile uint32_t *)0xE0001004UL )
+ *
+ * Events may come from interruptions: define TRACE_LOCK() / TRACE_UNLOCK() to
+ * protect the record write. By default they are empty.
+ *
+ * The buffer is taken out with #Trace_Snapshot, oldest first, and converted on
+ * the host to Chrome trace JSON by tools/trace2json.
+ *
+ ******************************************************************************/
+
+#ifndef INCLUDES_COMMON_TRACE_H_
+#define INCLUDES_COMMON_TRACE_H_
+
+#include "api_config.h"
+#include "common/ring_buffer.h"
+
+/**
+ * @addtogroup COMMON_GROUP
+ * @{
+ */
+
+/** Enabled event classes: bit N enables class N */
+#if !defined(TRACE_ENABLE_MASK)
+#define TRACE_ENABLE_MASK   ( 0xFFFFFFFFUL )
+#endif
+
+#if !defined(TRACE_LOCK)
+#define TRACE_LOCK()
+#define TRACE_UNLOCK()
+#endif
+
+#if !defined(TRACE_TIMESTAMP)
+#define TRACE_TIMESTAMP()   ( _trace.ts() )
+#define TRACE_TIMESTAMP_CB
+#endif
+
+/**
+ * Event kinds, as shown by the trace viewer
+ */
+#define TRACE_KIND_INSTANT  ( 0 )   ///< Point in time. a0 and a1 are shown as arguments
+#define TRACE_KIND_BEGIN    ( 1 )   ///< Start of a slice on track a0. a1 is shown as argument
+#define TRACE_KIND_END      ( 2 )   ///< End of the slice on track a0
+#define TRACE_KIND_COUNTER  ( 3 )   ///< Counter value a0 (e.g. a queue depth), series a1
+
+/**
+ * Event ID constructor: kind (2 bits), class (5 bits) and number (8 bits)
+ */
+#define TRACE_ID( __kind, __class, __num )  ( (uint16_t)( ((__kind) << 14) | ((__class) << 8) | (__num) ) )
+
+#define TRACE_ID_KIND( __id )   ( ((__id) >> 14) & 0x03 )
+#define TRACE_ID_CLASS( __id )  ( ((__id) >> 8) & 0x1F )
+#define TRACE_ID_NUM( __id )    ( (__id) & 0xFF )
+
+/**
+ * Event classes used by this API. Application classes start at #TRACE_CLASS_USER.
+ */
+#define TRACE_CLASS_RINGBUFF    ( 1 )
+#define TRACE_CLASS_USER        ( 8 )
+
+/**
+ * Ring buffer events (RINGBUFF_TRACE_ENABLE). a0 is the #ringbuff_t address, a1
+ * the number of elements.
+ */
+#define TRACE_EV_RB_WR          TRACE_ID( TRACE_KIND_INSTANT, TRACE_CLASS_RINGBUFF, 0 ) ///< Elements written
+#define TRACE_EV_RB_RD          TRACE_ID( TRACE_KIND_INSTANT, TRACE_CLASS_RINGBUFF, 1 ) ///< Elements read or discarded
+#define TRACE_EV_RB_OVERWRITE   TRACE_ID( TRACE_KIND_INSTANT, TRACE_CLASS_RINGBUFF, 2 ) ///< Oldest elements lost to an overwrite
+#define TRACE_EV_RB_REJECT      TRACE_ID( TRACE_KIND_INSTANT, TRACE_CLASS_RINGBUFF, 3 ) ///< Elements not written: buffer full
+
+/**
+ * Trace record. Little-endian in the dump, as stored by the MCU.
+ */
+typedef struct
+{
+    uint32_t ts;        ///< Timestamp (TRACE_TIMESTAMP() ticks)
+    uint16_t id;        ///< Event ID (#TRACE_ID)
+    uint16_t rsvd;      ///< Reserved, 0
+    uint32_t a0;        ///< First argument
+    uint32_t a1;        ///< Second argument
+}trace_rec_t;
+
+STATIC_ASSERT( sizeof(trace_rec_t) == 16, trace_rec_must_be_16_bytes );
+
+/**
+ * Timestamp source
+ */
+typedef uint32_t (*trace_ts_t)(void);
+
+/**
+ * Trace buffer structure. There's a single one, #_trace.
+ */
+typedef struct
+{
+    ringbuff_t rb;      ///< Records
+    trace_ts_t ts;      ///< Timestamp source, when TRACE_TIMESTAMP() is not defined
+}trace_t;
+
+/** The trace buffer. Use the functions below. */
+extern trace_t _trace;
+
+/**
+ * Initializes the trace buffer
+ *
+ * @param[out]      pBuff       : Pointer to a RAM location
+ * @param[in]       pSz         : Size of RAM location
+ * @param[in]       pTs         : Timestamp source. May be #NULL when TRACE_TIMESTAMP() is defined.
+ *
+ * @return The number of records the buffer holds, or 0 on failure
+ */
+uint32_t Trace_Init(void *pBuff, uint32_t pSz, trace_ts_t pTs);
+
+/**
+ * Writes a record, overwriting the oldest one when full. Prefer #TRACE, which
+ * honors TRACE_ENABLE_MASK.
+ *
+ * @param[in]       pId         : Event ID (#TRACE_ID)
+ * @param[in]       pA0         : First argument
+ * @param[in]       pA1         : Second argument
+ */
+static INLINE void Trace_Rec(uint16_t pId, uint32_t pA0, uint32_t pA1)
+{
+    trace_rec_t rec;
+
+    if( !_trace.rb.init )
+    {
+        return;
+    }
+
+    rec.id = pId;
+    rec.rsvd = 0;
+    rec.a0 = pA0;
+    rec.a1 = pA1;
+
+    TRACE_LOCK();
+    rec.ts = TRACE_TIMESTAMP();
+#if defined(RINGBUFF_FREE_RUNNING)
+    _ringbuff_wrOneK( &_trace.rb, &rec, true, _trace.rb.sz, sizeof(trace_rec_t), _trace.rb.mask );
+#else
+    _ringbuff_wrOneK( &_trace.rb, &rec, true, _trace.rb.sz, sizeof(trace_rec_t), 0 );
+#endif
+    TRACE_UNLOCK();
+}
+
+/**
+ * Writes a record if the event class is enabled in TRACE_ENABLE_MASK
+ */
+#define TRACE( __id, __a0, __a1 )                                               \
+    do                                                                          \
+    {                                                                           \
+        if( (TRACE_ENABLE_MASK >> TRACE_ID_CLASS( __id )) & 1 )                 \
+        {                                                                       \
+            Trace_Rec( (__id), (uint32_t)(__a0), (uint32_t)(__a1) );            \
+        }                                                                       \
+    } while(0)
+
+/**
+ * Copies the newest records, oldest first, without removing them
+ *
+ * @param[out]      pDst        : Pointer to a #trace_rec_t vector
+ * @param[in]       pN          : Number of records that fit in pDst
+ *
+ * @return number of records copied
+ */
+uint32_t Trace_Snapshot(trace_rec_t *pDst, uint32_t pN);
+
+/**
+ * Removes all the records
+ */
+void Trace_Clear(void);
+
+/**
+ * Gets number of records in the buffer
+ *
+ * @return number of records stored
+ */
+uint32_t Trace_Used(void);
+
+/**
+ * @}
+ */
+
+#endif /* INCLUDES_COMMON_TRACE_H_ */
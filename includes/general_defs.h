@@ -45,6 +45,46 @@
 /** Try for equal strings */
 #define STR_ISEQUAL( __ptr, __ptr2 ) ( strcmp(__ptr, __ptr2) == 0 )
 
+/** Size of a data cache line (bytes). Architecture headers should define it */
+#if !defined(ARCH_CACHE_LINE_SZ)
+#define ARCH_CACHE_LINE_SZ  ( 64 )
+#endif
+
+/** Aligns a type or an object (bytes) */
+#if !defined(ATTR_ALIGNED)
+#define ATTR_ALIGNED( __n )     __attribute__(( aligned( __n ) ))
+#endif
+
+/** Places an object in RAM that is not cleared at startup. Architecture
+ * headers define it when the linker script has such a section */
+#if !defined(ATTR_NOINIT)
+#define ATTR_NOINIT
+#endif
+
+/** Count leading zeros of a non-zero 32-bit word. Architecture headers may
+ * define it to an intrinsic */
+#if !defined(ARCH_CLZ32)
+#define ARCH_CLZ32( __x )       ( (uint32_t)__builtin_clz( (uint32_t)(__x) ) )
+#endif
+
+/** Atomic OR and AND on a 32-bit word, with the memory order __order. Architecture
+ * headers of cores without exclusive accesses define them with a critical section */
+#if !defined(ARCH_ATOMIC_OR32)
+#define ARCH_ATOMIC_OR32( __ptr, __mask, __order )  ( (void)__atomic_fetch_or( (__ptr), (__mask), (__order) ) )
+#endif
+#if !defined(ARCH_ATOMIC_AND32)
+#define ARCH_ATOMIC_AND32( __ptr, __mask, __order ) ( (void)__atomic_fetch_and( (__ptr), (__mask), (__order) ) )
+#endif
+
+/** Compile-time assertion. __msg must be a valid identifier, unique in the scope */
+#if !defined(STATIC_ASSERT)
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define STATIC_ASSERT( __cond, __msg )  _Static_assert( (__cond), #__msg )
+#else
+#define STATIC_ASSERT( __cond, __msg )  typedef char static_assert_##__msg[ (__cond) ? 1 : -1 ]
+#endif
+#endif
+
 /** Bitfield Value Mask constructor */
 #define BF_MASK(n, __val) ((__val) << (n))
 /** Bitfield Bit set mask constructor */
@@ -0,0 +1,271 @@
+
+#include "common/bitstream.h"
+
+
+#define BITSTREAM_MASK(__bits)  ( ((uint64_t)1 << (__bits)) - 1 )
+
+static void _bitstream_init( bitstream_t *pBs, uint8_t *pBuff, uint32_t pSz, ringbuff_t *pRb )
+{
+    pBs->acc = 0;
+    pBs->nBits = 0;
+    pBs->buf = pBuff;
+    pBs->rb = pRb;
+    pBs->pos = 0;
+    pBs->room = pSz;
+    pBs->total = 0;
+    pBs->init = (pBuff != NULL) || ((pRb != NULL) && (RingBuff_Sz( pRb ) > 0) && (pRb->eSz == 1));
+}
+
+/*
+ * Moves N bytes (up to 4) from the accumulator to the buffer. The room was
+ * checked when the bits were accepted.
+ */
+static void _bitstream_put( bitstream_t *pBs, uint8_t pN )
+{
+    uint8_t word[4];
+    uint8_t *ptr = (pBs->rb == NULL) ? &pBs->buf[pBs->pos] : word;
+    uint8_t ii;
+
+    for( ii = 0; ii < pN; ii++ )
+    {
+        ptr[ii] = (uint8_t)( pBs->acc >> (8 * ii) );
+    }
+
+    if( pBs->rb == NULL )
+    {
+        pBs->pos += pN;
+    }
+    else
+    {
+        RingBuff_WrMany( pBs->rb, word, pN, false );
+    }
+
+    pBs->room -= pN;
+    pBs->acc >>= 8 * pN;
+    pBs->nBits -= 8 * pN;
+}
+
+/*
+ * Moves bytes from the buffer to the accumulator: a whole word when there's
+ * one, otherwise the bytes left.
+ */
+static void _bitstream_fill( bitstream_t *pBs )
+{
+    uint8_t word[4];
+    const uint8_t *ptr;
+
+    if( (pBs->rb != NULL) && (pBs->room < 4) )
+    {
+        pBs->room = RingBuff_Used( pBs->rb );
+    }
+
+    if( (pBs->nBits <= 32) && (pBs->room >= 4) )
+    {
+        if( pBs->rb == NULL )
+        {
+            ptr = &pBs->buf[pBs->pos];
+            pBs->pos += 4;
+        }
+        else
+        {
+            RingBuff_RdMany( pBs->rb, word, 4 );
+            ptr = word;
+        }
+        pBs->acc |= (uint64_t)( (uint32_t)ptr[0] | ((uint32_t)ptr[1] << 8) |
+                                ((uint32_t)ptr[2] << 16) | ((uint32_t)ptr[3] << 24) ) << pBs->nBits;
+        pBs->nBits += 32;
+        pBs->room -= 4;
+        return;
+    }
+
+    while( (pBs->nBits <= 56) && (pBs->room > 0) )
+    {
+        if( pBs->rb == NULL )
+        {
+            word[0] = pBs->buf[pBs->pos++];
+        }
+        else
+        {
+            RingBuff_RdOne( pBs->rb, word );
+        }
+        pBs->acc |= (uint64_t)word[0] << pBs->nBits;
+        pBs->nBits += 8;
+        pBs->room--;
+    }
+}
+
+
+void BitStream_WrInit(bitstream_t *pBs, void *pBuff, uint32_t pSz)
+{
+    if( pBs == NULL )
+    {
+        return;
+    }
+
+    _bitstream_init( pBs, pBuff, pSz, NULL );
+}
+
+void BitStream_WrInitRing(bitstream_t *pBs, ringbuff_t *pRb)
+{
+    if( pBs == NULL )
+    {
+        return;
+    }
+
+    _bitstream_init( pBs, NULL, (pRb != NULL) ? RingBuff_Free( pRb ) : 0, pRb );
+}
+
+void BitStream_RdInit(bitstream_t *pBs, const void *pBuff, uint32_t pSz)
+{
+    if( pBs == NULL )
+    {
+        return;
+    }
+
+    //o leitor nunca escreve no buffer
+    _bitstream_init( pBs, (uint8_t *)pBuff, pSz, NULL );
+}
+
+void BitStream_RdInitRing(bitstream_t *pBs, ringbuff_t *pRb)
+{
+    if( pBs == NULL )
+    {
+        return;
+    }
+
+    _bitstream_init( pBs, NULL, (pRb != NULL) ? RingBuff_Used( pRb ) : 0, pRb );
+}
+
+uint32_t BitStream_Wr(bitstream_t *pBs, uint32_t pVal, uint8_t pBits)
+{
+    uint32_t need;
+
+    if( pBs == NULL )
+    {
+        return 0;
+    }
+    if( !pBs->init )
+    {
+        return 0;
+    }
+    if( (pBits == 0) || (pBits > 32) )
+    {
+        return 0;
+    }
+
+    //todos os bits pendentes precisam caber, mesmo que só sejam escritos depois
+    need = (pBs->nBits + pBits + 7) / 8;
+    if( need > pBs->room )
+    {
+        if( pBs->rb != NULL )
+        {
+            pBs->room = RingBuff_Free( pBs->rb );
+        }
+        if( need > pBs->room )
+        {
+            return 0;
+        }
+    }
+
+    pBs->acc |= ((uint64_t)pVal & BITSTREAM_MASK(pBits)) << pBs->nBits;
+    pBs->nBits += pBits;
+    pBs->total += pBits;
+
+    if( pBs->nBits >= 32 )
+    {
+        _bitstream_put( pBs, 4 );
+    }
+
+    return pBits;
+}
+
+uint32_t BitStream_Flush(bitstream_t *pBs)
+{
+    uint8_t n;
+
+    if( pBs == NULL )
+    {
+        return 0;
+    }
+    if( !pBs->init )
+    {
+        return 0;
+    }
+
+    n = (pBs->nBits + 7) / 8;
+    if( n == 0 )
+    {
+        return 0;
+    }
+
+    pBs->total += 8 * n - pBs->nBits;
+    pBs->nBits = 8 * n;
+    _bitstream_put( pBs, n );
+    pBs->acc = 0;
+
+    return n;
+}
+
+uint32_t BitStream_Rd(bitstream_t *pBs, uint32_t *pVal, uint8_t pBits)
+{
+    if( pBs == NULL )
+    {
+        return 0;
+    }
+    if( !pBs->init )
+    {
+        return 0;
+    }
+    if( (pBits == 0) || (pBits > 32) )
+    {
+        return 0;
+    }
+
+    if( pBs->nBits < pBits )
+    {
+        _bitstream_fill( pBs );
+        if( pBs->nBits < pBits )
+        {
+            return 0;
+        }
+    }
+
+    if( pVal != NULL )
+    {
+        *pVal = (uint32_t)( pBs->acc & BITSTREAM_MASK(pBits) );
+    }
+    pBs->acc >>= pBits;
+    pBs->nBits -= pBits;
+    pBs->total += pBits;
+
+    return pBits;
+}
+
+uint32_t BitStream_RdAlign(bitstream_t *pBs)
+{
+    uint8_t skip;
+
+    if( pBs == NULL )
+    {
+        return 0;
+    }
+
+    //o resto do byte atual já está no acumulador
+    skip = (8 - (pBs->total % 8)) % 8;
+    if( skip == 0 )
+    {
+        return 0;
+    }
+
+    return BitStream_Rd( pBs, NULL, skip );
+}
+
+uint32_t BitStream_Bits(bitstream_t *pBs)
+{
+    if( pBs == NULL )
+    {
+        return 0;
+    }
+
+    return pBs->total;
+}
@@ -1,4 +1,5 @@
 #include "common/conv.h"
+#include <string.h>
 #include <strings.h>
 
  //Maximun size of a string containing a 32 bit number without signal
@@ -44,3 +45,242 @@ res_t Conv_IntToStr( int32_t pVal, char_t *pStrTo, uint8_t pStrMaxLen )
         return RES_SUCCESS;
     }
 }
+
+/*
+ * Output of the array conversions: a string, or the 2 segments of a ring
+ * buffer reservation
+ */
+typedef struct
+{
+    char_t *seg[2];
+    uint32_t n0;    //chars no primeiro segmento
+}_conv_out_t;
+
+static INLINE void _conv_put( _conv_out_t *pOut, uint32_t pPos, char_t pC )
+{
+    if( pPos < pOut->n0 )
+    {
+        pOut->seg[0][pPos] = pC;
+    }
+    else
+    {
+        pOut->seg[1][pPos - pOut->n0] = pC;
+    }
+}
+
+/*
+ * Number of decimal digits. floor(log10) is estimated from the bit length
+ * (1233/4096 ~ log10(2)) and corrected by a single compare.
+ */
+static uint32_t _conv_digits( uint32_t pVal )
+{
+    static const uint32_t pow10[] = { 1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL,
+            1000000UL, 10000000UL, 100000000UL, 1000000000UL };
+    uint32_t d;
+
+    //0 conta como 1. As potências acima de 1 são pares: o resultado não muda
+    pVal |= 1;
+    d = ( (32 - ARCH_CLZ32( pVal )) * 1233 ) >> 12;
+
+    return d + 1 - ( pVal < pow10[d] );
+}
+
+/*
+ * Magnitude of a value of the array
+ */
+static uint32_t _conv_mag( const void *pVals, uint32_t pIdx, bool_t pSigned, bool_t *pNeg )
+{
+    int32_t val;
+
+    if( !pSigned )
+    {
+        *pNeg = false;
+        return ((const uint32_t *)pVals)[pIdx];
+    }
+
+    val = ((const int32_t *)pVals)[pIdx];
+    *pNeg = (bool_t)( val < 0 );
+
+    //sem overflow para INT32_MIN
+    return *pNeg ? ( 0UL - (uint32_t)val ) : (uint32_t)val;
+}
+
+static uint32_t _conv_arrLen( const void *pVals, bool_t pSigned, uint32_t pN, const conv_arrfmt_t *pFmt )
+{
+    bool_t json = (bool_t)( pFmt->fmt == CONV_ARR_JSON );
+    uint32_t len = json ? 2 : 0;
+    uint32_t mag;
+    uint32_t ii;
+    bool_t neg;
+
+    for(ii=0; ii < pN; ii++)
+    {
+        mag = _conv_mag( pVals, ii, pSigned, &neg );
+        len += neg + _conv_digits( mag );
+        if( ii > 0 )
+        {
+            len++;
+        }
+        if( pFmt->keys != NULL )
+        {
+            //"k": ou k=
+            len += strlen( pFmt->keys[ii] ) + ( json ? 3 : 1 );
+        }
+    }
+
+    return len;
+}
+
+static void _conv_arrWr( _conv_out_t *pOut, const void *pVals, bool_t pSigned, uint32_t pN, const conv_arrfmt_t *pFmt )
+{
+    bool_t json = (bool_t)( pFmt->fmt == CONV_ARR_JSON );
+    const char_t *key;
+    uint32_t pos = 0;
+    uint32_t end;
+    uint32_t mag;
+    uint32_t ii;
+    bool_t neg;
+
+    if( json )
+    {
+        _conv_put( pOut, pos++, (pFmt->keys != NULL) ? '{' : '[' );
+    }
+
+    for(ii=0; ii < pN; ii++)
+    {
+        if( ii > 0 )
+        {
+            _conv_put( pOut, pos++, json ? ',' : pFmt->sep );
+        }
+
+        if( pFmt->keys != NULL )
+        {
+            if( json )
+            {
+                _conv_put( pOut, pos++, '"' );
+            }
+            for(key = pFmt->keys[ii]; *key != 0; key++)
+            {
+                _conv_put( pOut, pos++, *key );
+            }
+            if( json )
+            {
+                _conv_put( pOut, pos++, '"' );
+            }
+            _conv_put( pOut, pos++, json ? ':' : '=' );
+        }
+
+        mag = _conv_mag( pVals, ii, pSigned, &neg );
+        if( neg )
+        {
+            _conv_put( pOut, pos++, '-' );
+        }
+
+        //da direita para a esquerda, já no lugar
+        pos += _conv_digits( mag );
+        end = pos;
+        do
+        {
+            _conv_put( pOut, --end, (char_t)( mag % 10 + '0' ) );
+        }while( mag /= 10 );
+    }
+
+    if( json )
+    {
+        _conv_put( pOut, pos, (pFmt->keys != NULL) ? '}' : ']' );
+    }
+}
+
+static const conv_arrfmt_t _conv_csv = { NULL, ',', CONV_ARR_CSV };
+
+static res_t _conv_arrToStr( const void *pVals, bool_t pSigned, uint32_t pN, const conv_arrfmt_t *pFmt, char_t *pStrTo, uint32_t pStrMaxLen, uint32_t *pLen )
+{
+    _conv_out_t out;
+    uint32_t len;
+
+    if( ((pVals == NULL) && (pN > 0)) || (pStrTo == NULL) )
+    {
+        return RES_ERROR;
+    }
+    if( pFmt == NULL )
+    {
+        pFmt = &_conv_csv;
+    }
+
+    len = _conv_arrLen( pVals, pSigned, pN, pFmt );
+    if( len > pStrMaxLen )
+    {
+        return RES_ERR_OVERFLOW;
+    }
+
+    out.seg[0] = out.seg[1] = pStrTo;
+    out.n0 = len;
+    _conv_arrWr( &out, pVals, pSigned, pN, pFmt );
+    pStrTo[len] = 0;
+
+    if( pLen != NULL )
+    {
+        *pLen = len;
+    }
+
+    return RES_SUCCESS;
+}
+
+static res_t _conv_arrToRing( ringbuff_t *pRb, const void *pVals, bool_t pSigned, uint32_t pN, const conv_arrfmt_t *pFmt, uint32_t *pLen )
+{
+    ringbuff_vec_t segs[2];
+    _conv_out_t out;
+    uint32_t len;
+
+    if( (pRb == NULL) || ((pVals == NULL) && (pN > 0)) )
+    {
+        return RES_ERROR;
+    }
+    if( pRb->eSz != 1 )
+    {
+        return RES_ERR_SZ;
+    }
+    if( pFmt == NULL )
+    {
+        pFmt = &_conv_csv;
+    }
+
+    len = _conv_arrLen( pVals, pSigned, pN, pFmt );
+    if( RingBuff_WrReserve( pRb, len, segs ) < len )
+    {
+        return RES_ERR_OVERFLOW;
+    }
+
+    out.seg[0] = segs[0].ptr;
+    out.seg[1] = segs[1].ptr;
+    out.n0 = segs[0].n;
+    _conv_arrWr( &out, pVals, pSigned, pN, pFmt );
+    RingBuff_WrCommit( pRb, len );
+
+    if( pLen != NULL )
+    {
+        *pLen = len;
+    }
+
+    return RES_SUCCESS;
+}
+
+res_t Conv_IntArrToStr( const int32_t *pVals, uint32_t pN, const conv_arrfmt_t *pFmt, char_t *pStrTo, uint32_t pStrMaxLen, uint32_t *pLen )
+{
+    return _conv_arrToStr( pVals, true, pN, pFmt, pStrTo, pStrMaxLen, pLen );
+}
+
+res_t Conv_UIntArrToStr( const uint32_t *pVals, uint32_t pN, const conv_arrfmt_t *pFmt, char_t *pStrTo, uint32_t pStrMaxLen, uint32_t *pLen )
+{
+    return _conv_arrToStr( pVals, false, pN, pFmt, pStrTo, pStrMaxLen, pLen );
+}
+
+res_t Conv_IntArrToRing( ringbuff_t *pRb, const int32_t *pVals, uint32_t pN, const conv_arrfmt_t *pFmt, uint32_t *pLen )
+{
+    return _conv_arrToRing( pRb, pVals, true, pN, pFmt, pLen );
+}
+
+res_t Conv_UIntArrToRing( ringbuff_t *pRb, const uint32_t *pVals, uint32_t pN, const conv_arrfmt_t *pFmt, uint32_t *pLen )
+{
+    return _conv_arrToRing( pRb, pVals, false, pN, pFmt, pLen );
+}
@@ -1,6 +1,35 @@
 
+#include <string.h>
 #include "common/entropy_pool.h"
 
+#if defined(ENTROPYPOOL_FREE_RUNNING)
+
+#define EPOOL_OFF(__pool, __id)     ( (__id) & (__pool)->buff.mask )
+
+static INLINE uint32_t _epool_used(entropy_pool_t *pPool)
+{
+    return pPool->buff.tail - pPool->buff.head;
+}
+
+static INLINE void _epool_advHead(entropy_pool_t *pPool, uint32_t pSz)
+{
+    pPool->buff.head += pSz;
+}
+
+static INLINE void _epool_advTail(entropy_pool_t *pPool)
+{
+    if( _epool_used(pPool) == pPool->buff.sz )
+    {
+        //sobrescreve o início do buffer
+        pPool->buff.head++;
+    }
+    pPool->buff.tail++;
+}
+
+#else
+
+#define EPOOL_OFF(__pool, __id)     ( __id )
+
 static uint32_t _epool_updateIndex(uint32_t pId, uint32_t pSzUpdate, uint32_t pSzMax)
 {
     pId += pSzUpdate;
@@ -13,6 +42,46 @@ static uint32_t _epool_updateIndex(uint32_t pId, uint32_t pSzUpdate, uint32_t pS
     return pId;
 }
 
+static INLINE uint32_t _epool_used(entropy_pool_t *pPool)
+{
+    if( (pPool->buff.head == pPool->buff.tail) && !(pPool->full) )
+    {
+        return 0;
+    }
+    else if(pPool->buff.tail > pPool->buff.head)
+    {
+        return (pPool->buff.tail - pPool->buff.head);
+    }
+    else
+    {
+        return (pPool->buff.sz - (pPool->buff.head - pPool->buff.tail));
+    }
+}
+
+static INLINE void _epool_advHead(entropy_pool_t *pPool, uint32_t pSz)
+{
+    if( pSz > 0 )
+    {
+        pPool->buff.head = _epool_updateIndex(pPool->buff.head, pSz, pPool->buff.sz);
+        pPool->full = 0;
+    }
+}
+
+static INLINE void _epool_advTail(entropy_pool_t *pPool)
+{
+    if( pPool->full )
+    {
+        //sobrescreve o início do buffer
+        pPool->buff.head = _epool_updateIndex(pPool->buff.head, 1, pPool->buff.sz);
+    }
+    //incrementa o ponteiro
+    pPool->buff.tail = _epool_updateIndex(pPool->buff.tail, 1, pPool->buff.sz);
+    //verifica se encheu
+    pPool->full = pPool->buff.tail == pPool->buff.head;
+}
+
+#endif /* ENTROPYPOOL_FREE_RUNNING */
+
 uint32_t EntropyPool_Init(entropy_pool_t *pPool, void * const pBuff, uint32_t pSz)
 {
     if( pPool == NULL )
@@ -28,8 +97,17 @@ uint32_t EntropyPool_Init(entropy_pool_t *pPool, void * const pBuff, uint32_t pS
         return 0;
     }
     pPool->buff.d = pBuff;
+#if defined(ENTROPYPOOL_FREE_RUNNING)
+    //os indices correm livres: o tamanho precisa ser potencia de 2
+    while( pSz & (pSz - 1) )
+    {
+        pSz &= (pSz - 1);
+    }
+    pPool->buff.mask = pSz - 1;
+#endif
     pPool->buff.sz = pSz;
     pPool->buff.head = pPool->buff.tail = pPool->full = pPool->entropy_cur = 0;
+    pPool->rd.acc = pPool->rd.n = 0;
     pPool->f = ePoolInitialized;
     return pPool->buff.sz * 8;
 }
@@ -49,7 +127,7 @@ uint32_t EntropyPool_Store32(entropy_pool_t *pPool, uint32_t pWord, uint8_t pBit
         return 0;
     }
 
-    pBits %= (sizeof(pWord)*8);   //maximo e 32 bits
+    pBits = MIN( pBits, (uint8_t)(sizeof(pWord)*8) );   //maximo e 32 bits
     entropy = (uint8_t)pBits;
 
     while( pBits-- )
@@ -57,22 +135,14 @@ uint32_t EntropyPool_Store32(entropy_pool_t *pPool, uint32_t pWord, uint8_t pBit
         pool = pPool->buff.d;
         posBit = pPool->entropy_cur % 8;
 
-        pool[pPool->buff.tail] ^= (pWord & 1) << posBit;
+        pool[EPOOL_OFF(pPool, pPool->buff.tail)] ^= (pWord & 1) << posBit;
 
         pWord >>= 1;
         pPool->entropy_cur += 1;
 
         if( (pPool->entropy_cur % 8) == 0 )
         {
-            if( pPool->full )
-            {
-                //sobrescreve o início do buffer
-                pPool->buff.head = _epool_updateIndex(pPool->buff.head, 1, pPool->buff.sz);
-            }
-            //incrementa o ponteiro
-            pPool->buff.tail = _epool_updateIndex(pPool->buff.tail, 1, pPool->buff.sz);
-            //verifica se encheu
-            pPool->full = pPool->buff.tail == pPool->buff.head;
+            _epool_advTail(pPool);
         }
     }
 
@@ -81,7 +151,12 @@ uint32_t EntropyPool_Store32(entropy_pool_t *pPool, uint32_t pWord, uint8_t pBit
 
 uint32_t EntropyPool_Bits(entropy_pool_t *pPool)
 {
-    return EntropyPool_Used(pPool) * 8;
+    if( pPool == NULL )
+    {
+        return 0;
+    }
+
+    return EntropyPool_Used(pPool) * 8 + pPool->rd.n;
 }
 
 uint32_t EntropyPool_BitsMax(entropy_pool_t *pPool)
@@ -102,10 +177,9 @@ uint32_t EntropyPool_RdOnePtr(entropy_pool_t *pPool, void **pEl)
         return 0;
     }
 
-    ptr = &((uint8_t*)pPool->buff.d)[pPool->buff.head];
+    ptr = &((uint8_t*)pPool->buff.d)[EPOOL_OFF(pPool, pPool->buff.head)];
 
-    pPool->buff.head = _epool_updateIndex(pPool->buff.head, 1, pPool->buff.sz);
-    pPool->full = 0;
+    _epool_advHead(pPool, 1);
 
     if( pEl == NULL )
     {
@@ -118,6 +192,100 @@ uint32_t EntropyPool_RdOnePtr(entropy_pool_t *pPool, void **pEl)
     return 1;
 }
 
+uint32_t EntropyPool_RdBits(entropy_pool_t *pPool, uint32_t *pVal, uint8_t pBits)
+{
+    uint64_t acc;
+    uint32_t n;
+
+    if( (pPool == NULL) || (pVal == NULL) )
+    {
+        return 0;
+    }
+    if( (pBits == 0) || (pBits > 32) )
+    {
+        return 0;
+    }
+    if( EntropyPool_Bits(pPool) < pBits )
+    {
+        return 0;
+    }
+
+    //sobras do último byte nos LSBs, bytes novos acima delas
+    acc = pPool->rd.acc;
+    n = pPool->rd.n;
+    while( n < pBits )
+    {
+        acc |= (uint64_t)((uint8_t*)pPool->buff.d)[EPOOL_OFF(pPool, pPool->buff.head)] << n;
+        _epool_advHead(pPool, 1);
+        n += 8;
+    }
+
+    *pVal = (uint32_t)( acc & ( ((uint64_t)1 << pBits) - 1 ) );
+    pPool->rd.acc = (uint8_t)( acc >> pBits );
+    pPool->rd.n = (uint8_t)( n - pBits );
+
+    return pBits;
+}
+
+/*
+ * Values accepted by a k-bit Lemire draw over [0, pN): 2^k - (2^k mod pN)
+ */
+static uint64_t _epool_rangeAcc(uint32_t pN, uint8_t pK)
+{
+    uint64_t span = (uint64_t)1 << pK;
+
+    return span - ( span % pN );
+}
+
+uint32_t EntropyPool_RdRange(entropy_pool_t *pPool, uint32_t pN, uint32_t *pVal)
+{
+    uint64_t m;
+    uint64_t lim;
+    uint32_t x;
+    uint8_t k;
+    uint8_t kk;
+
+    if( (pPool == NULL) || (pVal == NULL) || (pN == 0) )
+    {
+        return 0;
+    }
+    if( pN == 1 )
+    {
+        *pVal = 0;
+        return 1;
+    }
+
+    //menor k com 2^k >= pN
+    k = (uint8_t)( 32 - ARCH_CLZ32( pN - 1 ) );
+
+    //custo esperado k * 2^k / aceitos(k). Mais bits rejeitam menos: testa
+    // alguns k acima e fica com o mais barato. Comparacao cruzada sem divisao,
+    // com kk - k <= 4 para não estourar 64 bits
+    for(kk = k + 1; (kk <= 32) && (kk <= k + 4); kk++)
+    {
+        if( (uint64_t)kk * ( (uint64_t)1 << (kk - k) ) * _epool_rangeAcc( pN, k ) <
+                (uint64_t)k * _epool_rangeAcc( pN, kk ) )
+        {
+            k = kk;
+        }
+    }
+
+    //limiar de rejeicao: 2^k mod pN
+    lim = ( (uint64_t)1 << k ) - _epool_rangeAcc( pN, k );
+    do
+    {
+        if( EntropyPool_RdBits( pPool, &x, k ) == 0 )
+        {
+            return 0;
+        }
+        m = (uint64_t)x * pN;
+    }while( ( m & ( ((uint64_t)1 << k) - 1 ) ) < lim );
+
+    *pVal = (uint32_t)( m >> k );
+
+    return 1;
+}
+
 uint32_t EntropyPool_RdOne(entropy_pool_t *pPool, void *pEl)
 {
     uint8_t *ptr;
@@ -131,10 +299,9 @@ uint32_t EntropyPool_RdOne(entropy_pool_t *pPool, void *pEl)
         return 0;
     }
 
-    ptr = &((uint8_t*)pPool->buff.d)[pPool->buff.head];
+    ptr = &((uint8_t*)pPool->buff.d)[EPOOL_OFF(pPool, pPool->buff.head)];
 
-    pPool->buff.head = _epool_updateIndex(pPool->buff.head, 1, pPool->buff.sz);
-    pPool->full = 0;
+    _epool_advHead(pPool, 1);
 
     if( pEl == NULL )
     {
@@ -149,8 +316,8 @@ uint32_t EntropyPool_RdOne(entropy_pool_t *pPool, void *pEl)
 
 uint32_t EntropyPool_RdMany(entropy_pool_t *pPool, void *pBuff, uint32_t pSz)
 {
-    uint32_t result;
-    uint8_t *ptr = pBuff;
+    uint8_t *ptr;
+    uint32_t off;
     uint32_t cpSz;
 
     if( pBuff == NULL )
@@ -168,46 +335,27 @@ uint32_t EntropyPool_RdMany(entropy_pool_t *pPool, void *pBuff, uint32_t pSz)
         return 0;
     }
 
-    result = pSz = MIN( pSz, EntropyPool_Used(pPool) );
+    pSz = MIN( pSz, EntropyPool_Used(pPool) );
 
     //segmenta em duas partes: ate o final do buffer e então do início ate o meio.
     // assim: h = head t = tail
     //
-    //  |=====t---------------------h=======| pega o tail ate o final
-    //  |h====t-----------------------------| pega o início ate o head
-    //  |----ht-----------------------------|
-
-    if( pPool->buff.head + (1 * pSz) > pPool->buff.sz )
-    {
-        ptr = &((uint8_t*)pPool->buff.d)[pPool->buff.head];
-
-        cpSz = pPool->buff.sz - pPool->buff.head;
-
-        memcpy(pBuff, ptr, cpSz);
-
-        //por isso o buffer precisa estar alinhado!
-        pPool->buff.head = _epool_updateIndex(pPool->buff.head, cpSz, pPool->buff.sz );
-        pPool->full = 0;
-
-        pBuff = &(((uint8_t*)pBuff)[cpSz]);
-
-        //numero de elementos retirados:
-        pSz -= (cpSz/1);
-    }
-
-    ptr = &((uint8_t*)pPool->buff.d)[pPool->buff.head];
-
-    cpSz = (pSz*1);
+    //  |=====t---------------------h=======| pega o head ate o final
+    //  |=====t-----------------------------| pega o início ate o tail
+    off = EPOOL_OFF(pPool, pPool->buff.head);
+    ptr = &((uint8_t*)pPool->buff.d)[off];
+    cpSz = MIN( pSz, pPool->buff.sz - off );
 
     memcpy(pBuff, ptr, cpSz);
 
-    pPool->buff.head = _epool_updateIndex(pPool->buff.head, cpSz, pPool->buff.sz );
-    if( pSz > 0 )
+    if( cpSz < pSz )
     {
-        pPool->full = 0;
+        memcpy(&((uint8_t*)pBuff)[cpSz], pPool->buff.d, pSz - cpSz);
     }
 
-    return result;
+    _epool_advHead(pPool, pSz);
+
+    return pSz;
 }
 
 uint32_t EntropyPool_Discard(entropy_pool_t *pPool, uint32_t pSz)
@@ -220,11 +368,7 @@ uint32_t EntropyPool_Discard(entropy_pool_t *pPool, uint32_t pSz)
 
     pSz = MIN( pSz, EntropyPool_Used(pPool) );
 
-    pPool->buff.head = _epool_updateIndex(pPool->buff.head, pSz, pPool->buff.sz );
-    if( pSz > 0 )
-    {
-        pPool->full = 0;
-    }
+    _epool_advHead(pPool, pSz);
 
     return pSz;
 
@@ -237,7 +381,8 @@ void EntropyPool_Flush(entropy_pool_t *pPool)
         return;
     }
 
-    pPool->buff.head = pPool->buff.tail = pPool->full = 0;
+    pPool->buff.head = pPool->buff.tail = pPool->full = pPool->entropy_cur = 0;
+    pPool->rd.acc = pPool->rd.n = 0;
 
     return;
 }
@@ -253,18 +398,7 @@ uint32_t EntropyPool_Used(entropy_pool_t *pPool)
         return 0;
     }
 
-    if( (pPool->buff.head == pPool->buff.tail) && !(pPool->full) )
-    {
-        return 0;
-    }
-    else if(pPool->buff.tail > pPool->buff.head)
-    {
-        return (pPool->buff.tail - pPool->buff.head);
-    }
-    else
-    {
-        return (pPool->buff.sz - (pPool->buff.head - pPool->buff.tail));
-    }
+    return _epool_used(pPool);
 }
 
 bool_t EntropyPool_IsEmpty(entropy_pool_t *pPool)
@@ -0,0 +1,496 @@
+
+#include <string.h>
+#include "common/framing.h"
+
+
+#define COBS_DELIM          0x00
+#define COBS_BLOCK_MAX      0xFF
+
+/*
+ * Region reserved in an output ring buffer
+ */
+typedef struct
+{
+    ringbuff_vec_t seg[2];
+    uint32_t n;
+}framing_out_t;
+
+static INLINE void _framing_reserve( ringbuff_t *pOut, framing_out_t *pRes )
+{
+    pRes->n = RingBuff_WrReserve( pOut, UINT32_MAX, pRes->seg );
+}
+
+/*
+ * Copies bytes at an offset of the reserved region, as many as fit.
+ */
+static uint32_t _framing_put( framing_out_t *pRes, uint32_t pOff, const uint8_t *pSrc, uint32_t pN )
+{
+    uint32_t n;
+    uint32_t cp;
+
+    if( pOff >= pRes->n )
+    {
+        return 0;
+    }
+
+    n = pN = MIN( pN, pRes->n - pOff );
+    if( pOff < pRes->seg[0].n )
+    {
+        cp = MIN( n, pRes->seg[0].n - pOff );
+        memcpy( &((uint8_t*)pRes->seg[0].ptr)[pOff], pSrc, cp );
+        pSrc += cp;
+        pOff += cp;
+        n -= cp;
+    }
+    if( n > 0 )
+    {
+        memcpy( &((uint8_t*)pRes->seg[1].ptr)[pOff - pRes->seg[0].n], pSrc, n );
+    }
+    return pN;
+}
+
+static INLINE void _framing_drop( framing_dec_t *pDec, bool_t pSkip )
+{
+    pDec->len = 0;
+    pDec->rem = 0;
+    pDec->code = 0;
+    pDec->skip = pSkip;
+}
+
+/*
+ * Decodes the COBS bytes of an input segment. pUsed gets the bytes consumed.
+ */
+static res_t _cobs_decSeg( framing_dec_t *pDec, framing_out_t *pOut, const uint8_t *pSrc, uint32_t pN, uint32_t *pUsed )
+{
+    const uint8_t *ptr = pSrc;
+    const uint8_t *end = pSrc + pN;
+    const uint8_t *frameEnd;
+    const uint8_t *stop;
+    const uint8_t zero = 0;
+    uint32_t n;
+
+    while( ptr < end )
+    {
+        frameEnd = memchr( ptr, COBS_DELIM, (size_t)(end - ptr) );
+        stop = (frameEnd != NULL) ? frameEnd : end;
+
+        if( pDec->skip )
+        {
+            ptr = stop;
+        }
+        while( ptr < stop )
+        {
+            if( pDec->rem == 0 )
+            {
+                //novo bloco: o zero implícito do bloco anterior
+                if( (pDec->code != 0) && (pDec->code != COBS_BLOCK_MAX) )
+                {
+                    if( _framing_put( pOut, pDec->len, &zero, 1 ) == 0 )
+                    {
+                        *pUsed = (uint32_t)(ptr - pSrc);
+                        return RES_ERR_BUSY;
+                    }
+                    pDec->len++;
+                }
+                pDec->code = *ptr;
+                pDec->rem = *ptr - 1;
+                ptr++;
+                continue;
+            }
+
+            n = _framing_put( pOut, pDec->len, ptr, MIN( (uint32_t)pDec->rem, (uint32_t)(stop - ptr) ) );
+            pDec->len += n;
+            pDec->rem -= n;
+            ptr += n;
+            if( (pDec->rem > 0) && (ptr < stop) )
+            {
+                *pUsed = (uint32_t)(ptr - pSrc);
+                return RES_ERR_BUSY;
+            }
+        }
+
+        if( frameEnd == NULL )
+        {
+            break;
+        }
+        ptr = frameEnd + 1;
+        *pUsed = (uint32_t)(ptr - pSrc);
+
+        if( pDec->skip )
+        {
+            _framing_drop( pDec, false );
+        }
+        else if( pDec->rem != 0 )
+        {
+            //bloco interrompido pelo delimitador
+            _framing_drop( pDec, false );
+            return RES_ERR_FORMAT;
+        }
+        else if( pDec->code != 0 )
+        {
+            pDec->code = 0;
+            return RES_SUCCESS;
+        }
+    }
+
+    *pUsed = pN;
+    return RES_ERR_NO_MORE_RECORDS;
+}
+
+/*
+ * Decodes the SLIP bytes of an input segment. pUsed gets the bytes consumed.
+ */
+static res_t _slip_decSeg( framing_dec_t *pDec, framing_out_t *pOut, const uint8_t *pSrc, uint32_t pN, uint32_t *pUsed )
+{
+    const uint8_t *ptr = pSrc;
+    const uint8_t *end = pSrc + pN;
+    const uint8_t *frameEnd;
+    const uint8_t *stop;
+    const uint8_t *esc;
+    const uint8_t *runEnd;
+    uint8_t byte;
+    uint32_t n;
+
+    while( ptr < end )
+    {
+        frameEnd = memchr( ptr, SLIP_END, (size_t)(end - ptr) );
+        stop = (frameEnd != NULL) ? frameEnd : end;
+
+        if( pDec->skip )
+        {
+            ptr = stop;
+        }
+        while( ptr < stop )
+        {
+            //code sinaliza um escape pendente
+            if( pDec->code )
+            {
+                if( *ptr == SLIP_ESC_END )
+                {
+                    byte = SLIP_END;
+                }
+                else if( *ptr == SLIP_ESC_ESC )
+                {
+                    byte = SLIP_ESC;
+                }
+                else
+                {
+                    _framing_drop( pDec, true );
+                    *pUsed = (uint32_t)(ptr + 1 - pSrc);
+                    return RES_ERR_FORMAT;
+                }
+                if( _framing_put( pOut, pDec->len, &byte, 1 ) == 0 )
+                {
+                    *pUsed = (uint32_t)(ptr - pSrc);
+                    return RES_ERR_BUSY;
+                }
+                pDec->len++;
+                pDec->code = 0;
+                ptr++;
+                continue;
+            }
+
+            esc = memchr( ptr, SLIP_ESC, (size_t)(stop - ptr) );
+            runEnd = (esc != NULL) ? esc : stop;
+
+            n = _framing_put( pOut, pDec->len, ptr, (uint32_t)(runEnd - ptr) );
+            pDec->len += n;
+            ptr += n;
+            if( ptr < runEnd )
+            {
+                *pUsed = (uint32_t)(ptr - pSrc);
+                return RES_ERR_BUSY;
+            }
+            if( esc != NULL )
+            {
+                pDec->code = 1;
+                ptr++;
+            }
+        }
+
+        if( frameEnd == NULL )
+        {
+            break;
+        }
+        ptr = frameEnd + 1;
+        *pUsed = (uint32_t)(ptr - pSrc);
+
+        if( pDec->skip )
+        {
+            _framing_drop( pDec, false );
+        }
+        else if( pDec->code )
+        {
+            //escape seguido do delimitador
+            _framing_drop( pDec, false );
+            return RES_ERR_FORMAT;
+        }
+        else if( pDec->len > 0 )
+        {
+            return RES_SUCCESS;
+        }
+    }
+
+    *pUsed = pN;
+    return RES_ERR_NO_MORE_RECORDS;
+}
+
+static res_t _framing_decode( framing_dec_t *pDec, ringbuff_t *pIn, ringbuff_t *pOut, uint32_t *pLen, bool_t pCobs )
+{
+    ringbuff_vec_t in[2];
+    framing_out_t out;
+    uint32_t used = 0;
+    uint32_t n;
+    uint8_t ii;
+    res_t res = RES_ERR_NO_MORE_RECORDS;
+
+    if( pDec == NULL )
+    {
+        return RES_ERROR;
+    }
+    if( (pIn == NULL) || (pOut == NULL) )
+    {
+        return RES_ERROR;
+    }
+    if( (RingBuff_Sz( pIn ) == 0) || (RingBuff_Sz( pOut ) == 0) )
+    {
+        return RES_ERROR;
+    }
+    if( (pIn->eSz != 1) || (pOut->eSz != 1) )
+    {
+        return RES_ERR_SZ;
+    }
+
+    _framing_reserve( pOut, &out );
+    RingBuff_PeekSegs( pIn, 0, RingBuff_Used( pIn ), in );
+
+    for( ii = 0; (ii < 2) && (in[ii].n > 0) && (res == RES_ERR_NO_MORE_RECORDS); ii++ )
+    {
+        n = 0;
+        if( pCobs )
+        {
+            res = _cobs_decSeg( pDec, &out, in[ii].ptr, in[ii].n, &n );
+        }
+        else
+        {
+            res = _slip_decSeg( pDec, &out, in[ii].ptr, in[ii].n, &n );
+        }
+        used += n;
+    }
+    RingBuff_Discard( pIn, used );
+
+    if( res == RES_SUCCESS )
+    {
+        RingBuff_WrCommit( pOut, pDec->len );
+        if( pLen != NULL )
+        {
+            *pLen = pDec->len;
+        }
+        pDec->len = 0;
+    }
+    else if( (res == RES_ERR_BUSY) && (out.n == RingBuff_Sz( pOut )) )
+    {
+        //nem com o buffer vazio o quadro caberia
+        _framing_drop( pDec, true );
+        res = RES_ERR_OVERFLOW;
+    }
+
+    return res;
+}
+
+
+void Framing_DecInit(framing_dec_t *pDec)
+{
+    if( pDec == NULL )
+    {
+        return;
+    }
+
+    _framing_drop( pDec, false );
+}
+
+res_t Cobs_Encode(const ringbuff_vec_t *pVec, uint32_t pVecN, ringbuff_t *pOut)
+{
+    framing_out_t out;
+    const uint8_t *ptr;
+    const uint8_t *end;
+    const uint8_t *zero;
+    const uint8_t *runEnd;
+    uint32_t codePos = 0;
+    uint32_t off = 1;
+    uint32_t n;
+    uint32_t ii;
+    uint8_t code = 1;
+
+    if( ((pVec == NULL) && (pVecN > 0)) || (pOut == NULL) )
+    {
+        return RES_ERROR;
+    }
+    if( RingBuff_Sz( pOut ) == 0 )
+    {
+        return RES_ERROR;
+    }
+    if( pOut->eSz != 1 )
+    {
+        return RES_ERR_SZ;
+    }
+
+    _framing_reserve( pOut, &out );
+
+    //o código de cada bloco é escrito quando o bloco termina
+    for( ii = 0; ii < pVecN; ii++ )
+    {
+        ptr = (const uint8_t *)pVec[ii].ptr;
+        end = ptr + pVec[ii].n;
+
+        while( ptr < end )
+        {
+            zero = memchr( ptr, 0, (size_t)(end - ptr) );
+            runEnd = (zero != NULL) ? zero : end;
+
+            while( ptr < runEnd )
+            {
+                n = MIN( (uint32_t)(runEnd - ptr), (uint32_t)(COBS_BLOCK_MAX - code) );
+                if( _framing_put( &out, off, ptr, n ) < n )
+                {
+                    return RES_ERR_BUSY;
+                }
+                off += n;
+                code += n;
+                ptr += n;
+
+                if( code == COBS_BLOCK_MAX )
+                {
+                    _framing_put( &out, codePos, &code, 1 );
+                    codePos = off++;
+                    code = 1;
+                }
+            }
+
+            if( zero != NULL )
+            {
+                _framing_put( &out, codePos, &code, 1 );
+                codePos = off++;
+                code = 1;
+                ptr++;
+            }
+        }
+    }
+
+    //o último código e o delimitador
+    if( off >= out.n )
+    {
+        return RES_ERR_BUSY;
+    }
+    _framing_put( &out, codePos, &code, 1 );
+    code = COBS_DELIM;
+    _framing_put( &out, off++, &code, 1 );
+
+    RingBuff_WrCommit( pOut, off );
+    return RES_SUCCESS;
+}
+
+res_t Cobs_Decode(framing_dec_t *pDec, ringbuff_t *pIn, ringbuff_t *pOut, uint32_t *pLen)
+{
+    return _framing_decode( pDec, pIn, pOut, pLen, true );
+}
+
+res_t Slip_Encode(const ringbuff_vec_t *pVec, uint32_t pVecN, ringbuff_t *pOut)
+{
+    framing_out_t out;
+    const uint8_t *ptr;
+    const uint8_t *end;
+    const uint8_t *nextEnd;
+    const uint8_t *nextEsc;
+    const uint8_t *special;
+    uint8_t esc[2] = { SLIP_ESC, 0 };
+    uint8_t delim = SLIP_END;
+    uint32_t off = 0;
+    uint32_t n;
+    uint32_t ii;
+
+    if( ((pVec == NULL) && (pVecN > 0)) || (pOut == NULL) )
+    {
+        return RES_ERROR;
+    }
+    if( RingBuff_Sz( pOut ) == 0 )
+    {
+        return RES_ERROR;
+    }
+    if( pOut->eSz != 1 )
+    {
+        return RES_ERR_SZ;
+    }
+
+    _framing_reserve( pOut, &out );
+
+    //o delimitador inicial descarta o ruído da linha no receptor
+    if( _framing_put( &out, off++, &delim, 1 ) == 0 )
+    {
+        return RES_ERR_BUSY;
+    }
+
+    for( ii = 0; ii < pVecN; ii++ )
+    {
+        ptr = (const uint8_t *)pVec[ii].ptr;
+        end = ptr + pVec[ii].n;
+        if( ptr == end )
+        {
+            continue;
+        }
+
+        nextEnd = memchr( ptr, SLIP_END, (size_t)(end - ptr) );
+        nextEnd = (nextEnd != NULL) ? nextEnd : end;
+        nextEsc = memchr( ptr, SLIP_ESC, (size_t)(end - ptr) );
+        nextEsc = (nextEsc != NULL) ? nextEsc : end;
+
+        while( ptr < end )
+        {
+            special = (nextEnd < nextEsc) ? nextEnd : nextEsc;
+
+            n = (uint32_t)(special - ptr);
+            if( _framing_put( &out, off, ptr, n ) < n )
+            {
+                return RES_ERR_BUSY;
+            }
+            off += n;
+            ptr = special;
+            if( ptr == end )
+            {
+                break;
+            }
+
+            esc[1] = (*ptr == SLIP_END) ? SLIP_ESC_END : SLIP_ESC_ESC;
+            if( _framing_put( &out, off, esc, 2 ) < 2 )
+            {
+                return RES_ERR_BUSY;
+            }
+            off += 2;
+            ptr++;
+
+            if( special == nextEnd )
+            {
+                nextEnd = memchr( ptr, SLIP_END, (size_t)(end - ptr) );
+                nextEnd = (nextEnd != NULL) ? nextEnd : end;
+            }
+            else
+            {
+                nextEsc = memchr( ptr, SLIP_ESC, (size_t)(end - ptr) );
+                nextEsc = (nextEsc != NULL) ? nextEsc : end;
+            }
+        }
+    }
+
+    if( _framing_put( &out, off++, &delim, 1 ) == 0 )
+    {
+        return RES_ERR_BUSY;
+    }
+
+    RingBuff_WrCommit( pOut, off );
+    return RES_SUCCESS;
+}
+
+res_t Slip_Decode(framing_dec_t *pDec, ringbuff_t *pIn, ringbuff_t *pOut, uint32_t *pLen)
+{
+    return _framing_decode( pDec, pIn, pOut, pLen, false );
+}
@@ -0,0 +1,329 @@
+
+#include <string.h>
+#include "common/lzss.h"
+
+
+#define LZSS_BUF_SZ         ( 2 * LZSS_WINDOW_SZ )
+#define LZSS_WINDOW_MASK    ( LZSS_WINDOW_SZ - 1 )
+
+/** Shortest match that takes fewer bits than the same bytes as literals */
+#define LZSS_MIN_MATCH      ( (1 + LZSS_WINDOW_BITS + LZSS_LOOKAHEAD_BITS) / 9 + 1 )
+
+/** Bytes written by a token, with the bits still pending in the accumulator */
+#define LZSS_TOKEN_MAX      ( 5 )
+
+/** Bytes staged on the stack before being written to the output ring */
+#define LZSS_CHUNK_SZ       ( 32 )
+
+enum
+{
+    LZSS_ST_TAG = 0,
+    LZSS_ST_LIT,
+    LZSS_ST_OFF,
+    LZSS_ST_CNT,
+};
+
+/*
+ * Appends up to 16 bits to the encoder accumulator. Complete bytes are moved
+ * to pOut.
+ */
+static INLINE uint32_t _lzss_put( lzss_enc_t *pEnc, uint32_t pVal, uint8_t pN, uint8_t *pOut )
+{
+    uint32_t n = 0;
+
+    pEnc->acc = (pEnc->acc << pN) | pVal;
+    pEnc->nBits += pN;
+    while( pEnc->nBits >= 8 )
+    {
+        pEnc->nBits -= 8;
+        pOut[n++] = (uint8_t)( pEnc->acc >> pEnc->nBits );
+    }
+    return n;
+}
+
+/*
+ * Finds the longest match for the bytes at pos, the nearest one when tied.
+ */
+static uint16_t _lzss_match( lzss_enc_t *pEnc, uint16_t *pOff )
+{
+    const uint8_t *cur = &pEnc->buf[pEnc->pos];
+    const uint8_t *cand;
+    uint16_t maxLen = MIN( LZSS_LOOKAHEAD_SZ, (uint16_t)(pEnc->fill - pEnc->pos) );
+    uint16_t start = (pEnc->pos > LZSS_WINDOW_SZ) ? (uint16_t)(pEnc->pos - LZSS_WINDOW_SZ) : 0;
+    uint16_t best = 0;
+    uint16_t ii;
+    uint16_t len;
+
+    for( ii = pEnc->pos; ii-- > start; )
+    {
+        cand = &pEnc->buf[ii];
+        //o byte que tornaria este candidato melhor decide primeiro
+        if( cand[best] != cur[best] )
+        {
+            continue;
+        }
+        for( len = 0; (len < maxLen) && (cand[len] == cur[len]); len++ );
+        if( len > best )
+        {
+            best = len;
+            *pOff = (uint16_t)(pEnc->pos - ii);
+            if( best == maxLen )
+            {
+                break;
+            }
+        }
+    }
+    return best;
+}
+
+/*
+ * Takes N bits from the decoder accumulator, reading input bytes as needed.
+ */
+static bool_t _lzss_bits( lzss_dec_t *pDec, ringbuff_t *pIn, uint8_t pN, uint16_t *pVal )
+{
+    uint8_t byte;
+
+    while( pDec->nBits < pN )
+    {
+        if( RingBuff_RdOne( pIn, &byte ) == 0 )
+        {
+            return false;
+        }
+        pDec->acc = (pDec->acc << 8) | byte;
+        pDec->nBits += 8;
+    }
+    pDec->nBits -= pN;
+    *pVal = (uint16_t)( (pDec->acc >> pDec->nBits) & ((1UL << pN) - 1) );
+    return true;
+}
+
+static INLINE uint8_t _lzss_emit( lzss_dec_t *pDec, uint8_t pByte )
+{
+    pDec->win[pDec->wPos] = pByte;
+    pDec->wPos = (pDec->wPos + 1) & LZSS_WINDOW_MASK;
+    return pByte;
+}
+
+/*
+ * Decodes up to pRoom bytes into pOut. Stops early when the input runs out.
+ */
+static uint32_t _lzss_decode( lzss_dec_t *pDec, ringbuff_t *pIn, uint8_t *pOut, uint32_t pRoom )
+{
+    uint32_t n = 0;
+    uint16_t val;
+
+    while( n < pRoom )
+    {
+        if( pDec->cnt > 0 )
+        {
+            pOut[n++] = _lzss_emit( pDec, pDec->win[ (pDec->wPos + LZSS_WINDOW_SZ - pDec->off) & LZSS_WINDOW_MASK ] );
+            pDec->cnt--;
+            continue;
+        }
+
+        switch( pDec->state )
+        {
+        case LZSS_ST_TAG:
+            if( !_lzss_bits( pDec, pIn, 1, &val ) )
+            {
+                return n;
+            }
+            pDec->state = val ? LZSS_ST_LIT : LZSS_ST_OFF;
+            break;
+
+        case LZSS_ST_LIT:
+            if( !_lzss_bits( pDec, pIn, 8, &val ) )
+            {
+                return n;
+            }
+            pOut[n++] = _lzss_emit( pDec, (uint8_t)val );
+            pDec->state = LZSS_ST_TAG;
+            break;
+
+        case LZSS_ST_OFF:
+            if( !_lzss_bits( pDec, pIn, LZSS_WINDOW_BITS, &val ) )
+            {
+                return n;
+            }
+            pDec->off = val + 1;
+            pDec->state = LZSS_ST_CNT;
+            break;
+
+        default:
+            if( !_lzss_bits( pDec, pIn, LZSS_LOOKAHEAD_BITS, &val ) )
+            {
+                return n;
+            }
+            pDec->cnt = val + 1;
+            pDec->state = LZSS_ST_TAG;
+            break;
+        }
+    }
+    return n;
+}
+
+
+void Lzss_EncInit(lzss_enc_t *pEnc)
+{
+    if( pEnc == NULL )
+    {
+        return;
+    }
+
+    pEnc->fill = 0;
+    pEnc->pos = 0;
+    pEnc->acc = 0;
+    pEnc->nBits = 0;
+}
+
+res_t Lzss_EncPoll(lzss_enc_t *pEnc, ringbuff_t *pIn, ringbuff_t *pOut, uint32_t pBudget, bool_t pFinish)
+{
+    uint8_t out[LZSS_CHUNK_SZ];
+    uint32_t outN = 0;
+    uint32_t room;
+    uint16_t len;
+    uint16_t off = 0;
+    res_t res;
+
+    if( pEnc == NULL )
+    {
+        return RES_ERROR;
+    }
+    if( (pIn == NULL) || (pOut == NULL) )
+    {
+        return RES_ERROR;
+    }
+    if( (RingBuff_Sz( pIn ) == 0) || (RingBuff_Sz( pOut ) == 0) )
+    {
+        return RES_ERROR;
+    }
+    if( (pIn->eSz != 1) || (pOut->eSz != 1) )
+    {
+        return RES_ERR_SZ;
+    }
+
+    room = RingBuff_Free( pOut );
+    for(;;)
+    {
+        //sem lookahead suficiente e sem espaço: descarta a metade mais antiga
+        if( (pEnc->fill == LZSS_BUF_SZ) && ((uint32_t)(pEnc->fill - pEnc->pos) < LZSS_LOOKAHEAD_SZ) )
+        {
+            memmove( pEnc->buf, &pEnc->buf[LZSS_WINDOW_SZ], LZSS_WINDOW_SZ );
+            pEnc->fill -= LZSS_WINDOW_SZ;
+            pEnc->pos -= LZSS_WINDOW_SZ;
+        }
+        pEnc->fill += RingBuff_RdMany( pIn, &pEnc->buf[pEnc->fill], LZSS_BUF_SZ - pEnc->fill );
+
+        if( ((uint32_t)(pEnc->fill - pEnc->pos) < LZSS_LOOKAHEAD_SZ) && !pFinish )
+        {
+            res = RES_ERR_NO_MORE_RECORDS;
+            break;
+        }
+        if( room - outN < LZSS_TOKEN_MAX )
+        {
+            res = RES_ERR_BUSY;
+            break;
+        }
+        if( pEnc->fill == pEnc->pos )
+        {
+            //fim do stream: completa o último byte com zeros
+            if( pEnc->nBits > 0 )
+            {
+                outN += _lzss_put( pEnc, 0, 8 - pEnc->nBits, &out[outN] );
+            }
+            res = RES_SUCCESS;
+            break;
+        }
+        if( pBudget == 0 )
+        {
+            res = RES_ERR_BUSY;
+            break;
+        }
+
+        len = _lzss_match( pEnc, &off );
+        if( len >= LZSS_MIN_MATCH )
+        {
+            outN += _lzss_put( pEnc, off - 1, 1 + LZSS_WINDOW_BITS, &out[outN] );
+            outN += _lzss_put( pEnc, len - 1, LZSS_LOOKAHEAD_BITS, &out[outN] );
+        }
+        else
+        {
+            len = 1;
+            outN += _lzss_put( pEnc, 0x100U | pEnc->buf[pEnc->pos], 9, &out[outN] );
+        }
+        pEnc->pos += len;
+        pBudget -= MIN( (uint32_t)len, pBudget );
+
+        if( outN > LZSS_CHUNK_SZ - LZSS_TOKEN_MAX )
+        {
+            RingBuff_WrMany( pOut, out, outN, false );
+            room -= outN;
+            outN = 0;
+        }
+    }
+
+    RingBuff_WrMany( pOut, out, outN, false );
+    if( res == RES_SUCCESS )
+    {
+        Lzss_EncInit( pEnc );
+    }
+    return res;
+}
+
+void Lzss_DecInit(lzss_dec_t *pDec)
+{
+    if( pDec == NULL )
+    {
+        return;
+    }
+
+    memset( pDec->win, 0, sizeof(pDec->win) );
+    pDec->wPos = 0;
+    pDec->off = 0;
+    pDec->cnt = 0;
+    pDec->acc = 0;
+    pDec->nBits = 0;
+    pDec->state = LZSS_ST_TAG;
+}
+
+res_t Lzss_DecPoll(lzss_dec_t *pDec, ringbuff_t *pIn, ringbuff_t *pOut, uint32_t pBudget)
+{
+    uint8_t out[LZSS_CHUNK_SZ];
+    uint32_t room;
+    uint32_t n;
+
+    if( pDec == NULL )
+    {
+        return RES_ERROR;
+    }
+    if( (pIn == NULL) || (pOut == NULL) )
+    {
+        return RES_ERROR;
+    }
+    if( (RingBuff_Sz( pIn ) == 0) || (RingBuff_Sz( pOut ) == 0) )
+    {
+        return RES_ERROR;
+    }
+    if( (pIn->eSz != 1) || (pOut->eSz != 1) )
+    {
+        return RES_ERR_SZ;
+    }
+
+    for(;;)
+    {
+        room = MIN( RingBuff_Free( pOut ), pBudget );
+        room = MIN( room, sizeof(out) );
+        if( room == 0 )
+        {
+            return RES_ERR_BUSY;
+        }
+
+        n = _lzss_decode( pDec, pIn, out, room );
+        RingBuff_WrMany( pOut, out, n, false );
+        pBudget -= n;
+        if( n < room )
+        {
+            return RES_ERR_NO_MORE_RECORDS;
+        }
+    }
+}
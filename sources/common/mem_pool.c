@@ -0,0 +1,295 @@
+
+#include <string.h>
+#include "common/mem_pool.h"
+
+
+#define MEMPOOL_IDX(__free)     ( (mempool_idx_t)((__free) & 0xFFFFU) )
+#define MEMPOOL_TAG(__free)     ( (__free) & 0xFFFF0000UL )
+#define MEMPOOL_TAG_NEXT        ( 0x00010000UL )
+
+#define MEMPOOL_BLK(__pool, __idx)  ( &((uint8_t*)(__pool)->data)[ (uint32_t)(__idx) * (__pool)->bSz ] )
+
+#if defined(MEMPOOL_LOCKFREE)
+#define MEMPOOL_CAS(__ptr, __exp, __val) \
+    __atomic_compare_exchange_n( (__ptr), (__exp), (__val), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE )
+#define MEMPOOL_LOAD(__ptr)         __atomic_load_n( (__ptr), __ATOMIC_ACQUIRE )
+#define MEMPOOL_ADD(__ptr, __val)   __atomic_add_fetch( (__ptr), (__val), __ATOMIC_RELAXED )
+#else
+#define MEMPOOL_LOAD(__ptr)         ( *(__ptr) )
+#define MEMPOOL_ADD(__ptr, __val)   ( *(__ptr) += (__val) )
+#endif
+
+/*
+ * The first bytes of a free block hold the index of the next free block.
+ */
+static INLINE mempool_idx_t _mempool_next( mem_pool_t *pPool, mempool_idx_t pIdx )
+{
+    mempool_idx_t next;
+    memcpy( &next, MEMPOOL_BLK(pPool, pIdx), sizeof(next) );
+    return next;
+}
+
+static INLINE void _mempool_setNext( mem_pool_t *pPool, mempool_idx_t pIdx, mempool_idx_t pNext )
+{
+    memcpy( MEMPOOL_BLK(pPool, pIdx), &pNext, sizeof(pNext) );
+}
+
+static void _mempool_updateHwm( mem_pool_t *pPool, uint32_t pUsed )
+{
+#if defined(MEMPOOL_LOCKFREE)
+    uint32_t hwm = MEMPOOL_LOAD(&pPool->hwm);
+
+    while( pUsed > hwm )
+    {
+        if( MEMPOOL_CAS( &pPool->hwm, &hwm, pUsed ) )
+        {
+            break;
+        }
+    }
+#else
+    if( pUsed > pPool->hwm )
+    {
+        pPool->hwm = pUsed;
+    }
+#endif
+}
+
+uint32_t MemPool_Init(mem_pool_t *pPool, void * const pBuff, uint32_t pSz, uint32_t pBlkSz)
+{
+    uintptr_t pad;
+    uint32_t ii;
+
+    if( pPool == NULL )
+    {
+        return 0;
+    }
+    if( pBuff == NULL )
+    {
+        return 0;
+    }
+    if( pBlkSz == 0 )
+    {
+        return 0;
+    }
+
+    //o bloco livre guarda o indice do proximo
+    pBlkSz = MAX( pBlkSz, (uint32_t)sizeof(mempool_idx_t) );
+    pBlkSz = (pBlkSz + (MEMPOOL_ALIGN - 1)) & ~(uint32_t)(MEMPOOL_ALIGN - 1);
+
+    pad = ( MEMPOOL_ALIGN - ((uintptr_t)pBuff & (MEMPOOL_ALIGN - 1)) ) & (MEMPOOL_ALIGN - 1);
+    if( pSz < pad + pBlkSz )
+    {
+        return 0;
+    }
+
+    pPool->data = &((uint8_t*)pBuff)[pad];
+    pPool->bSz = pBlkSz;
+    pPool->n = MIN( (pSz - (uint32_t)pad) / pBlkSz, (uint32_t)MEMPOOL_BLOCKS_MAX );
+    pPool->used = pPool->hwm = 0;
+
+    for(ii=0; ii < pPool->n; ii++)
+    {
+        _mempool_setNext( pPool, (mempool_idx_t)ii, (mempool_idx_t)(ii + 1) );
+    }
+    _mempool_setNext( pPool, (mempool_idx_t)(pPool->n - 1), MEMPOOL_NONE );
+
+    pPool->free = 0;
+    pPool->init = true;
+
+    return pPool->n;
+}
+
+void *MemPool_Alloc(mem_pool_t *pPool)
+{
+    uint32_t head;
+    mempool_idx_t idx;
+
+    if( pPool == NULL )
+    {
+        return NULL;
+    }
+    if( !pPool->init )
+    {
+        return NULL;
+    }
+
+#if defined(MEMPOOL_LOCKFREE)
+    head = MEMPOOL_LOAD(&pPool->free);
+    do
+    {
+        idx = MEMPOOL_IDX(head);
+        if( idx == MEMPOOL_NONE )
+        {
+            return NULL;
+        }
+        //se outro contexto alocar este bloco antes, a tag muda e o CAS falha
+    }while( !MEMPOOL_CAS( &pPool->free, &head,
+                          (MEMPOOL_TAG(head) + MEMPOOL_TAG_NEXT) | _mempool_next( pPool, idx ) ) );
+#else
+    head = pPool->free;
+    idx = MEMPOOL_IDX(head);
+    if( idx == MEMPOOL_NONE )
+    {
+        return NULL;
+    }
+    pPool->free = _mempool_next( pPool, idx );
+#endif
+
+    _mempool_updateHwm( pPool, MEMPOOL_ADD( &pPool->used, 1 ) );
+
+    return MEMPOOL_BLK(pPool, idx);
+}
+
+res_t MemPool_Release(mem_pool_t *pPool, void *pBlk)
+{
+    uint32_t head;
+    uint32_t used;
+    mempool_idx_t idx;
+
+    idx = MemPool_Idx( pPool, pBlk );
+    if( idx == MEMPOOL_NONE )
+    {
+        return RES_ERR_FORMAT;
+    }
+
+    //nada alocado: liberação repetida. Desconta antes de devolver o bloco
+#if defined(MEMPOOL_LOCKFREE)
+    used = MEMPOOL_LOAD(&pPool->used);
+    do
+    {
+        if( used == 0 )
+        {
+            return RES_ERROR;
+        }
+    }while( !MEMPOOL_CAS( &pPool->used, &used, used - 1 ) );
+
+    head = MEMPOOL_LOAD(&pPool->free);
+    do
+    {
+        _mempool_setNext( pPool, idx, MEMPOOL_IDX(head) );
+    }while( !MEMPOOL_CAS( &pPool->free, &head, (MEMPOOL_TAG(head) + MEMPOOL_TAG_NEXT) | idx ) );
+#else
+    used = pPool->used;
+    if( used == 0 )
+    {
+        return RES_ERROR;
+    }
+    pPool->used = used - 1;
+
+    head = pPool->free;
+    _mempool_setNext( pPool, idx, MEMPOOL_IDX(head) );
+    pPool->free = idx;
+#endif
+
+    return RES_SUCCESS;
+}
+
+mempool_idx_t MemPool_Idx(mem_pool_t *pPool, const void *pBlk)
+{
+    uintptr_t off;
+
+    if( pPool == NULL )
+    {
+        return MEMPOOL_NONE;
+    }
+    if( !pPool->init )
+    {
+        return MEMPOOL_NONE;
+    }
+    if( (const uint8_t*)pBlk < (const uint8_t*)pPool->data )
+    {
+        return MEMPOOL_NONE;
+    }
+
+    off = (uintptr_t)((const uint8_t*)pBlk - (const uint8_t*)pPool->data);
+
+    if( (off % pPool->bSz) != 0 )
+    {
+        return MEMPOOL_NONE;
+    }
+    if( (off / pPool->bSz) >= pPool->n )
+    {
+        return MEMPOOL_NONE;
+    }
+
+    return (mempool_idx_t)(off / pPool->bSz);
+}
+
+void *MemPool_Ptr(mem_pool_t *pPool, mempool_idx_t pIdx)
+{
+    if( pPool == NULL )
+    {
+        return NULL;
+    }
+    if( !pPool->init )
+    {
+        return NULL;
+    }
+    if( pIdx >= pPool->n )
+    {
+        return NULL;
+    }
+
+    return MEMPOOL_BLK(pPool, pIdx);
+}
+
+uint32_t MemPool_BlkSz(mem_pool_t *pPool)
+{
+    if( pPool == NULL )
+    {
+        return 0;
+    }
+    if( !pPool->init )
+    {
+        return 0;
+    }
+
+    return pPool->bSz;
+}
+
+uint32_t MemPool_Sz(mem_pool_t *pPool)
+{
+    if( pPool == NULL )
+    {
+        return 0;
+    }
+    if( !pPool->init )
+    {
+        return 0;
+    }
+
+    return pPool->n;
+}
+
+uint32_t MemPool_Used(mem_pool_t *pPool)
+{
+    if( pPool == NULL )
+    {
+        return 0;
+    }
+    if( !pPool->init )
+    {
+        return 0;
+    }
+
+    return MEMPOOL_LOAD(&pPool->used);
+}
+
+uint32_t MemPool_Free(mem_pool_t *pPool)
+{
+    return MemPool_Sz(pPool) - MemPool_Used(pPool);
+}
+
+uint32_t MemPool_HighWater(mem_pool_t *pPool)
+{
+    if( pPool == NULL )
+    {
+        return 0;
+    }
+    if( !pPool->init )
+    {
+        return 0;
+    }
+
+    return MEMPOOL_LOAD(&pPool->hwm);
+}
@@ -0,0 +1,124 @@
+
+#include "common/msg_queue.h"
+
+
+uint32_t MsgQueue_Init(msg_queue_t *pQ, mem_pool_t *pPool, void * const pBuff, uint32_t pSz)
+{
+    if( pQ == NULL )
+    {
+        return 0;
+    }
+    if( MemPool_Sz(pPool) == 0 )
+    {
+        return 0;
+    }
+
+    pQ->pool = pPool;
+
+    return RingBuff_Init( &pQ->rb, pBuff, pSz, sizeof(msgq_hnd_t) );
+}
+
+void *MsgQueue_Alloc(msg_queue_t *pQ)
+{
+    if( pQ == NULL )
+    {
+        return NULL;
+    }
+
+    return MemPool_Alloc( pQ->pool );
+}
+
+uint32_t MsgQueue_Send(msg_queue_t *pQ, void *pMsg, uint16_t pLen)
+{
+    msgq_hnd_t hnd;
+
+    if( pQ == NULL )
+    {
+        return 0;
+    }
+    if( pLen > MemPool_BlkSz(pQ->pool) )
+    {
+        return 0;
+    }
+
+    hnd.idx = MemPool_Idx( pQ->pool, pMsg );
+    if( hnd.idx == MEMPOOL_NONE )
+    {
+        return 0;
+    }
+    hnd.len = pLen;
+
+    return RingBuff_WrOne( &pQ->rb, &hnd, false );
+}
+
+void *MsgQueue_Recv(msg_queue_t *pQ, uint16_t *pLen)
+{
+    msgq_hnd_t hnd;
+
+    if( pQ == NULL )
+    {
+        return NULL;
+    }
+    if( RingBuff_RdOne( &pQ->rb, &hnd ) == 0 )
+    {
+        return NULL;
+    }
+
+    if( pLen != NULL )
+    {
+        *pLen = hnd.len;
+    }
+
+    return MemPool_Ptr( pQ->pool, hnd.idx );
+}
+
+void *MsgQueue_Peek(msg_queue_t *pQ, uint16_t *pLen)
+{
+    msgq_hnd_t hnd;
+
+    if( pQ == NULL )
+    {
+        return NULL;
+    }
+    if( RingBuff_RdAdvance( &pQ->rb, &hnd, 1 ) == 0 )
+    {
+        return NULL;
+    }
+
+    if( pLen != NULL )
+    {
+        *pLen = hnd.len;
+    }
+
+    return MemPool_Ptr( pQ->pool, hnd.idx );
+}
+
+res_t MsgQueue_Release(msg_queue_t *pQ, void *pMsg)
+{
+    if( pQ == NULL )
+    {
+        return RES_ERR_FORMAT;
+    }
+
+    return MemPool_Release( pQ->pool, pMsg );
+}
+
+uint32_t MsgQueue_Used(msg_queue_t *pQ)
+{
+    if( pQ == NULL )
+    {
+        return 0;
+    }
+
+    return RingBuff_Used( &pQ->rb );
+}
+
+uint32_t MsgQueue_Free(msg_queue_t *pQ)
+{
+    if( pQ == NULL )
+    {
+        return 0;
+    }
+
+    return RingBuff_Free( &pQ->rb );
+}
@@ -0,0 +1,351 @@
+
+#include <string.h>
+#include "common/prio_queue.h"
+
+
+#define PRIOQ_EL(__q, __idx)    ( &((uint8_t*)(__q)->data)[ (uint32_t)(__idx) * (__q)->eSz ] )
+#define PRIOQ_PARENT(__idx)     ( ((__idx) - 1) / PRIOQ_ARITY )
+#define PRIOQ_CHILD(__idx)      ( (__idx) * PRIOQ_ARITY + 1 )
+
+/*
+ * Index of the child with the smallest key, or pIdx if it has no child
+ */
+static INLINE uint32_t _prioq_minChild( prioq_t *pQ, uint32_t pIdx, uint32_t pUsed )
+{
+    uint32_t first = PRIOQ_CHILD( pIdx );
+    uint32_t last;
+    uint32_t min;
+    uint32_t ii;
+
+    if( first >= pUsed )
+    {
+        return pIdx;
+    }
+
+    last = MIN( first + PRIOQ_ARITY, pUsed );
+    min = first;
+    for(ii=first + 1; ii < last; ii++)
+    {
+        if( PRIOQ_KEY( PRIOQ_EL( pQ, ii ) ) < PRIOQ_KEY( PRIOQ_EL( pQ, min ) ) )
+        {
+            min = ii;
+        }
+    }
+
+    return min;
+}
+
+/*
+ * Moves the hole at pIdx up while the parent key is bigger, then stores the element in it
+ */
+static void _prioq_siftUp( prioq_t *pQ, uint32_t pIdx, const void *pEl, uint32_t pKey )
+{
+    uint32_t parent;
+
+    //o buraco sobe: cada pai desce uma posição, sem trocas
+    while( pIdx > 0 )
+    {
+        parent = PRIOQ_PARENT( pIdx );
+        if( PRIOQ_KEY( PRIOQ_EL( pQ, parent ) ) <= pKey )
+        {
+            break;
+        }
+        memcpy( PRIOQ_EL( pQ, pIdx ), PRIOQ_EL( pQ, parent ), pQ->eSz );
+        pIdx = parent;
+    }
+
+    memcpy( PRIOQ_EL( pQ, pIdx ), pEl, pQ->eSz );
+}
+
+/*
+ * Moves the hole at pIdx down while a child key is smaller, then stores the
+ * element in it. pEl must not be in the heap range [0, pUsed).
+ */
+static void _prioq_siftDown( prioq_t *pQ, uint32_t pIdx, uint32_t pUsed, const void *pEl )
+{
+    uint32_t key = PRIOQ_KEY( pEl );
+    uint32_t child;
+
+    for(;;)
+    {
+        child = _prioq_minChild( pQ, pIdx, pUsed );
+        if( (child == pIdx) || (PRIOQ_KEY( PRIOQ_EL( pQ, child ) ) >= key) )
+        {
+            break;
+        }
+        memcpy( PRIOQ_EL( pQ, pIdx ), PRIOQ_EL( pQ, child ), pQ->eSz );
+        pIdx = child;
+    }
+
+    memcpy( PRIOQ_EL( pQ, pIdx ), pEl, pQ->eSz );
+}
+
+static void _prioq_swap( prioq_t *pQ, uint32_t pA, uint32_t pB )
+{
+    uint32_t *a = (uint32_t *)PRIOQ_EL( pQ, pA );
+    uint32_t *b = (uint32_t *)PRIOQ_EL( pQ, pB );
+    uint32_t tmp;
+    uint32_t ii;
+
+    for(ii=0; ii < pQ->eSz / sizeof(uint32_t); ii++)
+    {
+        tmp = a[ii];
+        a[ii] = b[ii];
+        b[ii] = tmp;
+    }
+}
+
+/*
+ * Rebuilds the heap bottom-up (Floyd): O(n)
+ */
+static void _prioq_heapify( prioq_t *pQ )
+{
+    uint32_t ii;
+    uint32_t idx;
+    uint32_t child;
+
+    if( pQ->used < 2 )
+    {
+        return;
+    }
+
+    //do último pai até a raiz. Aqui o elemento está dentro do heap: troca em vez do buraco
+    ii = PRIOQ_PARENT( pQ->used - 1 ) + 1;
+    while( ii-- )
+    {
+        idx = ii;
+        for(;;)
+        {
+            child = _prioq_minChild( pQ, idx, pQ->used );
+            if( (child == idx) || (PRIOQ_KEY( PRIOQ_EL( pQ, child ) ) >= PRIOQ_KEY( PRIOQ_EL( pQ, idx ) )) )
+            {
+                break;
+            }
+            _prioq_swap( pQ, idx, child );
+            idx = child;
+        }
+    }
+}
+
+/*
+ * Removes the root. The last element fills the hole from the top.
+ */
+static void _prioq_popRoot( prioq_t *pQ, void *pEl )
+{
+    if( pEl != NULL )
+    {
+        memcpy( pEl, PRIOQ_EL( pQ, 0 ), pQ->eSz );
+    }
+
+    pQ->used--;
+    if( pQ->used > 0 )
+    {
+        //o último fica fora do heap novo: pode ser a origem da cópia
+        _prioq_siftDown( pQ, 0, pQ->used, PRIOQ_EL( pQ, pQ->used ) );
+    }
+}
+
+
+uint32_t PrioQ_Init(prioq_t *pQ, void * const pBuff, uint32_t pSz, uint32_t pElSz)
+{
+    uintptr_t pad;
+
+    if( pQ == NULL )
+    {
+        return 0;
+    }
+    if( pBuff == NULL )
+    {
+        return 0;
+    }
+    if( (pElSz == 0) || (pElSz % sizeof(uint32_t)) )
+    {
+        return 0;
+    }
+
+    //a chave é lida como uint32_t
+    pad = ( sizeof(uint32_t) - ((uintptr_t)pBuff & (sizeof(uint32_t) - 1)) ) & (sizeof(uint32_t) - 1);
+    if( pSz < pad + pElSz )
+    {
+        return 0;
+    }
+
+    pQ->data = &((uint8_t*)pBuff)[pad];
+    pQ->eSz = pElSz;
+    pQ->n = (pSz - (uint32_t)pad) / pElSz;
+    pQ->used = 0;
+    pQ->init = true;
+
+    return pQ->n;
+}
+
+res_t PrioQ_Push(prioq_t *pQ, const void *pEl)
+{
+    uint32_t key;
+
+    if( (pQ == NULL) || (pEl == NULL) )
+    {
+        return RES_ERROR;
+    }
+    if( !pQ->init )
+    {
+        return RES_ERROR;
+    }
+    if( pQ->used == pQ->n )
+    {
+        return RES_ERR_OVERFLOW;
+    }
+
+    //o elemento do usuário pode não estar alinhado
+    memcpy( &key, pEl, sizeof(key) );
+    _prioq_siftUp( pQ, pQ->used, pEl, key );
+    pQ->used++;
+
+    return RES_SUCCESS;
+}
+
+res_t PrioQ_PushMany(prioq_t *pQ, const void *pEls, uint32_t pN)
+{
+    const uint8_t *el = (const uint8_t *)pEls;
+    uint32_t key;
+    uint32_t ii;
+
+    if( (pQ == NULL) || ((pEls == NULL) && (pN > 0)) )
+    {
+        return RES_ERROR;
+    }
+    if( !pQ->init )
+    {
+        return RES_ERROR;
+    }
+    if( pN > pQ->n - pQ->used )
+    {
+        return RES_ERR_OVERFLOW;
+    }
+
+    if( pN >= pQ->used )
+    {
+        //lote grande: acrescenta e reconstrói em O(n)
+        if( pN > 0 )
+        {
+            memcpy( PRIOQ_EL( pQ, pQ->used ), pEls, pN * pQ->eSz );
+        }
+        pQ->used += pN;
+        _prioq_heapify( pQ );
+    }
+    else
+    {
+        for(ii=0; ii < pN; ii++, el += pQ->eSz)
+        {
+            memcpy( &key, el, sizeof(key) );
+            _prioq_siftUp( pQ, pQ->used, el, key );
+            pQ->used++;
+        }
+    }
+
+    return RES_SUCCESS;
+}
+
+res_t PrioQ_Pop(prioq_t *pQ, void *pEl)
+{
+    if( pQ == NULL )
+    {
+        return RES_ERROR;
+    }
+    if( !pQ->init )
+    {
+        return RES_ERROR;
+    }
+    if( pQ->used == 0 )
+    {
+        return RES_ERR_NO_MORE_RECORDS;
+    }
+
+    _prioq_popRoot( pQ, pEl );
+
+    return RES_SUCCESS;
+}
+
+uint32_t PrioQ_PopUntil(prioq_t *pQ, uint32_t pKey, void *pEls, uint32_t pMax)
+{
+    uint8_t *el = (uint8_t *)pEls;
+    uint32_t n = 0;
+
+    if( pQ == NULL )
+    {
+        return 0;
+    }
+    if( !pQ->init )
+    {
+        return 0;
+    }
+
+    while( (n < pMax) && (pQ->used > 0) && (PRIOQ_KEY( PRIOQ_EL( pQ, 0 ) ) <= pKey) )
+    {
+        _prioq_popRoot( pQ, el );
+        if( el != NULL )
+        {
+            el += pQ->eSz;
+        }
+        n++;
+    }
+
+    return n;
+}
+
+void *PrioQ_Peek(prioq_t *pQ)
+{
+    if( pQ == NULL )
+    {
+        return NULL;
+    }
+    if( !pQ->init || (pQ->used == 0) )
+    {
+        return NULL;
+    }
+
+    return PRIOQ_EL( pQ, 0 );
+}
+
+void PrioQ_Flush(prioq_t *pQ)
+{
+    if( pQ == NULL )
+    {
+        return;
+    }
+
+    pQ->used = 0;
+}
+
+uint32_t PrioQ_Used(prioq_t *pQ)
+{
+    if( pQ == NULL )
+    {
+        return 0;
+    }
+    if( !pQ->init )
+    {
+        return 0;
+    }
+
+    return pQ->used;
+}
+
+uint32_t PrioQ_Free(prioq_t *pQ)
+{
+    return PrioQ_Sz(pQ) - PrioQ_Used(pQ);
+}
+
+uint32_t PrioQ_Sz(prioq_t *pQ)
+{
+    if( pQ == NULL )
+    {
+        return 0;
+    }
+    if( !pQ->init )
+    {
+        return 0;
+    }
+
+    return pQ->n;
+}
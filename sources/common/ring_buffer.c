@@ -1,20 +1,79 @@
 
 #include <string.h>
+#define RINGBUFF_IMPL
 #include "common/ring_buffer.h"
 
+#if defined(RINGBUFF_TRACE_ENABLE)
+#include "common/trace.h"
+#define RINGBUFF_TRACE( __ev, __rb, __n )   do { if( (__n) > 0 ) { TRACE( (__ev), (uintptr_t)(__rb), (__n) ); } } while(0)
+#else
+#define RINGBUFF_TRACE( __ev, __rb, __n )
+#endif
 
+#if defined(RINGBUFF_FREE_RUNNING)
+#define RINGBUFF_SZ(__rb)    ( (__rb)->mask + 1 )
+#else
 #define RINGBUFF_SZ(__rb)    ( (uint32_t)((__rb)->sz) / (uint32_t)((__rb)->eSz) )
+#endif
 
-static INLINE uint32_t _ringbuff_updateIndex( uint32_t pId, uint32_t pUpdateSz, uint32_t pMaxSz )
+/*
+ * Copies pBytes into the ring starting at byte offset pOff, wrapping at the
+ * end of the storage. Two memcpy at most. Returns the offset after the copy.
+ */
+static uint32_t _ringbuff_copyIn( ringbuff_t *pRb, uint32_t pOff, const void *pSrc, uint32_t pBytes )
 {
-    pId += pUpdateSz;
+    uint32_t cpSz = MIN( pBytes, pRb->sz - pOff );
 
-    if( pId >= pMaxSz )
+    memcpy( &((uint8_t*)pRb->data)[pOff], pSrc, cpSz );
+
+    if( cpSz < pBytes )
+    {
+        memcpy( pRb->data, &((const uint8_t*)pSrc)[cpSz], pBytes - cpSz );
+    }
+
+    return _ringbuff_updateIndex( pOff, pBytes, pRb->sz );
+}
+
+/*
+ * Copies pBytes out of the ring starting at byte offset pOff, wrapping at the
+ * end of the storage. Two memcpy at most. Returns the offset after the copy.
+ */
+static uint32_t _ringbuff_copyOut( const ringbuff_t *pRb, uint32_t pOff, void *pDst, uint32_t pBytes )
+{
+    uint32_t cpSz = MIN( pBytes, pRb->sz - pOff );
+
+    memcpy( pDst, &((const uint8_t*)pRb->data)[pOff], cpSz );
+
+    if( cpSz < pBytes )
     {
-        pId -= pMaxSz;
+        memcpy( &((uint8_t*)pDst)[cpSz], pRb->data, pBytes - cpSz );
+    }
+
+    return _ringbuff_updateIndex( pOff, pBytes, pRb->sz );
+}
+
+/*
+ * Sums the number of elements of a vector list. Returns 0 on overflow.
+ */
+static uint32_t _ringbuff_vecTotal( const ringbuff_vec_t *pVec, uint32_t pVecN )
+{
+    uint32_t ii;
+    uint32_t total = 0;
+
+    for(ii=0; ii < pVecN; ii++)
+    {
+        if( (pVec[ii].n > 0) && (pVec[ii].ptr == NULL) )
+        {
+            return 0;
+        }
+        if( total + pVec[ii].n < total )
+        {
+            return 0;
+        }
+        total += pVec[ii].n;
     }
 
-    return pId;
+    return total;
 }
 
 uint32_t RingBuff_Init(ringbuff_t *pRb, void * const pBuff, uint32_t pSz, uint8_t pElSz )
@@ -43,7 +102,20 @@ uint32_t RingBuff_Init(ringbuff_t *pRb, void * const pBuff, uint32_t pSz, uint8_
     pRb->data = pBuff;
     pRb->sz = (pSz - (pSz%pElSz));  //unaliged elements are NOT accepted
     pRb->eSz = pElSz;
-    pRb->head = pRb->tail = pRb->full = 0;
+#if defined(RINGBUFF_FREE_RUNNING)
+    //os indices correm livres: o numero de elementos precisa ser potencia de 2
+    pRb->mask = pRb->sz/pRb->eSz;
+    while( pRb->mask & (pRb->mask - 1) )
+    {
+        pRb->mask &= (pRb->mask - 1);
+    }
+    pRb->sz = pRb->mask * pRb->eSz;
+    pRb->mask -= 1;
+#endif
+#if defined(RINGBUFF_NOTIFY)
+    pRb->ntf = NULL;
+#endif
+    _ringbuff_resetK( pRb );
     pRb->init = true;
     return pRb->sz/pRb->eSz;
 }
@@ -51,8 +123,6 @@ uint32_t RingBuff_Init(ringbuff_t *pRb, void * const pBuff, uint32_t pSz, uint8_
 
 uint32_t RingBuff_WrOne(ringbuff_t *pRb, void * const pEl, bool_t pOw )
 {
-    uint8_t *ptr;
-
     if( pRb == NULL )
     {
         return 0;
@@ -62,37 +132,93 @@ uint32_t RingBuff_WrOne(ringbuff_t *pRb, void * const pEl, bool_t pOw )
         return 0;
     }
 
-    if( RingBuff_IsFull(pRb) )
+#if defined(RINGBUFF_TRACE_ENABLE)
+    if( _ringbuff_isFullK( pRb, _RINGBUFF_GEOM( pRb ) ) )
     {
+        RINGBUFF_TRACE( pOw ? TRACE_EV_RB_OVERWRITE : TRACE_EV_RB_REJECT, pRb, 1 );
         if( !pOw )
         {
-            //não adiciona o item
             return 0;
         }
-        else
+    }
+    RINGBUFF_TRACE( TRACE_EV_RB_WR, pRb, 1 );
+#endif
+
+    return _ringbuff_wrOneK( pRb, pEl, pOw, _RINGBUFF_GEOM( pRb ) );
+}
+
+
+uint32_t RingBuff_WrMany(ringbuff_t *pRb, const void * const pWrBuff, uint32_t pN, bool_t pOw )
+{
+    const uint8_t *ptr = (const uint8_t *)pWrBuff;
+    uint32_t result;
+    uint32_t freeN;
+
+    if( pWrBuff == NULL )
+    {
+        return 0;
+    }
+    if( pRb == NULL )
+    {
+        return 0;
+    }
+    if( !pRb->init )
+    {
+        return 0;
+    }
+
+    freeN = RingBuff_Free(pRb);
+
+    if( !pOw )
+    {
+        //não adiciona alem da conta
+        result = MIN( freeN, pN );
+        if( result < pN )
         {
-            //sobrescreve o início do buffer
-            pRb->head = _ringbuff_updateIndex( pRb->head, pRb->eSz, pRb->sz );
+            RINGBUFF_TRACE( TRACE_EV_RB_REJECT, pRb, pN - result );
         }
+        pN = result;
     }
+    else
+    {
+        result = pN;
 
-    ptr = &((uint8_t*)pRb->data)[pRb->tail];
+        //somente os ultimos elementos sobrevivem
+        if( pN > RINGBUFF_SZ(pRb) )
+        {
+            ptr = &ptr[ (pN - RINGBUFF_SZ(pRb)) * pRb->eSz ];
+            pN = RINGBUFF_SZ(pRb);
+        }
+        if( pN > freeN )
+        {
+            //sobrescreve o início do buffer
+            RINGBUFF_TRACE( TRACE_EV_RB_OVERWRITE, pRb, pN - freeN );
+            _ringbuff_advHeadK( pRb, pN - freeN, _RINGBUFF_GEOM( pRb ) );
+        }
+    }
 
-    memcpy(ptr, pEl, pRb->eSz);
+    if( pN == 0 )
+    {
+        return 0;
+    }
 
-    pRb->tail = _ringbuff_updateIndex(pRb->tail, pRb->eSz, pRb->sz);
-    pRb->full = pRb->head == pRb->tail;
+    _ringbuff_copyIn( pRb, _ringbuff_tailOffK( pRb, _RINGBUFF_GEOM( pRb ) ), ptr, pN * pRb->eSz );
+    _ringbuff_advTailK( pRb, pN, _RINGBUFF_GEOM( pRb ) );
+    _ringbuff_notifyK( pRb );
+    RINGBUFF_TRACE( TRACE_EV_RB_WR, pRb, pN );
 
-    return 1;
+    return result;
 }
 
 
-uint32_t RingBuff_WrMany(ringbuff_t *pRb, const void * const pWrBuff, uint32_t pN, bool_t pOw )
+uint32_t RingBuff_WrV(ringbuff_t *pRb, const ringbuff_vec_t *pVec, uint32_t pVecN, bool_t pOw )
 {
     uint32_t ii;
-    uint8_t *ptr = (uint8_t *)pWrBuff;
+    uint32_t total;
+    uint32_t freeN;
+    uint32_t off;
 
-    if( pWrBuff == NULL )
+    if( pVec == NULL )
     {
         return 0;
     }
@@ -105,15 +231,101 @@ uint32_t RingBuff_WrMany(ringbuff_t *pRb, const void * const pWrBuff, uint32_t p
         return 0;
     }
 
-    for(ii=0; ii < pN; ii++)
+    total = _ringbuff_vecTotal( pVec, pVecN );
+    if( total == 0 )
+    {
+        return 0;
+    }
+
+    freeN = RingBuff_Free(pRb);
+    if( total > freeN )
     {
-        if( 0 == RingBuff_WrOne(pRb, &ptr[(ii*pRb->eSz)], pOw) )
+        //tudo ou nada: nunca admite um lote parcial
+        if( !pOw || (total > RINGBUFF_SZ(pRb)) )
         {
-            break;
+            RINGBUFF_TRACE( TRACE_EV_RB_REJECT, pRb, total );
+            return 0;
         }
+        RINGBUFF_TRACE( TRACE_EV_RB_OVERWRITE, pRb, total - freeN );
+        _ringbuff_advHeadK( pRb, total - freeN, _RINGBUFF_GEOM( pRb ) );
     }
-    return ii;
 
+    off = _ringbuff_tailOffK( pRb, _RINGBUFF_GEOM( pRb ) );
+    for(ii=0; ii < pVecN; ii++)
+    {
+        if( pVec[ii].n > 0 )
+        {
+            off = _ringbuff_copyIn( pRb, off, pVec[ii].ptr, pVec[ii].n * pRb->eSz );
+        }
+    }
+
+    _ringbuff_advTailK( pRb, total, _RINGBUFF_GEOM( pRb ) );
+    _ringbuff_notifyK( pRb );
+    RINGBUFF_TRACE( TRACE_EV_RB_WR, pRb, total );
+
+    return total;
+}
+
+
+uint32_t RingBuff_WrReserve(ringbuff_t *pRb, uint32_t pN, ringbuff_vec_t pSegs[2])
+{
+    uint32_t off;
+    uint32_t segN;
+
+    if( pSegs == NULL )
+    {
+        return 0;
+    }
+
+    pSegs[0].ptr = pSegs[1].ptr = NULL;
+    pSegs[0].n = pSegs[1].n = 0;
+
+    pN = MIN( pN, RingBuff_Free(pRb) );
+    if( pN == 0 )
+    {
+        return 0;
+    }
+
+    off = _ringbuff_tailOffK( pRb, _RINGBUFF_GEOM( pRb ) );
+
+    //  |-----t=====================o-------| primeiro segmento ate o final
+    //  |=====t-----------------------------| segundo segmento a partir do início
+    segN = MIN( pN, (pRb->sz - off) / pRb->eSz );
+
+    pSegs[0].ptr = &((uint8_t*)pRb->data)[off];
+    pSegs[0].n = segN;
+
+    if( segN < pN )
+    {
+        pSegs[1].ptr = pRb->data;
+        pSegs[1].n = pN - segN;
+    }
+
+    return pN;
+}
+
+
+uint32_t RingBuff_WrCommit(ringbuff_t *pRb, uint32_t pN)
+{
+    if( pRb == NULL )
+    {
+        return 0;
+    }
+    if( !pRb->init )
+    {
+        return 0;
+    }
+
+    pN = MIN( pN, RingBuff_Free(pRb) );
+
+    _ringbuff_advTailK( pRb, pN, _RINGBUFF_GEOM( pRb ) );
+    if( pN > 0 )
+    {
+        _ringbuff_notifyK( pRb );
+    }
+    RINGBUFF_TRACE( TRACE_EV_RB_WR, pRb, pN );
+
+    return pN;
 }
 
 
@@ -146,28 +358,30 @@ uint32_t RingBuff_WrMany2(ringbuff_t *pRb, const void *pWrBuff, uint32_t pN, boo
 
 uint32_t RingBuff_RdOnePtr(ringbuff_t *pRb, void **pEl)
 {
-    uint8_t *ptr;
+    void *ptr;
 
     if( pRb == NULL )
     {
         return 0;
     }
-    if( RingBuff_IsEmpty(pRb) )
+    if( !pRb->init )
     {
         return 0;
     }
 
-    ptr = &((uint8_t*)pRb->data)[pRb->head];
-
-    pRb->head = _ringbuff_updateIndex(pRb->head, pRb->eSz, pRb->sz);
-    pRb->full = 0;
+    ptr = _ringbuff_rdOnePtrK( pRb, _RINGBUFF_GEOM( pRb ) );
+    if( ptr == NULL )
+    {
+        return 0;
+    }
+    RINGBUFF_TRACE( TRACE_EV_RB_RD, pRb, 1 );
 
     if( pEl == NULL )
     {
     }
     else
     {
-        *pEl = (void *)ptr;
+        *pEl = ptr;
     }
 
     return 1;
@@ -176,48 +390,228 @@ uint32_t RingBuff_RdOnePtr(ringbuff_t *pRb, void **pEl)
 
 uint32_t RingBuff_RdOne(ringbuff_t *pRb, void *pEl)
 {
-    uint8_t *ptr;
+    if( pRb == NULL )
+    {
+        return 0;
+    }
+    if( !pRb->init )
+    {
+        return 0;
+    }
+
+#if defined(RINGBUFF_TRACE_ENABLE)
+    if( _ringbuff_usedK( pRb, _RINGBUFF_GEOM( pRb ) ) > 0 )
+    {
+        RINGBUFF_TRACE( TRACE_EV_RB_RD, pRb, 1 );
+    }
+#endif
+
+    return _ringbuff_rdOneK( pRb, pEl, _RINGBUFF_GEOM( pRb ) );
+}
 
+
+uint32_t RingBuff_RdAdvance(ringbuff_t *pRb, void *pRdBuff, uint32_t pN)
+{
     if( pRb == NULL )
     {
         return 0;
     }
-    if( RingBuff_IsEmpty(pRb) )
+    if( !pRb->init )
     {
         return 0;
     }
 
-    ptr = &((uint8_t*)pRb->data)[pRb->head];
+    pN = MIN( pN, RingBuff_Used(pRb) );
+
+    if( pRdBuff != NULL )
+    {
+        _ringbuff_copyOut( pRb, _ringbuff_headOffK( pRb, _RINGBUFF_GEOM( pRb ) ), pRdBuff, pN * pRb->eSz );
+    }
+
+    return pN;
+}
 
-    pRb->head = _ringbuff_updateIndex(pRb->head, pRb->eSz, pRb->sz);
-    pRb->full = 0;
 
-    if( pEl == NULL )
+uint32_t RingBuff_RdLatest(ringbuff_t *pRb, void *pRdBuff, uint32_t pN)
+{
+    uint32_t used;
+
+    if( (pRb == NULL) || (pRdBuff == NULL) )
     {
+        return 0;
     }
-    else
+    if( !pRb->init )
     {
-        memcpy(pEl, ptr, pRb->eSz);
+        return 0;
     }
 
-    return 1;
+    used = RingBuff_Used(pRb);
+    pN = MIN( pN, used );
+
+    //  |=====t---------------------h====o==| os N mais novos terminam no tail
+    _ringbuff_copyOut( pRb, _ringbuff_updateIndex( _ringbuff_headOffK( pRb, _RINGBUFF_GEOM( pRb ) ), (used - pN) * pRb->eSz, pRb->sz ),
+                       pRdBuff, pN * pRb->eSz );
+
+    return pN;
 }
 
 
-uint32_t RingBuff_RdAdvance(ringbuff_t *pRb, void *pRdBuff, uint32_t pN)
+#if defined(RINGBUFF_FREE_RUNNING)
+uint32_t RingBuff_RdLatestSnap(ringbuff_t *pRb, void *pRdBuff, uint32_t pN, uint32_t pTries)
 {
-    ringbuff_t rb;
-    memcpy(&rb, pRb, sizeof(rb));
-    return RingBuff_RdMany( &rb, pRdBuff, pN );
+    uint32_t tail;
+    uint32_t used;
+    uint32_t n;
+
+    if( (pRb == NULL) || (pRdBuff == NULL) )
+    {
+        return 0;
+    }
+    if( !pRb->init )
+    {
+        return 0;
+    }
+
+    while( pTries-- )
+    {
+        //o tail antes do head: o head só avança, então used nunca é superestimado
+        tail = __atomic_load_n( &pRb->tail, __ATOMIC_ACQUIRE );
+        used = tail - __atomic_load_n( &pRb->head, __ATOMIC_ACQUIRE );
+        n = MIN( pN, MIN( used, pRb->mask + 1 ) );
+
+        _ringbuff_copyOut( pRb, ((tail - n) & pRb->mask) * pRb->eSz, pRdBuff, n * pRb->eSz );
+
+        //o que o produtor escreveu durante a cópia não pode ter alcançado os copiados
+        __atomic_thread_fence( __ATOMIC_ACQUIRE );
+        if( __atomic_load_n( &pRb->tail, __ATOMIC_RELAXED ) - tail <= pRb->mask + 1 - n )
+        {
+            return n;
+        }
+    }
+
+    return 0;
 }
+#endif
 
 
-uint32_t RingBuff_RdMany(ringbuff_t *pRb, void *pRdBuff, uint32_t pN)
+uint32_t RingBuff_PeekSegs(ringbuff_t *pRb, uint32_t pIdx, uint32_t pN, ringbuff_vec_t pSegs[2])
 {
-    uint32_t result;
-    uint8_t *ptr = pRdBuff;
-    uint32_t cpSz;
+    uint32_t used;
+    uint32_t off;
+    uint32_t segN;
+
+    if( pSegs == NULL )
+    {
+        return 0;
+    }
+
+    pSegs[0].ptr = pSegs[1].ptr = NULL;
+    pSegs[0].n = pSegs[1].n = 0;
+
+    used = RingBuff_Used(pRb);
+    if( pIdx >= used )
+    {
+        return 0;
+    }
+
+    pN = MIN( pN, used - pIdx );
+    off = _ringbuff_updateIndex( _ringbuff_headOffK( pRb, _RINGBUFF_GEOM( pRb ) ), pIdx * pRb->eSz, pRb->sz );
+
+    //  |=====t---------------------o=======| primeiro segmento ate o final
+    //  |=====t-----------------------------| segundo segmento a partir do início
+    segN = MIN( pN, (pRb->sz - off) / pRb->eSz );
+
+    pSegs[0].ptr = &((uint8_t*)pRb->data)[off];
+    pSegs[0].n = segN;
+
+    if( segN < pN )
+    {
+        pSegs[1].ptr = pRb->data;
+        pSegs[1].n = pN - segN;
+    }
+
+    return pN;
+}
+
+
+void *RingBuff_PeekAt(ringbuff_t *pRb, uint32_t pIdx)
+{
+    if( pIdx >= RingBuff_Used(pRb) )
+    {
+        return NULL;
+    }
+
+    return &((uint8_t*)pRb->data)[ _ringbuff_updateIndex( _ringbuff_headOffK( pRb, _RINGBUFF_GEOM( pRb ) ),
+                                                          pIdx * pRb->eSz, pRb->sz ) ];
+}
+
+
+uint32_t RingBuff_FindByte(ringbuff_t *pRb, uint32_t pFrom, uint8_t pByte)
+{
+    ringbuff_vec_t seg[2];
+    uint32_t ii;
+    uint32_t idx = pFrom;
+    uint8_t *found;
+
+    if( RingBuff_PeekSegs( pRb, pFrom, UINT32_MAX, seg ) == 0 )
+    {
+        return RINGBUFF_NOT_FOUND;
+    }
+
+    for(ii=0; (ii < NELEMENTS(seg)) && (seg[ii].n > 0); ii++)
+    {
+        found = memchr( seg[ii].ptr, pByte, seg[ii].n * pRb->eSz );
+        if( found != NULL )
+        {
+            return idx + (uint32_t)(found - (uint8_t*)seg[ii].ptr) / pRb->eSz;
+        }
+        idx += seg[ii].n;
+    }
+
+    return RINGBUFF_NOT_FOUND;
+}
+
+
+uint32_t RingBuff_FindElem(ringbuff_t *pRb, uint32_t pFrom, const void *pEl)
+{
+    ringbuff_vec_t seg[2];
+    uint32_t ii;
+    uint32_t jj;
+    uint32_t idx = pFrom;
+    const uint8_t *ptr;
+    uint8_t first;
+
+    if( pEl == NULL )
+    {
+        return RINGBUFF_NOT_FOUND;
+    }
+    if( RingBuff_PeekSegs( pRb, pFrom, UINT32_MAX, seg ) == 0 )
+    {
+        return RINGBUFF_NOT_FOUND;
+    }
+
+    first = *(const uint8_t*)pEl;
+
+    for(ii=0; ii < NELEMENTS(seg); ii++)
+    {
+        ptr = seg[ii].ptr;
+        for(jj=0; jj < seg[ii].n; jj++, ptr += pRb->eSz)
+        {
+            //compara o primeiro byte antes de chamar memcmp
+            if( (*ptr == first) && (memcmp( ptr, pEl, pRb->eSz ) == 0) )
+            {
+                return idx + jj;
+            }
+        }
+        idx += seg[ii].n;
+    }
+
+    return RINGBUFF_NOT_FOUND;
+}
+
 
+uint32_t RingBuff_RdMany(ringbuff_t *pRb, void *pRdBuff, uint32_t pN)
+{
     if( pRdBuff == NULL )
     {
         return RingBuff_Discard( pRb, pN );
@@ -233,46 +627,59 @@ uint32_t RingBuff_RdMany(ringbuff_t *pRb, void *pRdBuff, uint32_t pN)
         return 0;
     }
 
-    result = pN = MIN( pN, RingBuff_Used(pRb) );
+    pN = MIN( pN, RingBuff_Used(pRb) );
 
     //segmenta em duas partes: ate o final do buffer e então do início ate o meio.
     // assim: h = head t = tail
     //
-    //  |=====t---------------------h=======| pega o tail ate o final
-    //  |h====t-----------------------------| pega o início ate o head
-    //  |----ht-----------------------------|
-
-    if( pRb->head + (pRb->eSz * pN) > pRb->sz )
-    {
-        ptr = &((uint8_t*)pRb->data)[pRb->head];
+    //  |=====t---------------------h=======| pega o head ate o final
+    //  |=====t-----------------------------| pega o início ate o tail
+    _ringbuff_copyOut( pRb, _ringbuff_headOffK( pRb, _RINGBUFF_GEOM( pRb ) ), pRdBuff, pN * pRb->eSz );
+    _ringbuff_advHeadK( pRb, pN, _RINGBUFF_GEOM( pRb ) );
+    RINGBUFF_TRACE( TRACE_EV_RB_RD, pRb, pN );
 
-        cpSz = pRb->sz - pRb->head;
-
-        memcpy(pRdBuff, ptr, cpSz);
+    return pN;
+}
 
-        //por isso o buffer precisa estar alinhado!
-        pRb->head = _ringbuff_updateIndex(pRb->head, cpSz, pRb->sz );
-        pRb->full = 0;
 
-        pRdBuff = &(((uint8_t*)pRdBuff)[cpSz]);
+uint32_t RingBuff_RdV(ringbuff_t *pRb, const ringbuff_vec_t *pVec, uint32_t pVecN)
+{
+    uint32_t ii;
+    uint32_t total;
+    uint32_t off;
 
-        //numero de elementos retirados:
-        pN -= (cpSz/pRb->eSz);
+    if( pVec == NULL )
+    {
+        return 0;
+    }
+    if( pRb == NULL )
+    {
+        return 0;
+    }
+    if( !pRb->init )
+    {
+        return 0;
     }
 
-    ptr = &((uint8_t*)pRb->data)[pRb->head];
-
-    cpSz = (pN*pRb->eSz);
-
-    memcpy(pRdBuff, ptr, cpSz);
+    total = _ringbuff_vecTotal( pVec, pVecN );
+    if( (total == 0) || (total > RingBuff_Used(pRb)) )
+    {
+        return 0;
+    }
 
-    pRb->head = _ringbuff_updateIndex(pRb->head, cpSz, pRb->sz );
-    if( pN > 0 )
+    off = _ringbuff_headOffK( pRb, _RINGBUFF_GEOM( pRb ) );
+    for(ii=0; ii < pVecN; ii++)
     {
-        pRb->full = 0;
+        if( pVec[ii].n > 0 )
+        {
+            off = _ringbuff_copyOut( pRb, off, pVec[ii].ptr, pVec[ii].n * pRb->eSz );
+        }
     }
 
-    return result;
+    _ringbuff_advHeadK( pRb, total, _RINGBUFF_GEOM( pRb ) );
+    RINGBUFF_TRACE( TRACE_EV_RB_RD, pRb, total );
+
+    return total;
 }
 
 
@@ -286,11 +693,8 @@ uint32_t RingBuff_Discard(ringbuff_t *pRb, uint32_t pN)
 
     pN = MIN( pN, RingBuff_Used(pRb) );
 
-    pRb->head = _ringbuff_updateIndex(pRb->head, pN*pRb->eSz, pRb->sz );
-    if( pN > 0 )
-    {
-        pRb->full = 0;
-    }
+    _ringbuff_advHeadK( pRb, pN, _RINGBUFF_GEOM( pRb ) );
+    RINGBUFF_TRACE( TRACE_EV_RB_RD, pRb, pN );
 
     return pN;
 
@@ -304,7 +708,7 @@ void RingBuff_Flush(ringbuff_t *pRb)
         return;
     }
 
-    pRb->head = pRb->tail = pRb->full = 0;
+    _ringbuff_resetK( pRb );
 
     return;
 }
@@ -320,18 +724,7 @@ uint32_t RingBuff_Used(ringbuff_t *pRb)
         return 0;
     }
 
-    if( (pRb->head == pRb->tail) && !(pRb->full) )
-    {
-        return 0;
-    }
-    else if(pRb->tail > pRb->head)
-    {
-        return ((pRb->tail - pRb->head) / pRb->eSz);
-    }
-    else
-    {
-        return ((pRb->sz - (pRb->head - pRb->tail)) / pRb->eSz);
-    }
+    return _ringbuff_usedK( pRb, _RINGBUFF_GEOM( pRb ) );
 }
 
 uint32_t RingBuff_Free(ringbuff_t *pRb)
@@ -355,7 +748,16 @@ bool_t RingBuff_IsEmpty(ringbuff_t *pRb)
 
 bool_t RingBuff_IsFull(ringbuff_t *pRb)
 {
-    return (bool_t)(RingBuff_Sz(pRb) == RingBuff_Used(pRb));
+    if( pRb == NULL )
+    {
+        return true;
+    }
+    if( !pRb->init )
+    {
+        return true;
+    }
+
+    return _ringbuff_isFullK( pRb, _RINGBUFF_GEOM( pRb ) );
 }
 
 uint32_t RingBuff_Sz(ringbuff_t *pRb)
@@ -375,3 +777,135 @@ uint32_t RingBuff_Sz(ringbuff_t *pRb)
 
 }
 
+#if defined(RINGBUFF_NOTIFY)
+void RingBuff_SetNotify(ringbuff_t *pRb, volatile uint32_t *pFlags, uint32_t pMask)
+{
+    if( pRb == NULL )
+    {
+        return;
+    }
+
+    pRb->ntfMask = pMask;
+    pRb->ntf = pFlags;
+}
+#endif
+
+#if defined(ARCH_HAS_CRIT)
+uint32_t RingBuff_WrManyLocked(ringbuff_t *pRb, arch_lock_t *pLock, const void * const pWrBuff, uint32_t pN)
+{
+    arch_crit_t st;
+    uint32_t freeN = 0;
+    uint32_t off = 0;
+    uint32_t eSz = 0;
+
+    if( (pRb == NULL) || (pLock == NULL) || (pWrBuff == NULL) )
+    {
+        return 0;
+    }
+
+    //init e eSz dividem o byte do flag full, escrito pelo outro lado
+    st = Arch_CritEnter( pLock );
+    if( pRb->init )
+    {
+        freeN = RINGBUFF_SZ(pRb) - _ringbuff_usedK( pRb, _RINGBUFF_GEOM( pRb ) );
+        off = _ringbuff_tailOffK( pRb, _RINGBUFF_GEOM( pRb ) );
+        eSz = pRb->eSz;
+    }
+    Arch_CritExit( pLock, st );
+
+    if( pN > freeN )
+    {
+        RINGBUFF_TRACE( TRACE_EV_RB_REJECT, pRb, pN - freeN );
+        pN = freeN;
+    }
+    if( pN == 0 )
+    {
+        return 0;
+    }
+
+    //o consumidor não toca na área livre: copia fora da seção crítica
+    _ringbuff_copyIn( pRb, off, pWrBuff, pN * eSz );
+
+    st = Arch_CritEnter( pLock );
+    _ringbuff_advTailK( pRb, pN, _RINGBUFF_GEOM( pRb ) );
+    Arch_CritExit( pLock, st );
+
+    _ringbuff_notifyK( pRb );
+    RINGBUFF_TRACE( TRACE_EV_RB_WR, pRb, pN );
+
+    return pN;
+}
+
+uint32_t RingBuff_WrOneLocked(ringbuff_t *pRb, arch_lock_t *pLock, const void * const pEl)
+{
+    return RingBuff_WrManyLocked( pRb, pLock, pEl, 1 );
+}
+
+uint32_t RingBuff_RdManyLocked(ringbuff_t *pRb, arch_lock_t *pLock, void *pRdBuff, uint32_t pN)
+{
+    arch_crit_t st;
+    uint32_t used = 0;
+    uint32_t off = 0;
+    uint32_t eSz = 0;
+
+    if( (pRb == NULL) || (pLock == NULL) )
+    {
+        return 0;
+    }
+
+    st = Arch_CritEnter( pLock );
+    if( pRb->init )
+    {
+        used = _ringbuff_usedK( pRb, _RINGBUFF_GEOM( pRb ) );
+        off = _ringbuff_headOffK( pRb, _RINGBUFF_GEOM( pRb ) );
+        eSz = pRb->eSz;
+    }
+    Arch_CritExit( pLock, st );
+
+    pN = MIN( pN, used );
+    if( pN == 0 )
+    {
+        return 0;
+    }
+
+    //o produtor não toca nos elementos ocupados: copia fora da seção crítica
+    if( pRdBuff != NULL )
+    {
+        _ringbuff_copyOut( pRb, off, pRdBuff, pN * eSz );
+    }
+
+    st = Arch_CritEnter( pLock );
+    _ringbuff_advHeadK( pRb, pN, _RINGBUFF_GEOM( pRb ) );
+    Arch_CritExit( pLock, st );
+
+    RINGBUFF_TRACE( TRACE_EV_RB_RD, pRb, pN );
+
+    return pN;
+}
+
+uint32_t RingBuff_RdOneLocked(ringbuff_t *pRb, arch_lock_t *pLock, void *pEl)
+{
+    return RingBuff_RdManyLocked( pRb, pLock, pEl, 1 );
+}
+
+uint32_t RingBuff_UsedLocked(ringbuff_t *pRb, arch_lock_t *pLock)
+{
+    arch_crit_t st;
+    uint32_t used = 0;
+
+    if( (pRb == NULL) || (pLock == NULL) )
+    {
+        return 0;
+    }
+
+    st = Arch_CritEnter( pLock );
+    if( pRb->init )
+    {
+        used = _ringbuff_usedK( pRb, _RINGBUFF_GEOM( pRb ) );
+    }
+    Arch_CritExit( pLock, st );
+
+    return used;
+}
+#endif
+
@@ -0,0 +1,219 @@
+
+#include <string.h>
+#include "common/ring_buffer_dma.h"
+
+
+/*
+ * Gets the free-running DMA write position.
+ */
+static uint32_t _ringbuffdma_pos( ringbuff_dma_t *pRb )
+{
+    uint32_t laps;
+    uint32_t rem;
+    uint32_t pos;
+
+    //le de novo se a interrupcao de volta completa ocorreu no meio
+    do
+    {
+        laps = pRb->laps;
+        rem = pRb->remaining( pRb->ctx );
+    }while( laps != pRb->laps );
+
+    pos = (laps * pRb->n) + (pRb->n - MIN( rem, pRb->n ));
+
+    //o DMA deu a volta mas a interrupcao ainda esta pendente
+    if( (int32_t)(pos - pRb->tail) < 0 )
+    {
+        pos += pRb->n;
+    }
+
+    return pos;
+}
+
+/*
+ * Updates tail from the hardware. On overrun, drops the unread elements.
+ */
+static uint32_t _ringbuffdma_sync( ringbuff_dma_t *pRb )
+{
+    pRb->tail = _ringbuffdma_pos( pRb );
+
+    if( (pRb->tail - pRb->head) > pRb->n )
+    {
+        pRb->overruns++;
+        pRb->headSlot = (pRb->headSlot + (pRb->tail - pRb->head)) % pRb->n;
+        pRb->head = pRb->tail;
+    }
+
+    return pRb->tail - pRb->head;
+}
+
+static void _ringbuffdma_advHead( ringbuff_dma_t *pRb, uint32_t pN )
+{
+    pRb->head += pN;
+    pRb->headSlot += pN;
+    if( pRb->headSlot >= pRb->n )
+    {
+        pRb->headSlot -= pRb->n;
+    }
+}
+
+uint32_t RingBuffDma_Init(ringbuff_dma_t *pRb, void * const pBuff, uint32_t pSz, uint8_t pElSz,
+                          ringbuff_dma_remaining_t pRemaining, void *pCtx)
+{
+    if( pRb == NULL )
+    {
+        return 0;
+    }
+    if( pBuff == NULL )
+    {
+        return 0;
+    }
+    if( pRemaining == NULL )
+    {
+        return 0;
+    }
+    if( pElSz == 0 )
+    {
+        return 0;
+    }
+    if( pSz < pElSz )
+    {
+        return 0;
+    }
+
+    pRb->data = pBuff;
+    pRb->n = pSz / pElSz;
+    pRb->eSz = pElSz;
+    pRb->remaining = pRemaining;
+    pRb->ctx = pCtx;
+    pRb->laps = pRb->head = pRb->headSlot = pRb->tail = pRb->overruns = 0;
+    pRb->init = true;
+
+    return pRb->n;
+}
+
+void RingBuffDma_LapIsr(ringbuff_dma_t *pRb)
+{
+    pRb->laps++;
+}
+
+uint32_t RingBuffDma_Used(ringbuff_dma_t *pRb)
+{
+    if( pRb == NULL )
+    {
+        return 0;
+    }
+    if( !pRb->init )
+    {
+        return 0;
+    }
+
+    return _ringbuffdma_sync( pRb );
+}
+
+uint32_t RingBuffDma_RdMany(ringbuff_dma_t *pRb, void *pRdBuff, uint32_t pN)
+{
+    uint32_t n1;
+
+    if( pRdBuff == NULL )
+    {
+        return RingBuffDma_Discard( pRb, pN );
+    }
+    if( pRb == NULL )
+    {
+        return 0;
+    }
+    if( !pRb->init )
+    {
+        return 0;
+    }
+
+    pN = MIN( pN, _ringbuffdma_sync( pRb ) );
+    if( pN == 0 )
+    {
+        return 0;
+    }
+
+    //  |=====t---------------------h=======| pega o head ate o final
+    //  |=====t-----------------------------| pega o início ate o tail
+    n1 = MIN( pN, pRb->n - pRb->headSlot );
+    memcpy( pRdBuff, &((uint8_t*)pRb->data)[pRb->headSlot * pRb->eSz], n1 * pRb->eSz );
+    memcpy( &((uint8_t*)pRdBuff)[n1 * pRb->eSz], pRb->data, (pN - n1) * pRb->eSz );
+
+    //o DMA pode ter sobrescrito os elementos durante a copia
+    if( (_ringbuffdma_pos( pRb ) - pRb->head) >= pRb->n )
+    {
+        _ringbuffdma_sync( pRb );
+        pRb->overruns++;
+        return 0;
+    }
+
+    _ringbuffdma_advHead( pRb, pN );
+
+    return pN;
+}
+
+uint32_t RingBuffDma_RdPtr(ringbuff_dma_t *pRb, void **pEl)
+{
+    uint32_t used;
+
+    if( pRb == NULL )
+    {
+        return 0;
+    }
+    if( !pRb->init )
+    {
+        return 0;
+    }
+
+    used = _ringbuffdma_sync( pRb );
+
+    if( pEl != NULL )
+    {
+        *pEl = &((uint8_t*)pRb->data)[pRb->headSlot * pRb->eSz];
+    }
+
+    return MIN( used, pRb->n - pRb->headSlot );
+}
+
+uint32_t RingBuffDma_Discard(ringbuff_dma_t *pRb, uint32_t pN)
+{
+    if( pRb == NULL )
+    {
+        return 0;
+    }
+    if( !pRb->init )
+    {
+        return 0;
+    }
+
+    pN = MIN( pN, _ringbuffdma_sync( pRb ) );
+
+    _ringbuffdma_advHead( pRb, pN );
+
+    return pN;
+}
+
+uint32_t RingBuffDma_Overruns(ringbuff_dma_t *pRb)
+{
+    if( pRb == NULL )
+    {
+        return 0;
+    }
+
+    return pRb->overruns;
+}
+
+uint32_t RingBuffDma_Sz(ringbuff_dma_t *pRb)
+{
+    if( pRb == NULL )
+    {
+        return 0;
+    }
+    if( !pRb->init )
+    {
+        return 0;
+    }
+
+    return pRb->n;
+}
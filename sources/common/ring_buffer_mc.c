@@ -0,0 +1,199 @@
+
+#include <string.h>
+#include "common/ring_buffer_mc.h"
+
+
+#define RINGBUFFMC_LOAD(__ptr)          __atomic_load_n( (__ptr), __ATOMIC_ACQUIRE )
+#define RINGBUFFMC_STORE(__ptr, __val)  __atomic_store_n( (__ptr), (__val), __ATOMIC_RELEASE )
+
+/*
+ * Copies pN elements into the ring, starting at the free-running index pId.
+ * Two memcpy at most.
+ */
+static void _ringbuffmc_copyIn( ringbuff_mc_t *pRb, uint32_t pId, const uint8_t *pSrc, uint32_t pN )
+{
+    uint32_t slot = pId & pRb->cfg.mask;
+    uint32_t n1 = MIN( pN, pRb->cfg.mask + 1 - slot );
+
+    memcpy( &((uint8_t*)pRb->cfg.data)[slot * pRb->cfg.eSz], pSrc, n1 * pRb->cfg.eSz );
+    memcpy( pRb->cfg.data, &pSrc[n1 * pRb->cfg.eSz], (pN - n1) * pRb->cfg.eSz );
+}
+
+/*
+ * Copies pN elements out of the ring, starting at the free-running index pId.
+ * Two memcpy at most.
+ */
+static void _ringbuffmc_copyOut( ringbuff_mc_t *pRb, uint32_t pId, uint8_t *pDst, uint32_t pN )
+{
+    uint32_t slot = pId & pRb->cfg.mask;
+    uint32_t n1 = MIN( pN, pRb->cfg.mask + 1 - slot );
+
+    memcpy( pDst, &((uint8_t*)pRb->cfg.data)[slot * pRb->cfg.eSz], n1 * pRb->cfg.eSz );
+    memcpy( &pDst[n1 * pRb->cfg.eSz], pRb->cfg.data, (pN - n1) * pRb->cfg.eSz );
+}
+
+uint32_t RingBuffMc_Init(ringbuff_mc_t *pRb, void * const pBuff, uint32_t pSz, uint8_t pElSz)
+{
+    uint32_t n;
+
+    if( pRb == NULL )
+    {
+        return 0;
+    }
+    if( pBuff == NULL )
+    {
+        return 0;
+    }
+    if( pElSz == 0 )
+    {
+        return 0;
+    }
+    if( pSz < pElSz )
+    {
+        return 0;
+    }
+
+    //os indices correm livres: o numero de elementos precisa ser potencia de 2
+    n = pSz / pElSz;
+    while( n & (n - 1) )
+    {
+        n &= (n - 1);
+    }
+
+    pRb->cfg.data = pBuff;
+    pRb->cfg.mask = n - 1;
+    pRb->cfg.eSz = pElSz;
+    pRb->rd.head = pRb->rd.tailCache = 0;
+    pRb->wr.tail = pRb->wr.headCache = 0;
+    pRb->cfg.init = true;
+
+    return n;
+}
+
+uint32_t RingBuffMc_WrOne(ringbuff_mc_t *pRb, const void * const pEl)
+{
+    return RingBuffMc_WrMany( pRb, pEl, 1 );
+}
+
+uint32_t RingBuffMc_WrMany(ringbuff_mc_t *pRb, const void * const pWrBuff, uint32_t pN)
+{
+    uint32_t tail;
+    uint32_t freeN;
+
+    if( pRb == NULL )
+    {
+        return 0;
+    }
+    if( pWrBuff == NULL )
+    {
+        return 0;
+    }
+    if( !pRb->cfg.init )
+    {
+        return 0;
+    }
+
+    //somente o produtor escreve o tail
+    tail = pRb->wr.tail;
+    freeN = pRb->cfg.mask + 1 - (tail - pRb->wr.headCache);
+
+    if( freeN < pN )
+    {
+        //parece cheio: so agora busca o head do consumidor
+        pRb->wr.headCache = RINGBUFFMC_LOAD( &pRb->rd.head );
+        freeN = pRb->cfg.mask + 1 - (tail - pRb->wr.headCache);
+        pN = MIN( pN, freeN );
+    }
+
+    if( pN == 0 )
+    {
+        return 0;
+    }
+
+    _ringbuffmc_copyIn( pRb, tail, pWrBuff, pN );
+    RINGBUFFMC_STORE( &pRb->wr.tail, tail + pN );
+
+    return pN;
+}
+
+uint32_t RingBuffMc_RdOne(ringbuff_mc_t *pRb, void *pEl)
+{
+    return RingBuffMc_RdMany( pRb, pEl, 1 );
+}
+
+uint32_t RingBuffMc_RdMany(ringbuff_mc_t *pRb, void *pRdBuff, uint32_t pN)
+{
+    uint32_t head;
+    uint32_t used;
+
+    if( pRb == NULL )
+    {
+        return 0;
+    }
+    if( !pRb->cfg.init )
+    {
+        return 0;
+    }
+
+    //somente o consumidor escreve o head
+    head = pRb->rd.head;
+    used = pRb->rd.tailCache - head;
+
+    if( used < pN )
+    {
+        //parece vazio: so agora busca o tail do produtor
+        pRb->rd.tailCache = RINGBUFFMC_LOAD( &pRb->wr.tail );
+        used = pRb->rd.tailCache - head;
+        pN = MIN( pN, used );
+    }
+
+    if( pN == 0 )
+    {
+        return 0;
+    }
+
+    if( pRdBuff != NULL )
+    {
+        _ringbuffmc_copyOut( pRb, head, pRdBuff, pN );
+    }
+    RINGBUFFMC_STORE( &pRb->rd.head, head + pN );
+
+    return pN;
+}
+
+uint32_t RingBuffMc_Used(ringbuff_mc_t *pRb)
+{
+    uint32_t head;
+
+    if( pRb == NULL )
+    {
+        return 0;
+    }
+    if( !pRb->cfg.init )
+    {
+        return 0;
+    }
+
+    head = RINGBUFFMC_LOAD( &pRb->rd.head );
+
+    return RINGBUFFMC_LOAD( &pRb->wr.tail ) - head;
+}
+
+uint32_t RingBuffMc_Free(ringbuff_mc_t *pRb)
+{
+    return RingBuffMc_Sz(pRb) - RingBuffMc_Used(pRb);
+}
+
+uint32_t RingBuffMc_Sz(ringbuff_mc_t *pRb)
+{
+    if( pRb == NULL )
+    {
+        return 0;
+    }
+    if( !pRb->cfg.init )
+    {
+        return 0;
+    }
+
+    return pRb->cfg.mask + 1;
+}
@@ -0,0 +1,232 @@
+
+#include <string.h>
+#include "common/ring_buffer_pers.h"
+#include "common/crc.h"
+
+
+/** Keeps the compiler from moving data stores past the control block update */
+#define RBPERS_BARRIER()    __atomic_signal_fence( __ATOMIC_SEQ_CST )
+
+static uint32_t _rbpers_crc( uint32_t pSeq, uint32_t pHead, uint32_t pTail, uint32_t pN, uint32_t pElSz )
+{
+    uint32_t fields[5];
+
+    fields[0] = pSeq;
+    fields[1] = pHead;
+    fields[2] = pTail;
+    fields[3] = pN;
+    fields[4] = pElSz;
+
+    return Crc32( fields, sizeof(fields) );
+}
+
+static bool_t _rbpers_slotOk( ringbuff_pers_t *pRb, uint8_t pIdx )
+{
+    volatile ringbuff_pers_slot_t *slot = &pRb->hdr->slot[pIdx];
+
+    return (bool_t)( slot->crc == _rbpers_crc( slot->seq, slot->head, slot->tail, pRb->mask + 1, pRb->eSz ) );
+}
+
+/*
+ * Writes head and tail to the slot not holding the newest state. A reset in
+ * the middle leaves a bad CRC in this slot, and the other one still valid.
+ */
+static void _rbpers_commit( ringbuff_pers_t *pRb )
+{
+    volatile ringbuff_pers_slot_t *slot;
+
+    pRb->seq++;
+    slot = &pRb->hdr->slot[pRb->seq & 1];
+
+    RBPERS_BARRIER();
+    slot->seq = pRb->seq;
+    slot->head = pRb->head;
+    slot->tail = pRb->tail;
+    slot->crc = _rbpers_crc( pRb->seq, pRb->head, pRb->tail, pRb->mask + 1, pRb->eSz );
+    RBPERS_BARRIER();
+}
+
+
+res_t RingBuffPers_Attach(ringbuff_pers_t *pRb, void * const pRegion, uint32_t pSz, uint8_t pElSz)
+{
+    volatile ringbuff_pers_hdr_t *hdr = (volatile ringbuff_pers_hdr_t *)pRegion;
+    uint32_t n;
+    int8_t pick = -1;
+
+    if( (pRb == NULL) || (pRegion == NULL) || (pElSz == 0) )
+    {
+        return RES_ERROR;
+    }
+    if( pSz < sizeof(ringbuff_pers_hdr_t) + pElSz )
+    {
+        return RES_ERR_SZ;
+    }
+
+    n = (pSz - sizeof(ringbuff_pers_hdr_t)) / pElSz;
+    while( n & (n - 1) )
+    {
+        n &= (n - 1);
+    }
+
+    pRb->hdr = hdr;
+    pRb->data = &((uint8_t*)pRegion)[ sizeof(ringbuff_pers_hdr_t) ];
+    pRb->mask = n - 1;
+    pRb->eSz = pElSz;
+    pRb->init = true;
+
+    if( (hdr->magic == RINGBUFF_PERS_MAGIC) && (hdr->n == n) && (hdr->eSz == pElSz) )
+    {
+        if( _rbpers_slotOk( pRb, 0 ) )
+        {
+            pick = 0;
+        }
+        if( _rbpers_slotOk( pRb, 1 ) )
+        {
+            //os dois válidos: o mais novo vence, mesmo após o contador dar a volta
+            if( (pick < 0) || ((int32_t)(hdr->slot[1].seq - hdr->slot[0].seq) > 0) )
+            {
+                pick = 1;
+            }
+        }
+    }
+
+    if( (pick >= 0) && (hdr->slot[pick].tail - hdr->slot[pick].head <= n) )
+    {
+        pRb->seq = hdr->slot[pick].seq;
+        pRb->head = hdr->slot[pick].head;
+        pRb->tail = hdr->slot[pick].tail;
+        return RES_SUCCESS;
+    }
+
+    RingBuffPers_Format( pRb );
+    return RES_ERR_FORMAT;
+}
+
+void RingBuffPers_Format(ringbuff_pers_t *pRb)
+{
+    if( pRb == NULL )
+    {
+        return;
+    }
+    if( !pRb->init )
+    {
+        return;
+    }
+
+    pRb->hdr->magic = RINGBUFF_PERS_MAGIC;
+    pRb->hdr->n = pRb->mask + 1;
+    pRb->hdr->eSz = pRb->eSz;
+    pRb->hdr->rsvd = 0;
+
+    //invalida o slot 1, o slot 0 passa a ser o único válido
+    pRb->hdr->slot[1].crc = ~_rbpers_crc( pRb->hdr->slot[1].seq, pRb->hdr->slot[1].head,
+                                          pRb->hdr->slot[1].tail, pRb->mask + 1, pRb->eSz );
+    pRb->head = 0;
+    pRb->tail = 0;
+    pRb->seq = UINT32_MAX;
+    _rbpers_commit( pRb );
+}
+
+uint32_t RingBuffPers_WrOne(ringbuff_pers_t *pRb, const void * const pEl, bool_t pOw)
+{
+    if( pRb == NULL )
+    {
+        return 0;
+    }
+    if( !pRb->init )
+    {
+        return 0;
+    }
+
+    if( pRb->tail - pRb->head > pRb->mask )
+    {
+        if( !pOw )
+        {
+            return 0;
+        }
+        //o mais antigo sai do bloco de controle antes de ser sobrescrito
+        pRb->head++;
+        _rbpers_commit( pRb );
+    }
+
+    memcpy( &pRb->data[ (pRb->tail & pRb->mask) * pRb->eSz ], pEl, pRb->eSz );
+
+    pRb->tail++;
+    _rbpers_commit( pRb );
+
+    return 1;
+}
+
+uint32_t RingBuffPers_RdOne(ringbuff_pers_t *pRb, void *pEl)
+{
+    if( RingBuffPers_Used(pRb) == 0 )
+    {
+        return 0;
+    }
+
+    if( pEl != NULL )
+    {
+        memcpy( pEl, &pRb->data[ (pRb->head & pRb->mask) * pRb->eSz ], pRb->eSz );
+    }
+
+    pRb->head++;
+    _rbpers_commit( pRb );
+
+    return 1;
+}
+
+void *RingBuffPers_PeekAt(ringbuff_pers_t *pRb, uint32_t pIdx)
+{
+    if( pIdx >= RingBuffPers_Used(pRb) )
+    {
+        return NULL;
+    }
+
+    return &pRb->data[ ((pRb->head + pIdx) & pRb->mask) * pRb->eSz ];
+}
+
+uint32_t RingBuffPers_Discard(ringbuff_pers_t *pRb, uint32_t pN)
+{
+    pN = MIN( pN, RingBuffPers_Used(pRb) );
+
+    if( pN > 0 )
+    {
+        pRb->head += pN;
+        _rbpers_commit( pRb );
+    }
+
+    return pN;
+}
+
+uint32_t RingBuffPers_Used(ringbuff_pers_t *pRb)
+{
+    if( pRb == NULL )
+    {
+        return 0;
+    }
+    if( !pRb->init )
+    {
+        return 0;
+    }
+
+    return pRb->tail - pRb->head;
+}
+
+uint32_t RingBuffPers_Free(ringbuff_pers_t *pRb)
+{
+    return RingBuffPers_Sz(pRb) - RingBuffPers_Used(pRb);
+}
+
+uint32_t RingBuffPers_Sz(ringbuff_pers_t *pRb)
+{
+    if( pRb == NULL )
+    {
+        return 0;
+    }
+    if( !pRb->init )
+    {
+        return 0;
+    }
+
+    return pRb->mask + 1;
+}
@@ -0,0 +1,228 @@
+
+#include "common/ring_stats.h"
+
+
+static INLINE ringstats_ent_t *_ringstats_at( ringstats_deque_t *pDq, uint32_t pIdx )
+{
+    pIdx += pDq->first;
+    if( pIdx >= pDq->sz )
+    {
+        pIdx -= pDq->sz;
+    }
+    return &pDq->ent[pIdx];
+}
+
+/*
+ * Pushes a new sample at the back of a monotonic deque. Entries that can no
+ * longer be the extreme of the window are dropped first: for the minimum
+ * deque (pMax false), the ones greater or equal to the new sample.
+ */
+static void _ringstats_push( ringstats_deque_t *pDq, uint32_t pSeq, int32_t pVal, bool_t pMax )
+{
+    ringstats_ent_t *ent;
+
+    while( pDq->n > 0 )
+    {
+        ent = _ringstats_at( pDq, pDq->n - 1 );
+        if( pMax ? (ent->val > pVal) : (ent->val < pVal) )
+        {
+            break;
+        }
+        pDq->n--;
+    }
+
+    ent = _ringstats_at( pDq, pDq->n );
+    ent->seq = pSeq;
+    ent->val = pVal;
+    pDq->n++;
+}
+
+/*
+ * Drops the front entry if it is the sample leaving the window
+ */
+static INLINE void _ringstats_expire( ringstats_deque_t *pDq, uint32_t pSeq )
+{
+    if( (pDq->n > 0) && (pDq->ent[pDq->first].seq == pSeq) )
+    {
+        pDq->first++;
+        if( pDq->first == pDq->sz )
+        {
+            pDq->first = 0;
+        }
+        pDq->n--;
+    }
+}
+
+static uint32_t _ringstats_sqrt( uint64_t pX )
+{
+    uint64_t res = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while( bit > pX )
+    {
+        bit >>= 2;
+    }
+    while( bit != 0 )
+    {
+        if( pX >= res + bit )
+        {
+            pX -= res + bit;
+            res = (res >> 1) + bit;
+        }
+        else
+        {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)res;
+}
+
+
+uint32_t RingStats_Init(ring_stats_t *pSt, void * const pBuff, uint32_t pSz)
+{
+    uint32_t n;
+
+    if( pSt == NULL )
+    {
+        return 0;
+    }
+
+    n = RingBuff_Init( &pSt->rb, pBuff, (pSz / RINGSTATS_SAMPLE_SZ) * sizeof(int32_t), sizeof(int32_t) );
+    if( n == 0 )
+    {
+        return 0;
+    }
+
+    //os deques ficam logo depois das amostras
+    pSt->min.ent = (ringstats_ent_t*)&((int32_t*)pBuff)[n];
+    pSt->min.sz = n;
+    pSt->min.first = 0;
+    pSt->min.n = 0;
+    pSt->max.ent = &pSt->min.ent[n];
+    pSt->max.sz = n;
+    pSt->max.first = 0;
+    pSt->max.n = 0;
+
+    pSt->sum = 0;
+    pSt->sumSq = 0;
+    pSt->wrSeq = 0;
+    pSt->rdSeq = 0;
+
+    return n;
+}
+
+uint32_t RingStats_Wr(ring_stats_t *pSt, int32_t pVal, bool_t pOw)
+{
+    if( pSt == NULL )
+    {
+        return 0;
+    }
+    if( RingBuff_Sz( &pSt->rb ) == 0 )
+    {
+        return 0;
+    }
+
+    if( RingBuff_IsFull( &pSt->rb ) )
+    {
+        if( !pOw )
+        {
+            return 0;
+        }
+        //a amostra mais antiga seria sobrescrita: sai da janela antes
+        RingStats_Rd( pSt, NULL );
+    }
+
+    if( RingBuff_WrOne( &pSt->rb, &pVal, false ) == 0 )
+    {
+        return 0;
+    }
+
+    pSt->sum += (uint64_t)(int64_t)pVal;
+    pSt->sumSq += (uint64_t)((int64_t)pVal * pVal);
+    _ringstats_push( &pSt->min, pSt->wrSeq, pVal, false );
+    _ringstats_push( &pSt->max, pSt->wrSeq, pVal, true );
+    pSt->wrSeq++;
+
+    return 1;
+}
+
+uint32_t RingStats_Rd(ring_stats_t *pSt, int32_t *pVal)
+{
+    int32_t val;
+
+    if( pSt == NULL )
+    {
+        return 0;
+    }
+    if( RingBuff_RdOne( &pSt->rb, &val ) == 0 )
+    {
+        return 0;
+    }
+
+    pSt->sum -= (uint64_t)(int64_t)val;
+    pSt->sumSq -= (uint64_t)((int64_t)val * val);
+    _ringstats_expire( &pSt->min, pSt->rdSeq );
+    _ringstats_expire( &pSt->max, pSt->rdSeq );
+    pSt->rdSeq++;
+
+    if( pVal != NULL )
+    {
+        *pVal = val;
+    }
+    return 1;
+}
+
+uint32_t RingStats_Mean(ring_stats_t *pSt, int32_t *pMean)
+{
+    uint32_t n = RingStats_Used( pSt );
+
+    if( n > 0 )
+    {
+        *pMean = (int32_t)( (int64_t)pSt->sum / (int64_t)n );
+    }
+    return n;
+}
+
+uint32_t RingStats_Rms(ring_stats_t *pSt, uint32_t *pRms)
+{
+    uint32_t n = RingStats_Used( pSt );
+
+    if( n > 0 )
+    {
+        *pRms = _ringstats_sqrt( pSt->sumSq / n );
+    }
+    return n;
+}
+
+uint32_t RingStats_Min(ring_stats_t *pSt, int32_t *pMin)
+{
+    uint32_t n = RingStats_Used( pSt );
+
+    if( n > 0 )
+    {
+        *pMin = pSt->min.ent[pSt->min.first].val;
+    }
+    return n;
+}
+
+uint32_t RingStats_Max(ring_stats_t *pSt, int32_t *pMax)
+{
+    uint32_t n = RingStats_Used( pSt );
+
+    if( n > 0 )
+    {
+        *pMax = pSt->max.ent[pSt->max.first].val;
+    }
+    return n;
+}
+
+uint32_t RingStats_Used(ring_stats_t *pSt)
+{
+    if( pSt == NULL )
+    {
+        return 0;
+    }
+
+    return RingBuff_Used( &pSt->rb );
+}
@@ -0,0 +1,133 @@
+
+#include "common/sched.h"
+
+
+#define SCHED_BIT(__prio)   ( 0x80000000UL >> (__prio) )
+
+#define SCHED_LOAD(__ptr)           __atomic_load_n( (__ptr), __ATOMIC_ACQUIRE )
+#define SCHED_SET(__ptr, __mask)    ARCH_ATOMIC_OR32( (__ptr), (__mask), __ATOMIC_RELEASE )
+#define SCHED_CLR(__ptr, __mask)    ARCH_ATOMIC_AND32( (__ptr), ~(__mask), __ATOMIC_ACQ_REL )
+
+
+void Sched_Init(sched_t *pS, sched_idle_t pIdle)
+{
+    uint8_t ii;
+
+    if( pS == NULL )
+    {
+        return;
+    }
+
+    for(ii=0; ii < SCHED_TASKS_MAX; ii++)
+    {
+        pS->task[ii] = NULL;
+        pS->ctx[ii] = NULL;
+    }
+    pS->idle = pIdle;
+    pS->ready = 0;
+}
+
+res_t Sched_Add(sched_t *pS, uint8_t pPrio, sched_task_t pTask, void *pCtx)
+{
+    if( (pS == NULL) || (pTask == NULL) || (pPrio >= SCHED_TASKS_MAX) )
+    {
+        return RES_ERROR;
+    }
+    if( pS->task[pPrio] != NULL )
+    {
+        return RES_ERR_BUSY;
+    }
+
+    pS->ctx[pPrio] = pCtx;
+    pS->task[pPrio] = pTask;
+
+    return RES_SUCCESS;
+}
+
+#if defined(RINGBUFF_NOTIFY)
+void Sched_Subscribe(sched_t *pS, uint8_t pPrio, ringbuff_t *pRb)
+{
+    if( (pS == NULL) || (pRb == NULL) || (pPrio >= SCHED_TASKS_MAX) )
+    {
+        return;
+    }
+
+    RingBuff_SetNotify( pRb, &pS->ready, SCHED_BIT(pPrio) );
+
+    //o que chegou antes da inscrição não notificou ninguém
+    if( !RingBuff_IsEmpty( pRb ) )
+    {
+        SCHED_SET( &pS->ready, SCHED_BIT(pPrio) );
+    }
+}
+#endif
+
+void Sched_Ready(sched_t *pS, uint8_t pPrio)
+{
+    if( (pS == NULL) || (pPrio >= SCHED_TASKS_MAX) )
+    {
+        return;
+    }
+
+    SCHED_SET( &pS->ready, SCHED_BIT(pPrio) );
+}
+
+bool_t Sched_Pending(sched_t *pS)
+{
+    if( pS == NULL )
+    {
+        return false;
+    }
+
+    return (bool_t)( SCHED_LOAD( &pS->ready ) != 0 );
+}
+
+uint32_t Sched_RunOne(sched_t *pS)
+{
+    uint32_t ready;
+    uint32_t prio;
+
+    if( pS == NULL )
+    {
+        return 0;
+    }
+
+    ready = SCHED_LOAD( &pS->ready );
+    if( ready == 0 )
+    {
+        return 0;
+    }
+
+    prio = ARCH_CLZ32( ready );
+
+    //limpa antes de rodar: uma escrita durante a tarefa a deixa pronta de novo
+    SCHED_CLR( &pS->ready, SCHED_BIT(prio) );
+
+    if( pS->task[prio] == NULL )
+    {
+        return 0;
+    }
+
+    if( pS->task[prio]( pS->ctx[prio] ) == SCHED_YIELD )
+    {
+        SCHED_SET( &pS->ready, SCHED_BIT(prio) );
+    }
+
+    return 1;
+}
+
+void Sched_Run(sched_t *pS)
+{
+    if( pS == NULL )
+    {
+        return;
+    }
+
+    for(;;)
+    {
+        if( (Sched_RunOne( pS ) == 0) && !Sched_Pending( pS ) && (pS->idle != NULL) )
+        {
+            pS->idle();
+        }
+    }
+}
@@ -0,0 +1,370 @@
+
+#include "common/shm_chan.h"
+
+#if defined(__linux__)
+
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined(SHMCHAN_FUTEX)
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+
+#define SHMCHAN_LOAD(__ptr)          __atomic_load_n( (__ptr), __ATOMIC_ACQUIRE )
+#define SHMCHAN_STORE(__ptr, __val)  __atomic_store_n( (__ptr), (__val), __ATOMIC_RELEASE )
+#define SHMCHAN_FENCE()              __atomic_thread_fence( __ATOMIC_SEQ_CST )
+
+/*
+ * Copies pN elements into the ring, starting at the free-running index pId.
+ * Two memcpy at most.
+ */
+static void _shmchan_copyIn( shm_chan_t *pCh, uint32_t pId, const uint8_t *pSrc, uint32_t pN )
+{
+    uint32_t slot = pId & pCh->mask;
+    uint32_t n1 = MIN( pN, pCh->mask + 1 - slot );
+
+    memcpy( &pCh->data[slot * pCh->eSz], pSrc, n1 * pCh->eSz );
+    memcpy( pCh->data, &pSrc[n1 * pCh->eSz], (pN - n1) * pCh->eSz );
+}
+
+/*
+ * Copies pN elements out of the ring, starting at the free-running index pId.
+ * Two memcpy at most.
+ */
+static void _shmchan_copyOut( shm_chan_t *pCh, uint32_t pId, uint8_t *pDst, uint32_t pN )
+{
+    uint32_t slot = pId & pCh->mask;
+    uint32_t n1 = MIN( pN, pCh->mask + 1 - slot );
+
+    memcpy( pDst, &pCh->data[slot * pCh->eSz], n1 * pCh->eSz );
+    memcpy( &pDst[n1 * pCh->eSz], pCh->data, (pN - n1) * pCh->eSz );
+}
+
+static uint32_t _shmchan_map( shm_chan_t *pCh, int pFd, size_t pSz )
+{
+    void *map = mmap( NULL, pSz, PROT_READ | PROT_WRITE, MAP_SHARED, pFd, 0 );
+
+    close( pFd );
+    if( map == MAP_FAILED )
+    {
+        return 0;
+    }
+
+    pCh->ctl = (shmchan_ctl_t *)map;
+    pCh->mapSz = pSz;
+    return 1;
+}
+
+static uint32_t _shmchan_attach( shm_chan_t *pCh )
+{
+    pCh->mask = pCh->ctl->cfg.mask;
+    pCh->eSz = pCh->ctl->cfg.eSz;
+    pCh->data = &((uint8_t*)pCh->ctl)[ pCh->ctl->cfg.dataOff ];
+    pCh->headCache = SHMCHAN_LOAD( &pCh->ctl->rd.head );
+    pCh->tailCache = SHMCHAN_LOAD( &pCh->ctl->wr.tail );
+    pCh->init = true;
+
+    return pCh->mask + 1;
+}
+
+#if defined(SHMCHAN_FUTEX)
+static void _shmchan_futex( volatile uint32_t *pAddr, int pOp, uint32_t pVal, const struct timespec *pTimeout )
+{
+    //mapeamento compartilhado entre processos: sem FUTEX_PRIVATE_FLAG
+    syscall( SYS_futex, (uint32_t *)pAddr, pOp, pVal, pTimeout, NULL, 0 );
+}
+#endif
+
+
+uint32_t ShmChan_Create(shm_chan_t *pCh, const char_t *pName, uint32_t pN, uint32_t pElSz)
+{
+    size_t sz;
+    int fd;
+
+    if( (pCh == NULL) || (pName == NULL) )
+    {
+        return 0;
+    }
+    if( (pN == 0) || (pElSz == 0) )
+    {
+        return 0;
+    }
+
+    //os indices correm livres: o numero de elementos precisa ser potencia de 2
+    while( pN & (pN - 1) )
+    {
+        pN &= (pN - 1);
+    }
+    sz = sizeof(shmchan_ctl_t) + (size_t)pN * pElSz;
+
+    fd = shm_open( pName, O_CREAT | O_EXCL | O_RDWR, 0600 );
+    if( fd < 0 )
+    {
+        return 0;
+    }
+    if( ftruncate( fd, (off_t)sz ) != 0 )
+    {
+        close( fd );
+        shm_unlink( pName );
+        return 0;
+    }
+    if( _shmchan_map( pCh, fd, sz ) == 0 )
+    {
+        shm_unlink( pName );
+        return 0;
+    }
+
+    pCh->ctl->cfg.mask = pN - 1;
+    pCh->ctl->cfg.eSz = pElSz;
+    pCh->ctl->cfg.dataOff = sizeof(shmchan_ctl_t);
+    pCh->ctl->rd.head = 0;
+    pCh->ctl->rd.sleeping = 0;
+    pCh->ctl->wr.tail = 0;
+    //quem abre só confia na geometria depois de ver o magic
+    SHMCHAN_STORE( &pCh->ctl->cfg.magic, SHMCHAN_MAGIC );
+
+    return _shmchan_attach( pCh );
+}
+
+uint32_t ShmChan_Open(shm_chan_t *pCh, const char_t *pName)
+{
+    struct stat st;
+    shmchan_ctl_t *ctl;
+    int fd;
+
+    if( (pCh == NULL) || (pName == NULL) )
+    {
+        return 0;
+    }
+
+    fd = shm_open( pName, O_RDWR, 0 );
+    if( fd < 0 )
+    {
+        return 0;
+    }
+    if( (fstat( fd, &st ) != 0) || ((size_t)st.st_size < sizeof(shmchan_ctl_t)) )
+    {
+        close( fd );
+        return 0;
+    }
+    if( _shmchan_map( pCh, fd, (size_t)st.st_size ) == 0 )
+    {
+        return 0;
+    }
+
+    ctl = pCh->ctl;
+    if( (SHMCHAN_LOAD( &ctl->cfg.magic ) != SHMCHAN_MAGIC) ||
+        (ctl->cfg.eSz == 0) || ((ctl->cfg.mask & (ctl->cfg.mask + 1)) != 0) ||
+        (ctl->cfg.dataOff < sizeof(shmchan_ctl_t)) ||
+        ((uint64_t)ctl->cfg.dataOff + ((uint64_t)ctl->cfg.mask + 1) * ctl->cfg.eSz > pCh->mapSz) )
+    {
+        munmap( ctl, pCh->mapSz );
+        pCh->init = false;
+        return 0;
+    }
+
+    return _shmchan_attach( pCh );
+}
+
+void ShmChan_Close(shm_chan_t *pCh)
+{
+    if( pCh == NULL )
+    {
+        return;
+    }
+    if( !pCh->init )
+    {
+        return;
+    }
+
+    munmap( pCh->ctl, pCh->mapSz );
+    pCh->init = false;
+}
+
+res_t ShmChan_Unlink(const char_t *pName)
+{
+    if( pName == NULL )
+    {
+        return RES_ERROR;
+    }
+
+    return (shm_unlink( pName ) == 0) ? RES_SUCCESS : RES_ERROR;
+}
+
+uint32_t ShmChan_Wr(shm_chan_t *pCh, const void *pWrBuff, uint32_t pN)
+{
+    uint32_t tail;
+    uint32_t freeN;
+
+    if( pCh == NULL )
+    {
+        return 0;
+    }
+    if( pWrBuff == NULL )
+    {
+        return 0;
+    }
+    if( !pCh->init )
+    {
+        return 0;
+    }
+
+    //somente o produtor escreve o tail
+    tail = pCh->ctl->wr.tail;
+    freeN = pCh->mask + 1 - (tail - pCh->headCache);
+
+    if( freeN < pN )
+    {
+        //parece cheio: so agora busca o head do consumidor
+        pCh->headCache = SHMCHAN_LOAD( &pCh->ctl->rd.head );
+        freeN = pCh->mask + 1 - (tail - pCh->headCache);
+        pN = MIN( pN, freeN );
+    }
+
+    if( pN == 0 )
+    {
+        return 0;
+    }
+
+    _shmchan_copyIn( pCh, tail, pWrBuff, pN );
+    SHMCHAN_STORE( &pCh->ctl->wr.tail, tail + pN );
+
+#if defined(SHMCHAN_FUTEX)
+    //a campainha só toca se o consumidor estiver dormindo
+    SHMCHAN_FENCE();
+    if( pCh->ctl->rd.sleeping )
+    {
+        _shmchan_futex( &pCh->ctl->wr.tail, FUTEX_WAKE, 1, NULL );
+    }
+#endif
+
+    return pN;
+}
+
+uint32_t ShmChan_Rd(shm_chan_t *pCh, void *pRdBuff, uint32_t pN)
+{
+    uint32_t head;
+    uint32_t used;
+
+    if( pCh == NULL )
+    {
+        return 0;
+    }
+    if( !pCh->init )
+    {
+        return 0;
+    }
+
+    //somente o consumidor escreve o head
+    head = pCh->ctl->rd.head;
+    used = pCh->tailCache - head;
+
+    if( used < pN )
+    {
+        //parece vazio: so agora busca o tail do produtor
+        pCh->tailCache = SHMCHAN_LOAD( &pCh->ctl->wr.tail );
+        used = pCh->tailCache - head;
+        pN = MIN( pN, used );
+    }
+
+    if( pN == 0 )
+    {
+        return 0;
+    }
+
+    if( pRdBuff != NULL )
+    {
+        _shmchan_copyOut( pCh, head, pRdBuff, pN );
+    }
+    SHMCHAN_STORE( &pCh->ctl->rd.head, head + pN );
+
+    return pN;
+}
+
+uint32_t ShmChan_RdWait(shm_chan_t *pCh, void *pRdBuff, uint32_t pN, uint32_t pTimeoutMs)
+{
+    struct timespec now;
+    struct timespec end;
+    uint32_t n;
+#if defined(SHMCHAN_FUTEX)
+    struct timespec left;
+    uint32_t tail;
+#endif
+
+    n = ShmChan_Rd( pCh, pRdBuff, pN );
+    if( (n > 0) || (pN == 0) || (pCh == NULL) || !pCh->init )
+    {
+        return n;
+    }
+
+    clock_gettime( CLOCK_MONOTONIC, &end );
+    end.tv_sec += pTimeoutMs / 1000;
+    end.tv_nsec += (long)(pTimeoutMs % 1000) * 1000000L;
+    if( end.tv_nsec >= 1000000000L )
+    {
+        end.tv_sec++;
+        end.tv_nsec -= 1000000000L;
+    }
+
+    for(;;)
+    {
+        clock_gettime( CLOCK_MONOTONIC, &now );
+        if( (now.tv_sec > end.tv_sec) || ((now.tv_sec == end.tv_sec) && (now.tv_nsec >= end.tv_nsec)) )
+        {
+            return 0;
+        }
+
+#if defined(SHMCHAN_FUTEX)
+        //anuncia o sono antes de olhar o tail: ou o produtor vê o aviso, ou nós vemos o tail novo
+        SHMCHAN_STORE( &pCh->ctl->rd.sleeping, 1 );
+        SHMCHAN_FENCE();
+        tail = SHMCHAN_LOAD( &pCh->ctl->wr.tail );
+        if( tail == pCh->ctl->rd.head )
+        {
+            left.tv_sec = end.tv_sec - now.tv_sec;
+            left.tv_nsec = end.tv_nsec - now.tv_nsec;
+            if( left.tv_nsec < 0 )
+            {
+                left.tv_sec--;
+                left.tv_nsec += 1000000000L;
+            }
+            _shmchan_futex( &pCh->ctl->wr.tail, FUTEX_WAIT, tail, &left );
+        }
+        SHMCHAN_STORE( &pCh->ctl->rd.sleeping, 0 );
+#else
+        sched_yield();
+#endif
+
+        n = ShmChan_Rd( pCh, pRdBuff, pN );
+        if( n > 0 )
+        {
+            return n;
+        }
+    }
+}
+
+uint32_t ShmChan_Used(shm_chan_t *pCh)
+{
+    uint32_t head;
+
+    if( pCh == NULL )
+    {
+        return 0;
+    }
+    if( !pCh->init )
+    {
+        return 0;
+    }
+
+    head = SHMCHAN_LOAD( &pCh->ctl->rd.head );
+
+    return SHMCHAN_LOAD( &pCh->ctl->wr.tail ) - head;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,292 @@
+
+#include "common/timer_wheel.h"
+
+
+#define TWHEEL_SLOT_MASK    ( TWHEEL_SLOTS - 1 )
+
+/** Slot list head of a level */
+#define TWHEEL_HEAD(__w, __lvl, __idx)  ( &(__w)->slot[ ((uint32_t)(__lvl) << TWHEEL_SLOT_BITS) + (__idx) ] )
+
+static void _twheel_link( twheel_tmr_t **pHead, twheel_tmr_t *pTmr )
+{
+    pTmr->next = *pHead;
+    if( *pHead != NULL )
+    {
+        (*pHead)->pprev = &pTmr->next;
+    }
+    *pHead = pTmr;
+    pTmr->pprev = pHead;
+}
+
+static void _twheel_unlink( twheel_tmr_t *pTmr )
+{
+    *pTmr->pprev = pTmr->next;
+    if( pTmr->next != NULL )
+    {
+        pTmr->next->pprev = pTmr->pprev;
+    }
+    pTmr->pprev = NULL;
+}
+
+/*
+ * Links the timer to the lowest level that reaches its expiry
+ */
+static void _twheel_place( twheel_t *pW, twheel_tmr_t *pTmr )
+{
+    uint32_t delta = pTmr->expires - pW->now;
+    uint32_t at = pTmr->expires;
+    uint8_t lvl = 0;
+
+    while( (lvl + 1 < pW->levels) && (delta >> (TWHEEL_SLOT_BITS * (lvl + 1))) )
+    {
+        lvl++;
+    }
+
+    //alem do alcance do último nível: espera no slot mais distante e é recolocado no cascateamento
+    if( (uint64_t)delta >> (TWHEEL_SLOT_BITS * pW->levels) )
+    {
+        at = pW->now + (uint32_t)( ((uint64_t)1 << (TWHEEL_SLOT_BITS * pW->levels)) - 1 );
+    }
+
+    _twheel_link( TWHEEL_HEAD( pW, lvl, (at >> (TWHEEL_SLOT_BITS * lvl)) & TWHEEL_SLOT_MASK ), pTmr );
+}
+
+/*
+ * Moves the timers of the current slot of a level to the levels below.
+ * Returns the slot index: 0 means this level wrapped too.
+ */
+static uint32_t _twheel_cascade( twheel_t *pW, uint8_t pLvl )
+{
+    uint32_t idx = (pW->now >> (TWHEEL_SLOT_BITS * pLvl)) & TWHEEL_SLOT_MASK;
+    twheel_tmr_t **head = TWHEEL_HEAD( pW, pLvl, idx );
+    twheel_tmr_t *tmr = *head;
+    twheel_tmr_t *next;
+
+    *head = NULL;
+    while( tmr != NULL )
+    {
+        next = tmr->next;
+        _twheel_place( pW, tmr );
+        tmr = next;
+    }
+
+    return idx;
+}
+
+/*
+ * Processes one tick: cascades, then moves the timers expiring now to the
+ * batch and delivers it.
+ */
+static uint32_t _twheel_step( twheel_t *pW )
+{
+    uint32_t idx = pW->now & TWHEEL_SLOT_MASK;
+    uint32_t tick = pW->now;
+    twheel_tmr_t **head;
+    twheel_tmr_t *tmr;
+    twheel_tmr_t *next;
+    uint32_t n = 0;
+    uint8_t lvl;
+
+    if( idx == 0 )
+    {
+        for(lvl=1; lvl < pW->levels; lvl++)
+        {
+            if( _twheel_cascade( pW, lvl ) != 0 )
+            {
+                break;
+            }
+        }
+    }
+
+    head = TWHEEL_HEAD( pW, 0, idx );
+    tmr = *head;
+    *head = NULL;
+    pW->now++;
+
+    while( tmr != NULL )
+    {
+        next = tmr->next;
+        if( tmr->expires == tick )
+        {
+            _twheel_link( &pW->expired, tmr );
+            n++;
+        }
+        else
+        {
+            //só com um nível: o atraso não cabia e o timer esperou no último slot
+            _twheel_place( pW, tmr );
+        }
+        tmr = next;
+    }
+
+    if( n == 0 )
+    {
+        return 0;
+    }
+
+    pW->cb( pW, n, pW->cbCtx );
+
+    //os que o callback não pegou são descartados
+    while( pW->expired != NULL )
+    {
+        _twheel_unlink( pW->expired );
+        pW->used--;
+    }
+
+    return n;
+}
+
+
+uint32_t TimerWheel_Init(twheel_t *pW, void * const pBuff, uint32_t pSz, twheel_expire_t pCb, void *pCtx)
+{
+    uint32_t levels;
+    uint32_t ii;
+
+    if( (pW == NULL) || (pBuff == NULL) || (pCb == NULL) )
+    {
+        return 0;
+    }
+
+    levels = MIN( pSz / TWHEEL_BUFF_SZ( 1 ), (uint32_t)TWHEEL_LEVELS_MAX );
+    if( levels == 0 )
+    {
+        return 0;
+    }
+
+    pW->slot = (twheel_tmr_t **)pBuff;
+    for(ii=0; ii < levels * TWHEEL_SLOTS; ii++)
+    {
+        pW->slot[ii] = NULL;
+    }
+    pW->expired = NULL;
+    pW->cb = pCb;
+    pW->cbCtx = pCtx;
+    pW->now = 0;
+    pW->used = 0;
+    pW->levels = (uint8_t)levels;
+    pW->init = true;
+
+    return levels;
+}
+
+void TimerWheel_TmrInit(twheel_tmr_t *pTmr, void *pCtx)
+{
+    if( pTmr == NULL )
+    {
+        return;
+    }
+
+    pTmr->next = NULL;
+    pTmr->pprev = NULL;
+    pTmr->expires = 0;
+    pTmr->ctx = pCtx;
+}
+
+res_t TimerWheel_Start(twheel_t *pW, twheel_tmr_t *pTmr, uint32_t pTicks)
+{
+    if( (pW == NULL) || (pTmr == NULL) )
+    {
+        return RES_ERROR;
+    }
+    if( !pW->init )
+    {
+        return RES_ERROR;
+    }
+
+    if( pTmr->pprev != NULL )
+    {
+        _twheel_unlink( pTmr );
+    }
+    else
+    {
+        pW->used++;
+    }
+
+    pTmr->expires = pW->now + MAX( pTicks, 1UL ) - 1;
+    _twheel_place( pW, pTmr );
+
+    return RES_SUCCESS;
+}
+
+uint32_t TimerWheel_Stop(twheel_t *pW, twheel_tmr_t *pTmr)
+{
+    if( (pW == NULL) || (pTmr == NULL) )
+    {
+        return 0;
+    }
+    if( pTmr->pprev == NULL )
+    {
+        return 0;
+    }
+
+    _twheel_unlink( pTmr );
+    pW->used--;
+
+    return 1;
+}
+
+bool_t TimerWheel_IsRunning(const twheel_tmr_t *pTmr)
+{
+    if( pTmr == NULL )
+    {
+        return false;
+    }
+
+    return (bool_t)( pTmr->pprev != NULL );
+}
+
+uint32_t TimerWheel_Tick(twheel_t *pW, uint32_t pTicks)
+{
+    uint32_t n = 0;
+
+    if( pW == NULL )
+    {
+        return 0;
+    }
+    if( !pW->init )
+    {
+        return 0;
+    }
+
+    while( pTicks-- )
+    {
+        if( pW->used == 0 )
+        {
+            //nada a cascatear nem a expirar
+            pW->now += pTicks + 1;
+            break;
+        }
+        n += _twheel_step( pW );
+    }
+
+    return n;
+}
+
+twheel_tmr_t *TimerWheel_PopExpired(twheel_t *pW)
+{
+    twheel_tmr_t *tmr;
+
+    if( pW == NULL )
+    {
+        return NULL;
+    }
+
+    tmr = pW->expired;
+    if( tmr != NULL )
+    {
+        _twheel_unlink( tmr );
+        pW->used--;
+    }
+
+    return tmr;
+}
+
+uint32_t TimerWheel_Used(twheel_t *pW)
+{
+    if( pW == NULL )
+    {
+        return 0;
+    }
+
+    return pW->used;
+}
@@ -0,0 +1,71 @@
+
+#include <string.h>
+#include "common/trace.h"
+
+
+trace_t _trace;
+
+
+uint32_t Trace_Init(void *pBuff, uint32_t pSz, trace_ts_t pTs)
+{
+    uint32_t n;
+
+#if defined(TRACE_TIMESTAMP_CB)
+    if( pTs == NULL )
+    {
+        return 0;
+    }
+#endif
+
+    _trace.rb.init = false;
+    _trace.ts = pTs;
+
+    TRACE_LOCK();
+    n = RingBuff_Init( &_trace.rb, pBuff, pSz, sizeof(trace_rec_t) );
+    TRACE_UNLOCK();
+
+    return n;
+}
+
+uint32_t Trace_Snapshot(trace_rec_t *pDst, uint32_t pN)
+{
+    ringbuff_vec_t segs[2];
+    uint32_t used;
+    uint32_t n;
+
+    if( pDst == NULL )
+    {
+        return 0;
+    }
+
+    TRACE_LOCK();
+
+    //só os mais novos cabem
+    used = RingBuff_Used( &_trace.rb );
+    n = RingBuff_PeekSegs( &_trace.rb, (used > pN) ? (used - pN) : 0, pN, segs );
+
+    if( segs[0].n > 0 )
+    {
+        memcpy( pDst, segs[0].ptr, segs[0].n * sizeof(trace_rec_t) );
+    }
+    if( segs[1].n > 0 )
+    {
+        memcpy( &pDst[segs[0].n], segs[1].ptr, segs[1].n * sizeof(trace_rec_t) );
+    }
+
+    TRACE_UNLOCK();
+
+    return n;
+}
+
+void Trace_Clear(void)
+{
+    TRACE_LOCK();
+    RingBuff_Flush( &_trace.rb );
+    TRACE_UNLOCK();
+}
+
+uint32_t Trace_Used(void)
+{
+    return RingBuff_Used( &_trace.rb );
+}
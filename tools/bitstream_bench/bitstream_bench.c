@@ -0,0 +1,331 @@
+/**************************************************************************//**
+ * @file     bitstream_bench.c
+ * @brief    Host benchmark of the bitstream against per-bit packing.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * First checks the bitstream:
+ * - byte layout identical to a per-bit reference packer, over random fields
+ * - all-or-nothing fields at every small buffer size
+ * - a writer and a reader interleaved through a small ring, and a ring of
+ *   2-byte elements refused
+ * - #BitStream_RdAlign
+ *
+ * Then packs and unpacks a mix of 3, 5 and 12-bit fields (a sensor record)
+ * with #BitStream_Wr / #BitStream_Rd, over a linear buffer and a ring, and
+ * with per-bit loops: #EntropyPool_Store32 and a plain set/clear loop.
+ *
+ * Build and run (from this directory):
+ *
+ *     cc -std=gnu99 -O2 -D__ARCH_AMD64__ -I../../includes -I.. -o bitstream_bench \
+ *         bitstream_bench.c ../../sources/common/bitstream.c ../../sources/common/ring_buffer.c \
+ *         ../../sources/common/entropy_pool.c
+ *     ./bitstream_bench
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include "common/bitstream.h"
+#include "common/entropy_pool.h"
+#include "host_util.h"
+
+#define BSB_FIELDS          ( 200000 )
+#define BSB_BUFF_SZ         ( 1U << 20 )
+#define BSB_RING_FIELDS     ( 20000 )
+#define BSB_BENCH_FIELDS    ( 400000 )
+#define BSB_BENCH_REPS      ( 8 )
+
+static uint32_t _bsb_vals[BSB_FIELDS];
+static uint8_t _bsb_bits[BSB_FIELDS];
+static uint8_t _bsb_buff[BSB_BUFF_SZ];
+static uint8_t _bsb_ref[BSB_BUFF_SZ];
+
+/** Fields of the benchmark record */
+static const uint8_t _bsb_rec[3] = { 3, 5, 12 };
+
+static uint32_t _bsb_perBitPos;
+
+/*
+ * Per-bit reference: sets or clears one bit per iteration, LSB first
+ */
+static void _bsb_perBitWr( uint8_t *pBuff, uint32_t pVal, uint8_t pBits )
+{
+    while( pBits-- > 0 )
+    {
+        if( pVal & 1 )
+        {
+            pBuff[_bsb_perBitPos / 8] |= (uint8_t)(1U << (_bsb_perBitPos % 8));
+        }
+        else
+        {
+            pBuff[_bsb_perBitPos / 8] &= (uint8_t)~(1U << (_bsb_perBitPos % 8));
+        }
+        pVal >>= 1;
+        _bsb_perBitPos++;
+    }
+}
+
+static uint32_t _bsb_perBitRd( const uint8_t *pBuff, uint8_t pBits )
+{
+    uint32_t val = 0;
+    uint8_t ii;
+
+    for(ii=0; ii < pBits; ii++)
+    {
+        val |= (uint32_t)((pBuff[_bsb_perBitPos / 8] >> (_bsb_perBitPos % 8)) & 1) << ii;
+        _bsb_perBitPos++;
+    }
+
+    return val;
+}
+
+static uint32_t _bsb_mask( uint8_t pBits )
+{
+    return (pBits == 32) ? 0xFFFFFFFF : ((1U << pBits) - 1);
+}
+
+static void _bsb_checkLinear( void )
+{
+    bitstream_t bs;
+    uint32_t nw = 0;
+    uint32_t nb;
+    uint32_t val;
+    uint32_t ii;
+
+    BitStream_WrInit( &bs, _bsb_buff, sizeof(_bsb_buff) );
+    for(ii=0; (ii < BSB_FIELDS) && (BitStream_Wr( &bs, _bsb_vals[ii], _bsb_bits[ii] ) > 0); ii++)
+    {
+        nw++;
+    }
+    nb = BitStream_Bits( &bs );
+    BitStream_Flush( &bs );
+
+    _bsb_perBitPos = 0;
+    for(ii=0; ii < nw; ii++)
+    {
+        _bsb_perBitWr( _bsb_ref, _bsb_vals[ii], _bsb_bits[ii] );
+    }
+    HOST_CHECK( nb == _bsb_perBitPos );
+    HOST_CHECK( memcmp( _bsb_ref, _bsb_buff, (nb + 7) / 8 ) == 0 );
+
+    BitStream_RdInit( &bs, _bsb_buff, (nb + 7) / 8 );
+    for(ii=0; ii < nw; ii++)
+    {
+        HOST_CHECK( BitStream_Rd( &bs, &val, _bsb_bits[ii] ) == _bsb_bits[ii] );
+        HOST_CHECK( val == (_bsb_vals[ii] & _bsb_mask( _bsb_bits[ii] )) );
+    }
+}
+
+/*
+ * A field is refused only if it doesn't fit, and nothing is written past the end
+ */
+static void _bsb_checkCapacity( void )
+{
+    uint8_t small[40];
+    bitstream_t bs;
+    uint32_t sz;
+    uint32_t total;
+    uint32_t k;
+    uint32_t ii;
+
+    for(sz=0; sz < sizeof(small); sz++)
+    {
+        BitStream_WrInit( &bs, small, sz );
+        total = 0;
+        for(ii=0; ii < 100; ii++)
+        {
+            k = BitStream_Wr( &bs, _bsb_vals[ii], _bsb_bits[ii] );
+            HOST_CHECK( (k == 0) || (k == _bsb_bits[ii]) );
+            HOST_CHECK( (k > 0) || ((total + _bsb_bits[ii] + 7) / 8 > sz) );
+            total += k;
+        }
+        HOST_CHECK( (total + 7) / 8 <= sz );
+        BitStream_Flush( &bs );
+        HOST_CHECK( bs.pos == (total + 7) / 8 );
+    }
+}
+
+static void _bsb_checkRing( void )
+{
+    uint8_t buff[61];
+    ringbuff_t rb;
+    bitstream_t wr;
+    bitstream_t rd;
+    uint32_t wi = 0;
+    uint32_t ri = 0;
+    uint32_t val;
+    uint32_t k;
+
+    RingBuff_Init( &rb, buff, sizeof(buff), 1 );
+    BitStream_WrInitRing( &wr, &rb );
+    BitStream_RdInitRing( &rd, &rb );
+
+    while( ri < BSB_RING_FIELDS )
+    {
+        for(k=Host_RandN( 8 ); (k > 0) && (wi < BSB_RING_FIELDS); k--)
+        {
+            if( BitStream_Wr( &wr, _bsb_vals[wi], _bsb_bits[wi] ) == 0 )
+            {
+                break;
+            }
+            wi++;
+        }
+        if( wi == BSB_RING_FIELDS )
+        {
+            BitStream_Flush( &wr );
+        }
+
+        for(k=Host_RandN( 8 ); (k > 0) && (ri < wi); k--)
+        {
+            if( BitStream_Rd( &rd, &val, _bsb_bits[ri] ) == 0 )
+            {
+                break;
+            }
+            HOST_CHECK( val == (_bsb_vals[ri] & _bsb_mask( _bsb_bits[ri] )) );
+            ri++;
+        }
+    }
+    //elementos de 2 bytes: nada e escrito nem lido
+    RingBuff_Init( &rb, buff, sizeof(buff), 2 );
+    RingBuff_WrMany( &rb, _bsb_vals, 3, false );
+    BitStream_WrInitRing( &wr, &rb );
+    BitStream_RdInitRing( &rd, &rb );
+    HOST_CHECK( BitStream_Wr( &wr, 0xFFFFFFFF, 32 ) == 0 );
+    HOST_CHECK( BitStream_Rd( &rd, &val, 32 ) == 0 );
+    BitStream_Flush( &wr );
+    HOST_CHECK( RingBuff_Used( &rb ) == 3 );
+}
+
+static void _bsb_checkAlign( void )
+{
+    uint8_t buff[8];
+    bitstream_t bs;
+    uint32_t val = 0;
+
+    BitStream_WrInit( &bs, buff, sizeof(buff) );
+    BitStream_Wr( &bs, 5, 3 );
+    BitStream_Flush( &bs );
+    BitStream_Wr( &bs, 0xAB, 8 );
+    BitStream_Flush( &bs );
+
+    BitStream_RdInit( &bs, buff, 2 );
+    BitStream_Rd( &bs, &val, 3 );
+    HOST_CHECK( val == 5 );
+    HOST_CHECK( BitStream_RdAlign( &bs ) == 5 );
+    BitStream_Rd( &bs, &val, 8 );
+    HOST_CHECK( val == 0xAB );
+}
+
+static void _bsb_print( const char_t *pName, uint64_t pFields, double pSec )
+{
+    printf( "%-34s %6.1f M fields/s\n", pName, (double)pFields / pSec * 1e-6 );
+}
+
+static void _bsb_bench( void )
+{
+    static uint8_t ringBuff[1U << 16];
+    volatile uint32_t sink = 0;
+    entropy_pool_t pool;
+    ringbuff_t rb;
+    bitstream_t bs;
+    uint64_t cnt;
+    uint32_t rep;
+    uint32_t ii;
+    uint32_t val;
+    double t0;
+
+    t0 = Host_Now();
+    for(rep=0; rep < BSB_BENCH_REPS; rep++)
+    {
+        BitStream_WrInit( &bs, _bsb_buff, sizeof(_bsb_buff) );
+        for(ii=0; ii < BSB_BENCH_FIELDS; ii++)
+        {
+            BitStream_Wr( &bs, ii, _bsb_rec[ii % 3] );
+        }
+        BitStream_Flush( &bs );
+    }
+    _bsb_print( "BitStream_Wr, linear", (uint64_t)BSB_BENCH_REPS * BSB_BENCH_FIELDS, Host_Now() - t0 );
+
+    //o anel enche antes: conta os campos aceitos
+    cnt = 0;
+    RingBuff_Init( &rb, ringBuff, sizeof(ringBuff), 1 );
+    t0 = Host_Now();
+    for(rep=0; rep < 5 * BSB_BENCH_REPS; rep++)
+    {
+        RingBuff_Flush( &rb );
+        BitStream_WrInitRing( &bs, &rb );
+        for(ii=0; (ii < BSB_BENCH_FIELDS) && (BitStream_Wr( &bs, ii, _bsb_rec[ii % 3] ) > 0); ii++)
+        {
+            cnt++;
+        }
+    }
+    _bsb_print( "BitStream_Wr, ring", cnt, Host_Now() - t0 );
+
+    t0 = Host_Now();
+    for(rep=0; rep < BSB_BENCH_REPS; rep++)
+    {
+        EntropyPool_Init( &pool, _bsb_ref, sizeof(_bsb_ref) );
+        for(ii=0; ii < BSB_BENCH_FIELDS; ii++)
+        {
+            EntropyPool_Store32( &pool, ii, _bsb_rec[ii % 3] );
+        }
+    }
+    _bsb_print( "EntropyPool_Store32 (per bit)", (uint64_t)BSB_BENCH_REPS * BSB_BENCH_FIELDS, Host_Now() - t0 );
+
+    t0 = Host_Now();
+    for(rep=0; rep < BSB_BENCH_REPS; rep++)
+    {
+        _bsb_perBitPos = 0;
+        for(ii=0; ii < BSB_BENCH_FIELDS; ii++)
+        {
+            _bsb_perBitWr( _bsb_ref, ii, _bsb_rec[ii % 3] );
+        }
+    }
+    _bsb_print( "per-bit set/clear loop", (uint64_t)BSB_BENCH_REPS * BSB_BENCH_FIELDS, Host_Now() - t0 );
+
+    t0 = Host_Now();
+    for(rep=0; rep < BSB_BENCH_REPS; rep++)
+    {
+        BitStream_RdInit( &bs, _bsb_buff, sizeof(_bsb_buff) );
+        for(ii=0; ii < BSB_BENCH_FIELDS; ii++)
+        {
+            BitStream_Rd( &bs, &val, _bsb_rec[ii % 3] );
+            sink += val;
+        }
+    }
+    _bsb_print( "BitStream_Rd, linear", (uint64_t)BSB_BENCH_REPS * BSB_BENCH_FIELDS, Host_Now() - t0 );
+
+    t0 = Host_Now();
+    for(rep=0; rep < BSB_BENCH_REPS; rep++)
+    {
+        _bsb_perBitPos = 0;
+        for(ii=0; ii < BSB_BENCH_FIELDS; ii++)
+        {
+            sink += _bsb_perBitRd( _bsb_buff, _bsb_rec[ii % 3] );
+        }
+    }
+    _bsb_print( "per-bit read loop", (uint64_t)BSB_BENCH_REPS * BSB_BENCH_FIELDS, Host_Now() - t0 );
+
+    (void)sink;
+}
+
+int main(void)
+{
+    uint32_t ii;
+
+    Host_Seed( 1 );
+    for(ii=0; ii < BSB_FIELDS; ii++)
+    {
+        _bsb_bits[ii] = (uint8_t)(1 + Host_RandN( 32 ));
+        _bsb_vals[ii] = Host_Rand();
+    }
+
+    _bsb_checkLinear();
+    _bsb_checkCapacity();
+    _bsb_checkRing();
+    _bsb_checkAlign();
+
+    _bsb_bench();
+
+    return Host_Result( "bitstream_bench" );
+}
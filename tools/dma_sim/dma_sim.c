@@ -0,0 +1,250 @@
+/**************************************************************************//**
+ * @file     dma_sim.c
+ * @brief    Host simulation of #ringbuff_dma_t fed by a circular-mode DMA.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * A writer thread plays the DMA: it stores a sequence number per transfer,
+ * then publishes the remaining-transfer count, and at the end of each lap
+ * reloads the count and calls #RingBuffDma_LapIsr, as the DMA-complete
+ * interruption would. The reload comes before the lap is counted, and the
+ * writer sometimes yields in between, so the consumer also runs while the
+ * interruption is pending. It does so only while the consumer is less than a
+ * lap behind, as the module requires: in the firmware, the interruption
+ * preempts the consumer.
+ *
+ * The main thread consumes with RdMany and with RdPtr + Discard, chosen at
+ * random, and checks the sequence: continuous while no overrun is counted,
+ * and only moving forward across one. It stalls now and then, so the writer
+ * laps it and the overrun detection and resync run. It also waits for the
+ * ring to be nearly full before reading, and a periodic signal suspends it at
+ * arbitrary points, e.g. in the middle of a copy, as a higher priority task
+ * would: the writer then overwrites elements being read.
+ *
+ * Build and run (from this directory):
+ *
+ *     cc -std=gnu99 -O2 -D__ARCH_AMD64__ -I../../includes -I.. -o dma_sim \
+ *         dma_sim.c ../../sources/common/ring_buffer_dma.c -lpthread
+ *     ./dma_sim [-n elements] [-s seed]
+ *
+ * The lap counter is a plain volatile increment, as in the firmware: the
+ * simulation relies on the x86 memory ordering.
+ *
+ ******************************************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include "common/ring_buffer_dma.h"
+#include "host_util.h"
+
+#define DMASIM_N            ( 100 )     //transferencias por volta
+#define DMASIM_RD_MAX       ( 37 )
+#define DMASIM_STALL_US     ( 3000 )
+#define DMASIM_PREEMPT_US   ( 100 )     //periodo da preempcao
+
+static struct
+{
+    uint32_t buff[DMASIM_N];
+    ringbuff_dma_t rb;
+    uint32_t remaining;
+    volatile uint32_t stop;
+    uint64_t seed;
+}_dmasim;
+
+static uint32_t _dmasim_remaining( void *pCtx )
+{
+    (void)pCtx;
+    return __atomic_load_n( &_dmasim.remaining, __ATOMIC_ACQUIRE );
+}
+
+/*
+ * The DMA: one element per transfer, yielding at random to vary the pace
+ */
+static void *_dmasim_writer( void *pArg )
+{
+    uint64_t rnd = _dmasim.seed ^ 0x9E3779B97F4A7C15ULL;
+    uint32_t seq = 0;
+    uint32_t ii;
+
+    (void)pArg;
+    while( !_dmasim.stop )
+    {
+        for(ii=0; (ii < DMASIM_N) && !_dmasim.stop; ii++)
+        {
+            __atomic_store_n( &_dmasim.buff[ii], seq++, __ATOMIC_RELAXED );
+            __atomic_store_n( &_dmasim.remaining, DMASIM_N - 1 - ii, __ATOMIC_RELEASE );
+
+            rnd ^= rnd << 13;
+            rnd ^= rnd >> 7;
+            rnd ^= rnd << 17;
+            if( (rnd & 7) == 0 )
+            {
+                sched_yield();
+            }
+        }
+
+        //recarga do contador e, depois, a interrupcao de volta completa,
+        //pendente so com o consumidor menos de uma volta atras
+        __atomic_store_n( &_dmasim.remaining, DMASIM_N, __ATOMIC_RELEASE );
+        if( ((rnd & 0x30) == 0) &&
+            ((seq - __atomic_load_n( &_dmasim.rb.head, __ATOMIC_RELAXED )) < DMASIM_N) )
+        {
+            sched_yield();
+        }
+        RingBuffDma_LapIsr( &_dmasim.rb );
+    }
+
+    return NULL;
+}
+
+/*
+ * Preemption of the consumer: lets the writer run for a few transfers
+ */
+static void _dmasim_preempt( int pSig )
+{
+    (void)pSig;
+    sched_yield();
+}
+
+/*
+ * Reads up to pMax elements with RdPtr + Discard. As RdMany does, the copy is
+ * dropped if the DMA may have reached it while copying.
+ */
+static uint32_t _dmasim_rdPtr( uint32_t *pEl, uint32_t pMax )
+{
+    uint32_t *ptr;
+    uint32_t n;
+    uint32_t ii;
+
+    n = MIN( RingBuffDma_RdPtr( &_dmasim.rb, (void **)&ptr ), pMax );
+
+    for(ii=0; ii < n; ii++)
+    {
+        pEl[ii] = __atomic_load_n( &ptr[ii], __ATOMIC_RELAXED );
+    }
+
+    //com uma volta inteira por ler, o DMA pode estar escrevendo no primeiro
+    if( RingBuffDma_Used( &_dmasim.rb ) >= DMASIM_N )
+    {
+        return 0;
+    }
+
+    return RingBuffDma_Discard( &_dmasim.rb, n );
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t el[DMASIM_RD_MAX];
+    struct itimerval tmr = { { 0, DMASIM_PREEMPT_US }, { 0, DMASIM_PREEMPT_US } };
+    sigset_t set;
+    pthread_t thr;
+    uint64_t total = 2000000;
+    uint64_t got = 0;
+    uint32_t next = 0;
+    uint32_t stalls = 0;
+    uint32_t lag = 0;
+    uint32_t ov;
+    uint32_t n;
+    uint32_t ii;
+    bool_t gap = false;
+    int opt;
+
+    _dmasim.seed = 1;
+    while( (opt = getopt( argc, argv, "n:s:" )) != -1 )
+    {
+        switch( opt )
+        {
+        case 'n':
+            total = strtoull( optarg, NULL, 0 );
+            break;
+        case 's':
+            _dmasim.seed = strtoull( optarg, NULL, 0 );
+            break;
+        default:
+            fprintf( stderr, "usage: %s [-n elements] [-s seed]\n", argv[0] );
+            return 2;
+        }
+    }
+    Host_Seed( _dmasim.seed );
+
+    _dmasim.remaining = DMASIM_N;
+    HOST_CHECK( RingBuffDma_Init( &_dmasim.rb, _dmasim.buff, sizeof(_dmasim.buff), sizeof(uint32_t),
+                                  _dmasim_remaining, NULL ) == DMASIM_N );
+
+    //so a thread consumidora recebe o sinal
+    sigemptyset( &set );
+    sigaddset( &set, SIGALRM );
+    pthread_sigmask( SIG_BLOCK, &set, NULL );
+    pthread_create( &thr, NULL, _dmasim_writer, NULL );
+    pthread_sigmask( SIG_UNBLOCK, &set, NULL );
+    signal( SIGALRM, _dmasim_preempt );
+    setitimer( ITIMER_REAL, &tmr, NULL );
+
+    while( got < total )
+    {
+        ov = RingBuffDma_Overruns( &_dmasim.rb );
+
+        //atrasa o consumidor ate quase uma volta atras do DMA
+        if( RingBuffDma_Used( &_dmasim.rb ) < lag )
+        {
+            gap = gap || ( RingBuffDma_Overruns( &_dmasim.rb ) != ov );
+            sched_yield();
+            continue;
+        }
+        lag = Host_RandN( 4 ) ? 0 : (DMASIM_N - 1 - Host_RandN( 8 ));
+
+        if( Host_RandN( 2 ) )
+        {
+            n = RingBuffDma_RdMany( &_dmasim.rb, el, 1 + Host_RandN( DMASIM_RD_MAX ) );
+        }
+        else
+        {
+            n = _dmasim_rdPtr( el, 1 + Host_RandN( DMASIM_RD_MAX ) );
+        }
+
+        //overrun: os elementos perdidos ficam para tras, mas a ordem continua
+        gap = gap || ( RingBuffDma_Overruns( &_dmasim.rb ) != ov );
+        for(ii=0; ii < n; ii++)
+        {
+            if( gap )
+            {
+                HOST_CHECK( el[ii] > next );
+                gap = false;
+            }
+            else
+            {
+                HOST_CHECK( el[ii] == next );
+            }
+            next = el[ii] + 1;
+        }
+        got += n;
+
+        if( n == 0 )
+        {
+            sched_yield();
+        }
+        if( Host_RandN( 2000 ) == 0 )
+        {
+            usleep( DMASIM_STALL_US );
+            stalls++;
+        }
+    }
+
+    memset( &tmr, 0, sizeof(tmr) );
+    setitimer( ITIMER_REAL, &tmr, NULL );
+    _dmasim.stop = 1;
+    pthread_join( thr, NULL );
+
+    printf( "read %llu elements, %u laps, %u stalls, %u overruns\n", (unsigned long long)got,
+            (unsigned)_dmasim.rb.laps, (unsigned)stalls, (unsigned)RingBuffDma_Overruns( &_dmasim.rb ) );
+
+    //cada pausa deixa o DMA dar mais de uma volta
+    HOST_CHECK( (stalls == 0) || (RingBuffDma_Overruns( &_dmasim.rb ) > 0) );
+
+    return Host_Result( "dma_sim" );
+}
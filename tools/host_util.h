@@ -0,0 +1,85 @@
+/**************************************************************************//**
+ * @file     host_util.h
+ * @brief    Helpers shared by the host tools: clock, PRNG and checks.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * Header-only, for the single-file programs under tools/. Linux/POSIX only.
+ *
+ ******************************************************************************/
+
+#ifndef TOOLS_HOST_UTIL_H_
+#define TOOLS_HOST_UTIL_H_
+
+#include <stdio.h>
+#include <time.h>
+#include "api_config.h"
+
+/** Failed checks so far */
+static uint32_t _host_fails;
+
+/** Counts and reports a failed condition. Unlike assert(), it stays with NDEBUG. */
+#define HOST_CHECK( __cond )                                                    \
+    do                                                                          \
+    {                                                                           \
+        if( !(__cond) )                                                         \
+        {                                                                       \
+            if( _host_fails++ < 10 )                                            \
+            {                                                                   \
+                fprintf( stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #__cond ); \
+            }                                                                   \
+        }                                                                       \
+    } while(0)
+
+/**
+ * Prints the result of a test program
+ *
+ * @return exit code: 0 when every check passed
+ */
+static INLINE int Host_Result(const char_t *pName)
+{
+    printf( "%s: %s (%u failed checks)\n", pName, (_host_fails == 0) ? "ok" : "FAILED", (unsigned)_host_fails );
+    return (_host_fails == 0) ? 0 : 1;
+}
+
+/**
+ * Monotonic time, in seconds
+ */
+static INLINE double Host_Now(void)
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint64_t _host_rnd = 88172645463325252ULL;
+
+/**
+ * Seeds #Host_Rand. Runs are reproducible for a given seed.
+ */
+static INLINE void Host_Seed(uint64_t pSeed)
+{
+    _host_rnd = (pSeed != 0) ? pSeed : 88172645463325252ULL;
+}
+
+/**
+ * Pseudo-random 32-bit word (xorshift64). Not for cryptography.
+ */
+static INLINE uint32_t Host_Rand(void)
+{
+    _host_rnd ^= _host_rnd << 13;
+    _host_rnd ^= _host_rnd >> 7;
+    _host_rnd ^= _host_rnd << 17;
+    return (uint32_t)( _host_rnd >> 32 );
+}
+
+/**
+ * Pseudo-random integer in [0, pN). pN must be at least 1.
+ */
+static INLINE uint32_t Host_RandN(uint32_t pN)
+{
+    return (uint32_t)( ((uint64_t)Host_Rand() * pN) >> 32 );
+}
+
+#endif /* TOOLS_HOST_UTIL_H_ */
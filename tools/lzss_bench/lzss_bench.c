@@ -0,0 +1,262 @@
+/**************************************************************************//**
+ * @file     lzss_bench.c
+ * @brief    Host benchmark of the LZSS codec: compression ratio and speed.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * For each kind of data (CSV telemetry lines, 16-byte binary records, random
+ * bytes, runs), it first round-trips short inputs through small rings with
+ * random budgets and chunk sizes, checking the output. Then it compresses
+ * and decompresses a large input with large budgets, and prints the ratio
+ * and the encode and decode throughput. Rings of elements wider than a byte
+ * must be refused.
+ *
+ * Build and run (from this directory):
+ *
+ *     cc -std=gnu99 -O2 -D__ARCH_AMD64__ -I../../includes -I.. -o lzss_bench \
+ *         lzss_bench.c ../../sources/common/lzss.c ../../sources/common/ring_buffer.c
+ *     ./lzss_bench [-n bytes]
+ *
+ * Add -DLZSS_WINDOW_BITS=<bits> and -DLZSS_LOOKAHEAD_BITS=<bits> for other
+ * window and match sizes.
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "common/lzss.h"
+#include "host_util.h"
+
+#define LZB_MAX_SZ          ( 1U << 22 )
+#define LZB_CHECK_REPS      ( 8 )
+#define LZB_CHECK_SZ        ( 20000 )
+
+enum
+{
+    eLzbCsv,
+    eLzbRecords,
+    eLzbRandom,
+    eLzbRuns,
+    eLzbKinds,
+};
+
+static const char_t * const _lzb_names[eLzbKinds] = { "csv", "records", "random", "runs" };
+
+static uint8_t _lzb_src[LZB_MAX_SZ];
+static uint8_t _lzb_dst[LZB_MAX_SZ];
+static uint8_t _lzb_comp[2 * LZB_MAX_SZ];
+
+/*
+ * Fills the input. Returns its size, up to pN bytes.
+ */
+static uint32_t _lzb_gen( uint32_t pKind, uint32_t pN )
+{
+    char_t line[96];
+    uint32_t ii = 0;
+    uint32_t t = 0;
+    uint32_t jj;
+    int len;
+    struct
+    {
+        uint32_t ts;
+        int16_t a, b, c, d;
+        uint32_t flags;
+    }rec;
+
+    switch( pKind )
+    {
+    case eLzbCsv:
+        while( ii < pN )
+        {
+            len = snprintf( line, sizeof(line), "%u,T=%u.%u,H=%u,V=%u\n", 1700000000 + t,
+                            20 + (t / 300) % 5, t % 10, 40 + (t / 1000) % 7, 3300 + Host_RandN( 3 ) );
+            for(jj=0; (jj < (uint32_t)len) && (ii < pN); jj++)
+            {
+                _lzb_src[ii++] = (uint8_t)line[jj];
+            }
+            t++;
+        }
+        break;
+
+    case eLzbRecords:
+        while( ii + sizeof(rec) <= pN )
+        {
+            rec.ts = 1000 * t;
+            rec.a = (int16_t)(100 + Host_RandN( 3 ));
+            rec.b = -50;
+            rec.c = (int16_t)(t / 64);
+            rec.d = 7;
+            rec.flags = 0xA5;
+            memcpy( &_lzb_src[ii], &rec, sizeof(rec) );
+            ii += sizeof(rec);
+            t++;
+        }
+        break;
+
+    case eLzbRandom:
+        for(; ii < pN; ii++)
+        {
+            _lzb_src[ii] = (uint8_t)Host_Rand();
+        }
+        break;
+
+    default:
+        for(; ii < pN; ii++)
+        {
+            _lzb_src[ii] = ((ii / 37) % 2) ? 'a' : (uint8_t)(ii % 251);
+        }
+        break;
+    }
+
+    return ii;
+}
+
+/*
+ * Gets a random amount up to pMax, or pMax itself when not checking
+ */
+static uint32_t _lzb_amount( bool_t pRandom, uint32_t pMax )
+{
+    return pRandom ? Host_RandN( pMax ) : pMax;
+}
+
+/*
+ * Compresses pN bytes of the input and decompresses them. Returns the
+ * compressed size; the times are in seconds.
+ */
+static uint32_t _lzb_roundTrip( uint32_t pN, bool_t pCheck, double *pEncT, double *pDecT )
+{
+    static uint8_t inBuff[97];
+    static uint8_t outBuff[61];
+    static uint8_t cinBuff[4096];
+    static uint8_t doutBuff[53];
+    ringbuff_t in;
+    ringbuff_t out;
+    ringbuff_t cin;
+    ringbuff_t dout;
+    lzss_enc_t enc;
+    lzss_dec_t dec;
+    uint32_t si = 0;
+    uint32_t ci = 0;
+    uint32_t cr = 0;
+    uint32_t di = 0;
+    res_t res = RES_ERR_BUSY;
+    double t0;
+
+    RingBuff_Init( &in, inBuff, sizeof(inBuff), 1 );
+    RingBuff_Init( &out, outBuff, sizeof(outBuff), 1 );
+    RingBuff_Init( &cin, cinBuff, sizeof(cinBuff), 1 );
+    RingBuff_Init( &dout, doutBuff, sizeof(doutBuff), 1 );
+    Lzss_EncInit( &enc );
+    Lzss_DecInit( &dec );
+
+    t0 = Host_Now();
+    while( res != RES_SUCCESS )
+    {
+        si += RingBuff_WrMany( &in, &_lzb_src[si], MIN( _lzb_amount( pCheck, sizeof(inBuff) ), pN - si ), false );
+        res = Lzss_EncPoll( &enc, &in, &out, _lzb_amount( pCheck, 40 ) + (pCheck ? 0 : 4096), (bool_t)(si == pN) );
+        HOST_CHECK( res != RES_ERROR );
+        ci += RingBuff_RdMany( &out, &_lzb_comp[ci], _lzb_amount( pCheck, 64 ) );
+        if( res == RES_SUCCESS )
+        {
+            ci += RingBuff_RdMany( &out, &_lzb_comp[ci], sizeof(outBuff) );
+        }
+    }
+    *pEncT = Host_Now() - t0;
+
+    t0 = Host_Now();
+    while( di < pN )
+    {
+        cr += RingBuff_WrMany( &cin, &_lzb_comp[cr], MIN( _lzb_amount( pCheck, 80 ) + (pCheck ? 0 : 4096), ci - cr ), false );
+        res = Lzss_DecPoll( &dec, &cin, &dout, _lzb_amount( pCheck, 50 ) + (pCheck ? 0 : 100000) );
+        HOST_CHECK( res != RES_ERROR );
+        di += RingBuff_RdMany( &dout, &_lzb_dst[di], MIN( _lzb_amount( pCheck, 64 ), pN - di ) );
+
+        //sem entrada e sem saida pendente: o fluxo acabou antes da hora
+        if( (cr == ci) && (res == RES_ERR_NO_MORE_RECORDS) && (RingBuff_Used( &dout ) == 0) && (di < pN) )
+        {
+            HOST_CHECK( di == pN );
+            break;
+        }
+    }
+    *pDecT = Host_Now() - t0;
+
+    //os bits de enchimento do final nao geram bytes
+    Lzss_DecPoll( &dec, &cin, &dout, 1000 );
+    HOST_CHECK( RingBuff_Used( &dout ) == 0 );
+    HOST_CHECK( memcmp( _lzb_src, _lzb_dst, pN ) == 0 );
+
+    return ci;
+}
+
+/*
+ * Rings of wider elements are refused, untouched
+ */
+static void _lzb_checkSz( void )
+{
+    static uint8_t bytes[64];
+    static uint16_t words[32];
+    ringbuff_t rb8;
+    ringbuff_t rb16;
+    lzss_enc_t enc;
+    lzss_dec_t dec;
+
+    RingBuff_Init( &rb8, bytes, sizeof(bytes), 1 );
+    RingBuff_Init( &rb16, words, sizeof(words), 2 );
+    RingBuff_WrMany( &rb8, _lzb_src, 20, false );
+    RingBuff_WrMany( &rb16, _lzb_src, 10, false );
+    Lzss_EncInit( &enc );
+    Lzss_DecInit( &dec );
+
+    HOST_CHECK( Lzss_EncPoll( &enc, &rb16, &rb8, 100, true ) == RES_ERR_SZ );
+    HOST_CHECK( Lzss_EncPoll( &enc, &rb8, &rb16, 100, true ) == RES_ERR_SZ );
+    HOST_CHECK( Lzss_DecPoll( &dec, &rb16, &rb8, 100 ) == RES_ERR_SZ );
+    HOST_CHECK( Lzss_DecPoll( &dec, &rb8, &rb16, 100 ) == RES_ERR_SZ );
+    HOST_CHECK( (RingBuff_Used( &rb8 ) == 20) && (RingBuff_Used( &rb16 ) == 10) );
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t n = 1U << 20;
+    uint32_t kind;
+    uint32_t rep;
+    uint32_t len;
+    uint32_t comp;
+    double encT;
+    double decT;
+    int opt;
+
+    while( (opt = getopt( argc, argv, "n:" )) != -1 )
+    {
+        switch( opt )
+        {
+        case 'n':
+            n = MIN( (uint32_t)strtoul( optarg, NULL, 0 ), LZB_MAX_SZ );
+            break;
+        default:
+            fprintf( stderr, "usage: %s [-n bytes]\n", argv[0] );
+            return 2;
+        }
+    }
+    Host_Seed( 1 );
+
+    _lzb_checkSz();
+
+    printf( "window %u bytes, lookahead %u bytes, %u bytes per input\n", LZSS_WINDOW_SZ, LZSS_LOOKAHEAD_SZ, n );
+
+    for(kind=0; kind < eLzbKinds; kind++)
+    {
+        for(rep=0; rep < LZB_CHECK_REPS; rep++)
+        {
+            len = _lzb_gen( kind, Host_RandN( LZB_CHECK_SZ ) );
+            _lzb_roundTrip( len, true, &encT, &decT );
+        }
+
+        len = _lzb_gen( kind, n );
+        comp = _lzb_roundTrip( len, false, &encT, &decT );
+        printf( "%-8s %8u -> %8u (%5.2fx)  enc %6.1f MB/s  dec %6.1f MB/s\n", _lzb_names[kind], len, comp,
+                (double)len / MAX( comp, 1U ), (double)len / encT * 1e-6, (double)len / decT * 1e-6 );
+    }
+
+    return Host_Result( "lzss_bench" );
+}
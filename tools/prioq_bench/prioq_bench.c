@@ -0,0 +1,299 @@
+/**************************************************************************//**
+ * @file     prioq_bench.c
+ * @brief    Host check and benchmark of the priority queue.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * First checks random sequences of #PrioQ_Push, #PrioQ_PushMany, #PrioQ_Pop
+ * and #PrioQ_PopUntil against a model (an unsorted array, scanned for the
+ * smallest key), on an unaligned buffer, and a full heapify drained in order.
+ *
+ * Then, with N from 16 to 1024 items pending, times the steady state of a
+ * deadline queue (take the earliest, add a new one) with the heap and with a
+ * #ringbuff_t FIFO scanned for the earliest item, and a batch of 4096 items
+ * pushed at once against one by one.
+ *
+ * Build and run (from this directory):
+ *
+ *     cc -std=gnu99 -O2 -D__ARCH_AMD64__ -I../../includes -I.. -o prioq_bench \
+ *         prioq_bench.c ../../sources/common/prio_queue.c ../../sources/common/ring_buffer.c
+ *     ./prioq_bench
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include "common/prio_queue.h"
+#include "common/ring_buffer.h"
+#include "host_util.h"
+
+#define PQB_MAX             ( 4096 )
+#define PQB_ROUNDS          ( 300 )
+#define PQB_KEYS            ( 1000 )    //poucas chaves: muitas repetidas
+#define PQB_STEADY          ( 2000000 )
+#define PQB_BATCH_REPS      ( 200 )
+
+/** 16-byte item, deadline first */
+typedef struct
+{
+    uint32_t key;
+    uint32_t id;
+    uint32_t pad[2];
+}pqb_item_t;
+
+static uint8_t _pqb_mem[PQB_MAX * sizeof(pqb_item_t) + 3];
+static pqb_item_t _pqb_model[PQB_MAX];
+static uint32_t _pqb_n;
+static pqb_item_t _pqb_batch[PQB_MAX];
+
+/*
+ * Removes the item from the model. It must be there and have the smallest key.
+ */
+static void _pqb_take( const pqb_item_t *pIt )
+{
+    uint32_t at = _pqb_n;
+    uint32_t ii;
+
+    for(ii=0; ii < _pqb_n; ii++)
+    {
+        HOST_CHECK( _pqb_model[ii].key >= pIt->key );
+        if( (_pqb_model[ii].key == pIt->key) && (_pqb_model[ii].id == pIt->id) )
+        {
+            at = ii;
+        }
+    }
+    HOST_CHECK( at < _pqb_n );
+    if( at < _pqb_n )
+    {
+        _pqb_model[at] = _pqb_model[--_pqb_n];
+    }
+}
+
+static void _pqb_check( void )
+{
+    pqb_item_t out[64];
+    pqb_item_t it;
+    prioq_t q;
+    uint32_t cap;
+    uint32_t id = 0;
+    uint32_t round;
+    uint32_t ops;
+    uint32_t due;
+    uint32_t n;
+    uint32_t k;
+    uint32_t ii;
+    uint32_t last;
+
+    //buffer desalinhado: o inicio e alinhado internamente
+    cap = PrioQ_Init( &q, &_pqb_mem[1], sizeof(_pqb_mem) - 1, sizeof(pqb_item_t) );
+    HOST_CHECK( (cap >= PQB_MAX - 1) && (((uintptr_t)q.data & 3) == 0) );
+    HOST_CHECK( PrioQ_Init( &q, _pqb_mem, sizeof(_pqb_mem), 6 ) == 0 );
+    cap = PrioQ_Init( &q, &_pqb_mem[1], sizeof(_pqb_mem) - 1, sizeof(pqb_item_t) );
+
+    for(round=0; round < PQB_ROUNDS; round++)
+    {
+        PrioQ_Flush( &q );
+        _pqb_n = 0;
+
+        for(ops=Host_RandN( 3000 ); ops > 0; ops--)
+        {
+            switch( Host_RandN( 10 ) )
+            {
+            case 0: case 1: case 2: case 3: case 4:
+                it.key = Host_RandN( PQB_KEYS );
+                it.id = id++;
+                if( _pqb_n == cap )
+                {
+                    HOST_CHECK( PrioQ_Push( &q, &it ) == RES_ERR_OVERFLOW );
+                    break;
+                }
+                HOST_CHECK( PrioQ_Push( &q, &it ) == RES_SUCCESS );
+                _pqb_model[_pqb_n++] = it;
+                break;
+
+            case 5:
+                //lote: cabe inteiro ou nada entra
+                k = Host_RandN( 2 * _pqb_n + 40 );
+                for(ii=0; ii < MIN( k, (uint32_t)PQB_MAX ); ii++)
+                {
+                    _pqb_batch[ii].key = Host_RandN( PQB_KEYS );
+                    _pqb_batch[ii].id = id++;
+                }
+                if( k > cap - _pqb_n )
+                {
+                    HOST_CHECK( PrioQ_PushMany( &q, _pqb_batch, k ) == RES_ERR_OVERFLOW );
+                    break;
+                }
+                HOST_CHECK( PrioQ_PushMany( &q, _pqb_batch, k ) == RES_SUCCESS );
+                memcpy( &_pqb_model[_pqb_n], _pqb_batch, k * sizeof(pqb_item_t) );
+                _pqb_n += k;
+                break;
+
+            case 6: case 7: case 8:
+                if( _pqb_n == 0 )
+                {
+                    HOST_CHECK( (PrioQ_Pop( &q, &it ) == RES_ERR_NO_MORE_RECORDS) && (PrioQ_Peek( &q ) == NULL) );
+                    break;
+                }
+                HOST_CHECK( PrioQ_Pop( &q, &it ) == RES_SUCCESS );
+                _pqb_take( &it );
+                break;
+
+            default:
+                due = Host_RandN( PQB_KEYS );
+                k = 0;
+                for(ii=0; ii < _pqb_n; ii++)
+                {
+                    k += ( _pqb_model[ii].key <= due );
+                }
+                n = PrioQ_PopUntil( &q, due, out, 64 );
+                HOST_CHECK( n == MIN( k, 64U ) );
+                for(ii=0; ii < n; ii++)
+                {
+                    HOST_CHECK( out[ii].key <= due );
+                    _pqb_take( &out[ii] );
+                }
+                break;
+            }
+
+            HOST_CHECK( PrioQ_Used( &q ) == _pqb_n );
+        }
+    }
+
+    //heap inteiro de uma vez, drenado em ordem
+    PrioQ_Flush( &q );
+    for(ii=0; ii < cap; ii++)
+    {
+        _pqb_batch[ii].key = Host_Rand();
+    }
+    HOST_CHECK( PrioQ_PushMany( &q, _pqb_batch, cap ) == RES_SUCCESS );
+    last = 0;
+    for(ii=0; ii < cap; ii++)
+    {
+        HOST_CHECK( (PrioQ_Pop( &q, &it ) == RES_SUCCESS) && (it.key >= last) );
+        last = it.key;
+    }
+    HOST_CHECK( PrioQ_Pop( &q, &it ) == RES_ERR_NO_MORE_RECORDS );
+}
+
+/*
+ * Steady state with N pending: take the earliest, add one later
+ */
+static void _pqb_steady( uint32_t pN )
+{
+    static pqb_item_t rbMem[1024];
+    const uint32_t reps = PQB_STEADY / (pN / 16);
+    volatile uint32_t sink = 0;
+    pqb_item_t it = { 0, 0, { 0, 0 } };
+    pqb_item_t *p;
+    ringbuff_t rb;
+    prioq_t q;
+    uint32_t best;
+    uint32_t bestKey;
+    uint32_t ii;
+    uint32_t k;
+    double t0;
+    double tHeap;
+    double tFifo;
+
+    PrioQ_Init( &q, _pqb_mem, sizeof(_pqb_mem), sizeof(pqb_item_t) );
+    RingBuff_Init( &rb, rbMem, pN * sizeof(pqb_item_t), sizeof(pqb_item_t) );
+    for(ii=0; ii < pN; ii++)
+    {
+        it.key = Host_RandN( 4096 );
+        it.id = ii;
+        PrioQ_Push( &q, &it );
+        RingBuff_WrOne( &rb, &it, false );
+    }
+
+    t0 = Host_Now();
+    for(ii=0; ii < reps; ii++)
+    {
+        PrioQ_Pop( &q, &it );
+        sink += it.id;
+        it.key += Host_RandN( 4096 );
+        PrioQ_Push( &q, &it );
+    }
+    tHeap = (Host_Now() - t0) * 1e9 / reps;
+
+    //FIFO: procura o mais cedo e o tira girando os anteriores para o fim
+    t0 = Host_Now();
+    for(ii=0; ii < reps / 4; ii++)
+    {
+        best = 0;
+        bestKey = 0xFFFFFFFF;
+        for(k=0; k < pN; k++)
+        {
+            p = RingBuff_PeekAt( &rb, k );
+            if( p->key < bestKey )
+            {
+                bestKey = p->key;
+                best = k;
+            }
+        }
+        for(k=0; k < best; k++)
+        {
+            RingBuff_RdOne( &rb, &it );
+            RingBuff_WrOne( &rb, &it, false );
+        }
+        RingBuff_RdOne( &rb, &it );
+        sink += it.id;
+        it.key += Host_RandN( 4096 );
+        RingBuff_WrOne( &rb, &it, false );
+    }
+    tFifo = (Host_Now() - t0) * 1e9 / (reps / 4);
+
+    HOST_CHECK( (PrioQ_Used( &q ) == pN) && (RingBuff_Used( &rb ) == pN) );
+    printf( "N=%4u  heap pop+push %6.1f ns  FIFO scan %8.1f ns  (%.1fx)\n",
+            (unsigned)pN, tHeap, tFifo, tFifo / tHeap );
+    (void)sink;
+}
+
+static void _pqb_batchBench( void )
+{
+    prioq_t q;
+    uint32_t rep;
+    uint32_t ii;
+    double t0;
+
+    PrioQ_Init( &q, _pqb_mem, sizeof(_pqb_mem), sizeof(pqb_item_t) );
+    for(ii=0; ii < PQB_MAX; ii++)
+    {
+        _pqb_batch[ii].key = Host_Rand();
+    }
+
+    t0 = Host_Now();
+    for(rep=0; rep < PQB_BATCH_REPS; rep++)
+    {
+        PrioQ_Flush( &q );
+        PrioQ_PushMany( &q, _pqb_batch, PQB_MAX );
+    }
+    printf( "%u items: PushMany %.1f us", (unsigned)PQB_MAX, (Host_Now() - t0) * 1e6 / PQB_BATCH_REPS );
+
+    t0 = Host_Now();
+    for(rep=0; rep < PQB_BATCH_REPS; rep++)
+    {
+        PrioQ_Flush( &q );
+        for(ii=0; ii < PQB_MAX; ii++)
+        {
+            PrioQ_Push( &q, &_pqb_batch[ii] );
+        }
+    }
+    printf( ", single pushes %.1f us\n", (Host_Now() - t0) * 1e6 / PQB_BATCH_REPS );
+    HOST_CHECK( PrioQ_Used( &q ) == PQB_MAX );
+}
+
+int main(void)
+{
+    uint32_t n;
+
+    Host_Seed( 1 );
+    _pqb_check();
+
+    for(n=16; n <= 1024; n*=4)
+    {
+        _pqb_steady( n );
+    }
+    _pqb_batchBench();
+
+    return Host_Result( "prioq_bench" );
+}
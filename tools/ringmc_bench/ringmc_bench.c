@@ -0,0 +1,345 @@
+/**************************************************************************//**
+ * @file     ringmc_bench.c
+ * @brief    Host benchmark: cross-core SPSC throughput of #ringbuff_mc_t
+ * against #ringbuff_t.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * A producer thread streams sequence numbers to a consumer thread, each
+ * pinned to its own core, through:
+ * - rb: a #ringbuff_t shared with the _Locked variants (head, tail and the
+ *   full flag on one cache line, plus the lock)
+ * - mc: a #ringbuff_mc_t (head and tail on separate lines, cached indexes)
+ *
+ * The consumer checks the order. For each ring it prints the throughput and,
+ * when the kernel allows perf events, the cache misses and L1D read misses
+ * per element of both threads. perf_event_paranoid must be 2 or less.
+ *
+ * Build and use (from this directory):
+ *
+ *     cc -std=gnu99 -O2 -D__ARCH_AMD64__ -I../../includes -I.. -o ringmc_bench \
+ *         ringmc_bench.c ../../sources/common/ring_buffer.c \
+ *         ../../sources/common/ring_buffer_mc.c -lpthread
+ *     ./ringmc_bench [-n elements] [-p producer_cpu] [-c consumer_cpu] [-b batch] [-r rb|mc]
+ *
+ * The cross-core transfers themselves (HITM: a load served by a line modified
+ * in another core's cache) are counted by perf c2c, per ring:
+ *
+ *     perf c2c record -- ./ringmc_bench -r rb
+ *     perf c2c report --stats
+ *
+ * Pick CPUs on different physical cores (see lscpu -e): hyperthread siblings
+ * share the L1 and hide the traffic.
+ *
+ ******************************************************************************/
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "common/ring_buffer.h"
+#include "common/ring_buffer_mc.h"
+#include "host_util.h"
+
+#define RMCB_RING_SZ        ( 4096 )    //bytes: 512 elements of 8 bytes
+#define RMCB_BATCH_MAX      ( 64 )
+#define RMCB_SPINS          ( 64 )      //tentativas antes de ceder a CPU
+
+enum
+{
+    eRmcbRb,
+    eRmcbMc,
+};
+
+/** Perf counters of the process, inherited by the threads */
+typedef struct
+{
+    int fd[2];
+}rmcb_counters_t;
+
+static struct
+{
+    ringbuff_t rb;
+    arch_lock_t lock;
+    ringbuff_mc_t mc;
+    uint8_t rbBuff[RMCB_RING_SZ] ATTR_ALIGNED(ARCH_CACHE_LINE_SZ);
+    uint8_t mcBuff[RMCB_RING_SZ] ATTR_ALIGNED(ARCH_CACHE_LINE_SZ);
+    uint64_t n;
+    uint32_t batch;
+    int kind;
+    int cpu[2];
+    volatile uint32_t start;
+    uint64_t errors;
+}_rmcb;
+
+static int _rmcb_perfOpen( uint32_t pType, uint64_t pConfig )
+{
+    struct perf_event_attr attr;
+
+    memset( &attr, 0, sizeof(attr) );
+    attr.size = sizeof(attr);
+    attr.type = pType;
+    attr.config = pConfig;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return (int)syscall( SYS_perf_event_open, &attr, 0, -1, -1, 0 );
+}
+
+static void _rmcb_perfStart( rmcb_counters_t *pC )
+{
+    uint32_t ii;
+
+    pC->fd[0] = _rmcb_perfOpen( PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES );
+    pC->fd[1] = _rmcb_perfOpen( PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+            (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) );
+
+    for(ii=0; ii < 2; ii++)
+    {
+        if( pC->fd[ii] >= 0 )
+        {
+            ioctl( pC->fd[ii], PERF_EVENT_IOC_RESET, 0 );
+            ioctl( pC->fd[ii], PERF_EVENT_IOC_ENABLE, 0 );
+        }
+    }
+}
+
+/*
+ * Stops a counter and gets its value, including the joined threads. -1 when not available.
+ */
+static double _rmcb_perfStop( rmcb_counters_t *pC, uint32_t pIdx )
+{
+    uint64_t val;
+
+    if( pC->fd[pIdx] < 0 )
+    {
+        return -1;
+    }
+
+    ioctl( pC->fd[pIdx], PERF_EVENT_IOC_DISABLE, 0 );
+    if( read( pC->fd[pIdx], &val, sizeof(val) ) != sizeof(val) )
+    {
+        val = 0;
+    }
+    close( pC->fd[pIdx] );
+
+    return (double)val;
+}
+
+static bool_t _rmcb_pin( int pCpu )
+{
+    cpu_set_t set;
+
+    CPU_ZERO( &set );
+    CPU_SET( pCpu, &set );
+
+    return (bool_t)( pthread_setaffinity_np( pthread_self(), sizeof(set), &set ) == 0 );
+}
+
+/*
+ * Waits for the other side. Spins first, then yields, so it also runs on one CPU.
+ */
+static void _rmcb_wait( uint32_t *pSpins )
+{
+    if( ++(*pSpins) >= RMCB_SPINS )
+    {
+        *pSpins = 0;
+        sched_yield();
+    }
+}
+
+static void *_rmcb_producer( void *pArg )
+{
+    uint64_t el[RMCB_BATCH_MAX];
+    uint64_t seq = 0;
+    uint32_t spins = 0;
+    uint32_t n;
+    uint32_t ii;
+
+    (void)pArg;
+    if( !_rmcb_pin( _rmcb.cpu[0] ) )
+    {
+        fprintf( stderr, "warning: producer not pinned to CPU %d\n", _rmcb.cpu[0] );
+    }
+    while( !__atomic_load_n( &_rmcb.start, __ATOMIC_ACQUIRE ) )
+    {
+    }
+
+    while( seq < _rmcb.n )
+    {
+        n = (uint32_t)MIN( (uint64_t)_rmcb.batch, _rmcb.n - seq );
+        for(ii=0; ii < n; ii++)
+        {
+            el[ii] = seq + ii;
+        }
+
+        if( _rmcb.kind == eRmcbRb )
+        {
+            n = RingBuff_WrManyLocked( &_rmcb.rb, &_rmcb.lock, el, n );
+        }
+        else
+        {
+            n = RingBuffMc_WrMany( &_rmcb.mc, el, n );
+        }
+
+        if( n == 0 )
+        {
+            _rmcb_wait( &spins );
+        }
+        seq += n;
+    }
+
+    return NULL;
+}
+
+static void *_rmcb_consumer( void *pArg )
+{
+    uint64_t el[RMCB_BATCH_MAX];
+    uint64_t seq = 0;
+    uint32_t spins = 0;
+    uint32_t n;
+    uint32_t ii;
+
+    (void)pArg;
+    if( !_rmcb_pin( _rmcb.cpu[1] ) )
+    {
+        fprintf( stderr, "warning: consumer not pinned to CPU %d\n", _rmcb.cpu[1] );
+    }
+    while( !__atomic_load_n( &_rmcb.start, __ATOMIC_ACQUIRE ) )
+    {
+    }
+
+    while( seq < _rmcb.n )
+    {
+        if( _rmcb.kind == eRmcbRb )
+        {
+            n = RingBuff_RdManyLocked( &_rmcb.rb, &_rmcb.lock, el, _rmcb.batch );
+        }
+        else
+        {
+            n = RingBuffMc_RdMany( &_rmcb.mc, el, _rmcb.batch );
+        }
+
+        if( n == 0 )
+        {
+            _rmcb_wait( &spins );
+        }
+        for(ii=0; ii < n; ii++)
+        {
+            _rmcb.errors += ( el[ii] != seq + ii );
+        }
+        seq += n;
+    }
+
+    return NULL;
+}
+
+static void _rmcb_run( int pKind )
+{
+    arch_lock_t lock = ARCH_LOCK_INIT;
+    rmcb_counters_t cnt;
+    pthread_t thr[2];
+    double t0;
+    double dt;
+    double miss;
+    double l1d;
+    uint64_t errors = _rmcb.errors;
+
+    _rmcb.kind = pKind;
+    _rmcb.start = 0;
+    _rmcb.lock = lock;
+    RingBuff_Init( &_rmcb.rb, _rmcb.rbBuff, sizeof(_rmcb.rbBuff), sizeof(uint64_t) );
+    RingBuffMc_Init( &_rmcb.mc, _rmcb.mcBuff, sizeof(_rmcb.mcBuff), sizeof(uint64_t) );
+
+    //contadores herdados pelas threads criadas depois
+    _rmcb_perfStart( &cnt );
+    pthread_create( &thr[0], NULL, _rmcb_producer, NULL );
+    pthread_create( &thr[1], NULL, _rmcb_consumer, NULL );
+
+    t0 = Host_Now();
+    __atomic_store_n( &_rmcb.start, 1, __ATOMIC_RELEASE );
+    pthread_join( thr[0], NULL );
+    pthread_join( thr[1], NULL );
+    dt = Host_Now() - t0;
+
+    miss = _rmcb_perfStop( &cnt, 0 );
+    l1d = _rmcb_perfStop( &cnt, 1 );
+
+    printf( "%-3s  %8.1f M el/s  %7.2f ns/el", (pKind == eRmcbRb) ? "rb" : "mc",
+            (double)_rmcb.n / dt * 1e-6, dt * 1e9 / (double)_rmcb.n );
+    if( miss >= 0 )
+    {
+        printf( "  cache-miss/el %6.3f", miss / (double)_rmcb.n );
+    }
+    else
+    {
+        printf( "  cache-miss/el    n/a" );
+    }
+    if( l1d >= 0 )
+    {
+        printf( "  L1D-rd-miss/el %6.3f", l1d / (double)_rmcb.n );
+    }
+    else
+    {
+        printf( "  L1D-rd-miss/el    n/a" );
+    }
+    printf( "  %s\n", (_rmcb.errors == errors) ? "order ok" : "ORDER ERRORS" );
+}
+
+int main(int argc, char **argv)
+{
+    const char_t *ring = NULL;
+    int opt;
+
+    _rmcb.n = 20000000;
+    _rmcb.batch = 1;
+    _rmcb.cpu[0] = 0;
+    _rmcb.cpu[1] = 1;
+
+    while( (opt = getopt( argc, argv, "n:p:c:b:r:" )) != -1 )
+    {
+        switch( opt )
+        {
+        case 'n':
+            _rmcb.n = strtoull( optarg, NULL, 0 );
+            break;
+        case 'p':
+            _rmcb.cpu[0] = atoi( optarg );
+            break;
+        case 'c':
+            _rmcb.cpu[1] = atoi( optarg );
+            break;
+        case 'b':
+            _rmcb.batch = (uint32_t)atoi( optarg );
+            break;
+        case 'r':
+            ring = optarg;
+            break;
+        default:
+            fprintf( stderr, "usage: %s [-n elements] [-p producer_cpu] [-c consumer_cpu] [-b batch] [-r rb|mc]\n", argv[0] );
+            return 2;
+        }
+    }
+    _rmcb.batch = MAX( 1U, MIN( _rmcb.batch, (uint32_t)RMCB_BATCH_MAX ) );
+
+    printf( "%llu elements of 8 bytes, batch %u, producer CPU %d, consumer CPU %d, %ld CPUs online\n",
+            (unsigned long long)_rmcb.n, _rmcb.batch, _rmcb.cpu[0], _rmcb.cpu[1], sysconf( _SC_NPROCESSORS_ONLN ) );
+
+    if( (ring == NULL) || (strcmp( ring, "rb" ) == 0) )
+    {
+        _rmcb_run( eRmcbRb );
+    }
+    if( (ring == NULL) || (strcmp( ring, "mc" ) == 0) )
+    {
+        _rmcb_run( eRmcbMc );
+    }
+
+    return (_rmcb.errors == 0) ? 0 : 1;
+}
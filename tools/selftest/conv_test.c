@@ -0,0 +1,276 @@
+/**************************************************************************//**
+ * @file     conv_test.c
+ * @brief    Host self-test of the array to string conversions.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * Random arrays, formats (CSV with and without keys, custom separators,
+ * JSON arrays and objects) and value ranges, including INT32_MIN and
+ * UINT32_MAX, are checked against snprintf. Also checks the overflow limit
+ * (nothing written on overflow) and the ring versions across the wrap.
+ *
+ * Build and run (from this directory):
+ *
+ *     cc -std=gnu99 -O2 -D__ARCH_AMD64__ -I../../includes -I.. -o conv_test \
+ *         conv_test.c ../../sources/common/conv.c ../../sources/common/ring_buffer.c
+ *     ./conv_test [-b]
+ *
+ * With -b it also times a 20-field line: #Conv_IntArrToStr against
+ * #Conv_IntToStr plus strcat, and against sprintf.
+ *
+ ******************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include "common/conv.h"
+#include "host_util.h"
+
+#define CVTEST_ITERS        ( 100000 )
+#define CVTEST_MAX_N        ( 8 )
+#define CVTEST_LINE_SZ      ( 256 )
+#define CVTEST_BENCH_N      ( 500000 )
+
+static const char_t * const _cvtest_keys[CVTEST_MAX_N] = { "a", "bb", "t0", "hum", "v", "x_1", "Z", "key7" };
+
+/*
+ * Reference line, with snprintf. pVals holds signed or unsigned values.
+ */
+static uint32_t _cvtest_ref( const uint32_t *pVals, uint32_t pN, bool_t pSigned, const conv_arrfmt_t *pFmt, char_t *pOut )
+{
+    const bool_t json = (bool_t)( pFmt->fmt == CONV_ARR_JSON );
+    char_t *p = pOut;
+    uint32_t ii;
+
+    if( json )
+    {
+        *p++ = ( pFmt->keys != NULL ) ? '{' : '[';
+    }
+    for(ii=0; ii < pN; ii++)
+    {
+        if( ii > 0 )
+        {
+            *p++ = json ? ',' : pFmt->sep;
+        }
+        if( pFmt->keys != NULL )
+        {
+            p += sprintf( p, json ? "\"%s\":" : "%s=", pFmt->keys[ii] );
+        }
+        p += pSigned ? sprintf( p, "%d", (int32_t)pVals[ii] ) : sprintf( p, "%u", pVals[ii] );
+    }
+    if( json )
+    {
+        *p++ = ( pFmt->keys != NULL ) ? '}' : ']';
+    }
+    *p = 0;
+
+    return (uint32_t)(p - pOut);
+}
+
+/*
+ * Values of every length: a random word shifted right, or a limit
+ */
+static uint32_t _cvtest_val( void )
+{
+    static const uint32_t lim[] = { 0, 1, 9, 10, 99, 100, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF, 999999999, 1000000000 };
+
+    if( Host_RandN( 8 ) == 0 )
+    {
+        return lim[Host_RandN( sizeof(lim) / sizeof(lim[0]) )];
+    }
+
+    return Host_Rand() >> Host_RandN( 32 );
+}
+
+static void _cvtest_fmt( conv_arrfmt_t *pFmt )
+{
+    static const char_t seps[] = { ',', ';', '\t', ' ' };
+
+    pFmt->keys = Host_RandN( 2 ) ? _cvtest_keys : NULL;
+    pFmt->sep = seps[Host_RandN( sizeof(seps) )];
+    pFmt->fmt = Host_RandN( 2 ) ? CONV_ARR_JSON : CONV_ARR_CSV;
+}
+
+static void _cvtest_str( void )
+{
+    char_t ref[CVTEST_LINE_SZ];
+    char_t out[CVTEST_LINE_SZ];
+    uint32_t vals[CVTEST_MAX_N];
+    conv_arrfmt_t fmt;
+    bool_t sgn;
+    uint32_t refLen;
+    uint32_t len;
+    uint32_t n;
+    uint32_t iter;
+    uint32_t ii;
+    res_t res;
+
+    for(iter=0; iter < CVTEST_ITERS; iter++)
+    {
+        n = Host_RandN( CVTEST_MAX_N + 1 );
+        for(ii=0; ii < n; ii++)
+        {
+            vals[ii] = _cvtest_val();
+        }
+        _cvtest_fmt( &fmt );
+        sgn = (bool_t)Host_RandN( 2 );
+        refLen = _cvtest_ref( vals, n, sgn, &fmt, ref );
+
+        //cabe exatamente
+        memset( out, 'X', sizeof(out) );
+        len = 0xFFFF;
+        res = sgn ? Conv_IntArrToStr( (const int32_t *)vals, n, &fmt, out, refLen, &len )
+                  : Conv_UIntArrToStr( vals, n, &fmt, out, refLen, &len );
+        HOST_CHECK( (res == RES_SUCCESS) && (len == refLen) );
+        HOST_CHECK( memcmp( out, ref, refLen + 1 ) == 0 );
+        HOST_CHECK( out[refLen + 1] == 'X' );
+
+        //um a menos: nada escrito
+        if( refLen > 0 )
+        {
+            memset( out, 'X', sizeof(out) );
+            res = sgn ? Conv_IntArrToStr( (const int32_t *)vals, n, &fmt, out, refLen - 1, NULL )
+                      : Conv_UIntArrToStr( vals, n, &fmt, out, refLen - 1, NULL );
+            HOST_CHECK( (res == RES_ERR_OVERFLOW) && (out[0] == 'X') );
+        }
+    }
+
+    //NULL: CSV com ','
+    vals[0] = 5;
+    vals[1] = (uint32_t)INT32_MIN;
+    HOST_CHECK( Conv_IntArrToStr( (const int32_t *)vals, 2, NULL, out, sizeof(out) - 1, &len ) == RES_SUCCESS );
+    HOST_CHECK( (strcmp( out, "5,-2147483648" ) == 0) && (len == 13) );
+}
+
+static void _cvtest_ring( void )
+{
+    static uint8_t buff[97];
+    static uint16_t buff16[8];
+    char_t ref[CVTEST_LINE_SZ];
+    char_t out[CVTEST_LINE_SZ];
+    uint32_t vals[CVTEST_MAX_N];
+    conv_arrfmt_t fmt;
+    ringbuff_t rb;
+    bool_t sgn;
+    uint32_t cap;
+    uint32_t refLen;
+    uint32_t used;
+    uint32_t len;
+    uint32_t n;
+    uint32_t iter;
+    uint32_t ii;
+    res_t res;
+
+    cap = RingBuff_Init( &rb, buff, sizeof(buff), 1 );
+    HOST_CHECK( cap > 0 );
+
+    for(iter=0; iter < CVTEST_ITERS; iter++)
+    {
+        //desloca o início para atravessar a volta
+        RingBuff_Flush( &rb );
+        RingBuff_WrMany( &rb, out, Host_RandN( cap ), false );
+        RingBuff_RdMany( &rb, NULL, RingBuff_Used( &rb ) );
+        RingBuff_WrMany( &rb, out, Host_RandN( cap / 2 ), false );
+        used = RingBuff_Used( &rb );
+
+        n = Host_RandN( CVTEST_MAX_N + 1 );
+        for(ii=0; ii < n; ii++)
+        {
+            vals[ii] = _cvtest_val();
+        }
+        _cvtest_fmt( &fmt );
+        sgn = (bool_t)Host_RandN( 2 );
+        refLen = _cvtest_ref( vals, n, sgn, &fmt, ref );
+
+        len = 0xFFFF;
+        res = sgn ? Conv_IntArrToRing( &rb, (const int32_t *)vals, n, &fmt, &len )
+                  : Conv_UIntArrToRing( &rb, vals, n, &fmt, &len );
+        if( refLen > cap - used )
+        {
+            HOST_CHECK( (res == RES_ERR_OVERFLOW) && (RingBuff_Used( &rb ) == used) );
+            continue;
+        }
+        HOST_CHECK( (res == RES_SUCCESS) && (len == refLen) );
+        HOST_CHECK( RingBuff_Used( &rb ) == used + refLen );
+        RingBuff_RdMany( &rb, NULL, used );
+        HOST_CHECK( RingBuff_RdMany( &rb, out, refLen ) == refLen );
+        HOST_CHECK( memcmp( out, ref, refLen ) == 0 );
+    }
+
+    RingBuff_Init( &rb, buff16, sizeof(buff16), 2 );
+    HOST_CHECK( Conv_IntArrToRing( &rb, (const int32_t *)vals, 1, NULL, NULL ) == RES_ERR_SZ );
+}
+
+static void _cvtest_bench( void )
+{
+    char_t line[CVTEST_LINE_SZ];
+    char_t tmp[16];
+    int32_t vals[20];
+    volatile uint32_t sink = 0;
+    uint32_t len;
+    uint32_t ii;
+    uint32_t jj;
+    char_t *p;
+    double t0;
+
+    for(ii=0; ii < 20; ii++)
+    {
+        vals[ii] = (int32_t)Host_RandN( 2000001 ) - 1000000;
+    }
+
+    t0 = Host_Now();
+    for(jj=0; jj < CVTEST_BENCH_N; jj++)
+    {
+        line[0] = 0;
+        for(ii=0; ii < 20; ii++)
+        {
+            Conv_IntToStr( vals[ii], tmp, sizeof(tmp) - 1 );
+            if( ii > 0 )
+            {
+                strcat( line, "," );
+            }
+            strcat( line, tmp );
+        }
+        sink += (uint8_t)line[3];
+        vals[jj % 20] ^= 1;
+    }
+    printf( "Conv_IntToStr + strcat: %7.1f ns/line\n", (Host_Now() - t0) * 1e9 / CVTEST_BENCH_N );
+
+    t0 = Host_Now();
+    for(jj=0; jj < CVTEST_BENCH_N; jj++)
+    {
+        Conv_IntArrToStr( vals, 20, NULL, line, sizeof(line) - 1, &len );
+        sink += (uint8_t)line[3];
+        vals[jj % 20] ^= 1;
+    }
+    printf( "Conv_IntArrToStr:       %7.1f ns/line\n", (Host_Now() - t0) * 1e9 / CVTEST_BENCH_N );
+
+    t0 = Host_Now();
+    for(jj=0; jj < CVTEST_BENCH_N; jj++)
+    {
+        p = line;
+        for(ii=0; ii < 20; ii++)
+        {
+            p += sprintf( p, (ii > 0) ? ",%d" : "%d", vals[ii] );
+        }
+        sink += (uint8_t)line[3];
+        vals[jj % 20] ^= 1;
+    }
+    printf( "sprintf:                %7.1f ns/line\n", (Host_Now() - t0) * 1e9 / CVTEST_BENCH_N );
+
+    (void)sink;
+}
+
+int main(int argc, char **argv)
+{
+    Host_Seed( 1 );
+
+    _cvtest_str();
+    _cvtest_ring();
+
+    if( (argc > 1) && (strcmp( argv[1], "-b" ) == 0) )
+    {
+        _cvtest_bench();
+    }
+
+    return Host_Result( "conv_test" );
+}
@@ -0,0 +1,201 @@
+/**************************************************************************//**
+ * @file     crc_test.c
+ * @brief    Host self-test and throughput of the CRC16 and CRC32.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * Checks, against bit-by-bit references written from the polynomials:
+ * - the standard check values of "123456789"
+ * - random blocks, split at a random point into incremental updates
+ * - ring buffer regions in place, across the wrap point
+ *
+ * Build and run (from this directory), for each #CRC_IMPL:
+ *
+ *     cc -std=gnu99 -O2 -D__ARCH_AMD64__ -DCRC_IMPL=1 -I../../includes -I.. -o crc_test \
+ *         crc_test.c ../../sources/common/crc.c ../../sources/common/ring_buffer.c
+ *     ./crc_test [-b]
+ *
+ * With -b it also prints the throughput on 1 MiB blocks.
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include "common/crc.h"
+#include "host_util.h"
+
+#define CRCTEST_BLOCK_SZ    ( 300 )
+#define CRCTEST_RING_SZ     ( 97 )
+#define CRCTEST_BENCH_SZ    ( 1U << 20 )
+#define CRCTEST_BENCH_REPS  ( 64 )
+
+static uint16_t _crctest_ref16( const uint8_t *pData, uint32_t pLen )
+{
+    uint16_t crc = 0xFFFF;
+    uint32_t ii;
+
+    while( pLen-- > 0 )
+    {
+        crc ^= (uint16_t)(*pData++ << 8);
+        for(ii=0; ii < 8; ii++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+static uint32_t _crctest_ref32( const uint8_t *pData, uint32_t pLen )
+{
+    uint32_t crc = 0xFFFFFFFF;
+    uint32_t ii;
+
+    while( pLen-- > 0 )
+    {
+        crc ^= *pData++;
+        for(ii=0; ii < 8; ii++)
+        {
+            crc = (crc & 1) ? ((crc >> 1) ^ 0xEDB88320) : (crc >> 1);
+        }
+    }
+
+    return ~crc;
+}
+
+/*
+ * Blocks at random alignments, split in two updates
+ */
+static void _crctest_blocks( void )
+{
+    uint8_t data[CRCTEST_BLOCK_SZ + 8];
+    const uint8_t *blk;
+    uint32_t iter;
+    uint32_t ii;
+    uint32_t n;
+    uint32_t s;
+
+    HOST_CHECK( Crc16( "123456789", 9 ) == 0x29B1 );
+    HOST_CHECK( Crc32( "123456789", 9 ) == 0xCBF43926 );
+    HOST_CHECK( Crc16( NULL, 0 ) == _crctest_ref16( NULL, 0 ) );
+    HOST_CHECK( Crc32( NULL, 0 ) == _crctest_ref32( NULL, 0 ) );
+
+    for(iter=0; iter < 20000; iter++)
+    {
+        for(ii=0; ii < sizeof(data); ii++)
+        {
+            data[ii] = (uint8_t)Host_Rand();
+        }
+        //o slice-by-8 trata o inicio e o fim desalinhados a parte
+        blk = &data[Host_RandN( 8 )];
+        n = Host_RandN( CRCTEST_BLOCK_SZ + 1 );
+        s = Host_RandN( n + 1 );
+
+        HOST_CHECK( Crc16( blk, n ) == _crctest_ref16( blk, n ) );
+        HOST_CHECK( Crc32( blk, n ) == _crctest_ref32( blk, n ) );
+        HOST_CHECK( Crc16_End( Crc16_Update( Crc16_Update( Crc16_Start(), blk, s ), &blk[s], n - s ) ) ==
+                    _crctest_ref16( blk, n ) );
+        HOST_CHECK( Crc32_End( Crc32_Update( Crc32_Update( Crc32_Start(), blk, s ), &blk[s], n - s ) ) ==
+                    _crctest_ref32( blk, n ) );
+    }
+}
+
+/*
+ * Regions of a ring buffer whose content starts at a random position
+ */
+static void _crctest_ring( void )
+{
+    uint8_t buff[CRCTEST_RING_SZ];
+    uint8_t data[CRCTEST_RING_SZ];
+    ringbuff_t rb;
+    uint32_t iter;
+    uint32_t ii;
+    uint32_t n;
+    uint32_t idx;
+    uint32_t len;
+    uint32_t cap;
+    uint8_t el;
+
+    for(iter=0; iter < 20000; iter++)
+    {
+        cap = RingBuff_Init( &rb, buff, sizeof(buff), 1 );
+
+        //avanca o inicio para que o conteudo de a volta
+        n = Host_RandN( cap );
+        for(ii=0; ii < n; ii++)
+        {
+            RingBuff_WrOne( &rb, &el, false );
+            RingBuff_RdOne( &rb, &el );
+        }
+
+        n = Host_RandN( cap + 1 );
+        for(ii=0; ii < n; ii++)
+        {
+            data[ii] = (uint8_t)Host_Rand();
+            RingBuff_WrOne( &rb, &data[ii], false );
+        }
+
+        //regiao qualquer, inclusive alem dos elementos guardados
+        idx = Host_RandN( n + 1 );
+        len = Host_RandN( cap + 10 );
+
+        HOST_CHECK( Crc16_End( Crc16_RingBuff( Crc16_Start(), &rb, idx, len ) ) ==
+                    _crctest_ref16( &data[idx], MIN( len, n - idx ) ) );
+        HOST_CHECK( Crc32_End( Crc32_RingBuff( Crc32_Start(), &rb, idx, len ) ) ==
+                    _crctest_ref32( &data[idx], MIN( len, n - idx ) ) );
+        HOST_CHECK( RingBuff_Used( &rb ) == n );
+    }
+}
+
+static void _crctest_bench( void )
+{
+    static uint8_t big[CRCTEST_BENCH_SZ];
+    volatile uint32_t sink = 0;
+    double t0;
+    double s16;
+    double s32;
+    uint32_t ii;
+
+    for(ii=0; ii < sizeof(big); ii++)
+    {
+        big[ii] = (uint8_t)Host_Rand();
+    }
+
+    t0 = Host_Now();
+    for(ii=0; ii < CRCTEST_BENCH_REPS; ii++)
+    {
+        sink += Crc32( big, sizeof(big) );
+    }
+    s32 = Host_Now() - t0;
+
+    t0 = Host_Now();
+    for(ii=0; ii < CRCTEST_BENCH_REPS; ii++)
+    {
+        sink += Crc16( big, sizeof(big) );
+    }
+    s16 = Host_Now() - t0;
+
+    (void)sink;
+    printf( "CRC_IMPL %d: crc32 %.0f MB/s, crc16 %.0f MB/s\n", CRC_IMPL,
+            CRCTEST_BENCH_REPS * (sizeof(big) / 1e6) / s32, CRCTEST_BENCH_REPS * (sizeof(big) / 1e6) / s16 );
+}
+
+int main(int argc, char **argv)
+{
+    Host_Seed( 1 );
+
+    _crctest_blocks();
+    _crctest_ring();
+
+    if( (argc > 1) && (strcmp( argv[1], "-b" ) == 0) )
+    {
+        _crctest_bench();
+    }
+
+#if CRC_IMPL == CRC_IMPL_BITWISE
+    return Host_Result( "crc_test (bitwise)" );
+#elif CRC_IMPL == CRC_IMPL_TABLE
+    return Host_Result( "crc_test (table)" );
+#else
+    return Host_Result( "crc_test (slice8)" );
+#endif
+}
@@ -0,0 +1,216 @@
+/**************************************************************************//**
+ * @file     entropy_pool_test.c
+ * @brief    Host self-test of the entropy pool bit and range reads.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * Stores of random widths and #EntropyPool_RdBits reads of random widths are
+ * checked against a model bit queue, across the wrap of the pool, with the
+ * all-or-nothing reads. Then #EntropyPool_RdRange is checked for range,
+ * uniformity (chi-square) and bits consumed per draw, which it prints.
+ *
+ * Build and run (from this directory):
+ *
+ *     cc -std=gnu99 -O2 -D__ARCH_AMD64__ [-DENTROPYPOOL_FREE_RUNNING] -I../../includes -I.. -o entropy_pool_test \
+ *         entropy_pool_test.c ../../sources/common/entropy_pool.c
+ *     ./entropy_pool_test
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include "common/entropy_pool.h"
+#include "host_util.h"
+
+#define EPTEST_SZ           ( 1000 )    //arredondado para 512 no modo livre
+#define EPTEST_ROUNDS       ( 2000 )
+#define EPTEST_DRAWS        ( 400000 )
+#define EPTEST_BUCKETS      ( 1000 )
+
+static uint8_t _eptest_mem[EPTEST_SZ];
+
+/** Model: the bits stored, one per byte */
+static struct
+{
+    uint8_t bit[EPTEST_SZ * 8];
+    uint32_t stored;
+    uint32_t read;
+}_model;
+
+/*
+ * Stores and reads of random widths over the whole pool, from a random offset
+ */
+static void _eptest_bits( void )
+{
+    entropy_pool_t pool;
+    uint32_t sz;
+    uint32_t off;
+    uint32_t word;
+    uint32_t val;
+    uint32_t exp;
+    uint32_t avail;
+    uint32_t round;
+    uint32_t ii;
+    uint8_t k;
+
+    sz = EntropyPool_Init( &pool, _eptest_mem, sizeof(_eptest_mem) ) / 8;
+#if defined(ENTROPYPOOL_FREE_RUNNING)
+    HOST_CHECK( sz == 512 );
+#else
+    HOST_CHECK( sz == EPTEST_SZ );
+#endif
+
+    for(round=0; round < EPTEST_ROUNDS; round++)
+    {
+        //desloca os indices e zera a memoria: os bits sao misturados por XOR
+        EntropyPool_Flush( &pool );
+        off = Host_RandN( sz );
+        for(ii=0; ii < off; ii++)
+        {
+            EntropyPool_Store32( &pool, 0, 8 );
+        }
+        HOST_CHECK( EntropyPool_Discard( &pool, off ) == off );
+        memset( _eptest_mem, 0, sizeof(_eptest_mem) );
+        _model.stored = _model.read = 0;
+
+        while( _model.read + 32 < sz * 8 )
+        {
+            if( (Host_RandN( 2 ) == 0) && (_model.stored + 32 <= sz * 8) )
+            {
+                word = Host_Rand();
+                k = (uint8_t)(1 + Host_RandN( 32 ));
+                HOST_CHECK( EntropyPool_Store32( &pool, word, k ) == k );
+                for(ii=0; ii < k; ii++)
+                {
+                    _model.bit[_model.stored++] = (uint8_t)((word >> ii) & 1);
+                }
+            }
+            else
+            {
+                //só bytes completos podem ser lidos
+                avail = (_model.stored / 8) * 8 - _model.read;
+                HOST_CHECK( EntropyPool_Bits( &pool ) == avail );
+                k = (uint8_t)(1 + Host_RandN( 32 ));
+                val = 0xA5A5A5A5;
+                if( k > avail )
+                {
+                    HOST_CHECK( EntropyPool_RdBits( &pool, &val, k ) == 0 );
+                    HOST_CHECK( (val == 0xA5A5A5A5) && (EntropyPool_Bits( &pool ) == avail) );
+                    if( _model.stored + 32 > sz * 8 )
+                    {
+                        break;
+                    }
+                    continue;
+                }
+                HOST_CHECK( EntropyPool_RdBits( &pool, &val, k ) == k );
+                exp = 0;
+                for(ii=0; ii < k; ii++)
+                {
+                    exp |= (uint32_t)_model.bit[_model.read++] << ii;
+                }
+                HOST_CHECK( val == exp );
+            }
+        }
+    }
+
+    //cheio: sobrescreve o mais antigo
+    EntropyPool_Flush( &pool );
+    for(ii=0; ii < sz; ii++)
+    {
+        EntropyPool_Store32( &pool, 0xFF, 8 );
+    }
+    HOST_CHECK( EntropyPool_IsFull( &pool ) && (EntropyPool_Bits( &pool ) == sz * 8) );
+    EntropyPool_Store32( &pool, 0xFFFF, 16 );
+    HOST_CHECK( EntropyPool_IsFull( &pool ) && (EntropyPool_Bits( &pool ) == sz * 8) );
+
+    HOST_CHECK( EntropyPool_Store32( &pool, 0, 40 ) == 32 );
+    HOST_CHECK( EntropyPool_RdBits( &pool, &val, 0 ) == 0 );
+    HOST_CHECK( EntropyPool_RdBits( &pool, &val, 33 ) == 0 );
+}
+
+static void _eptest_refill( entropy_pool_t *pPool )
+{
+    while( !EntropyPool_IsFull( pPool ) )
+    {
+        EntropyPool_Store32( pPool, Host_Rand(), 32 );
+    }
+}
+
+/*
+ * Values in range, uniform, and the bits each draw takes
+ */
+static void _eptest_range( void )
+{
+    static const uint32_t ranges[] = { 2, 3, 5, 6, 7, 10, 17, 100, 256, 1000, 65537, 3000000000U };
+    static uint32_t cnt[EPTEST_BUCKETS];
+    entropy_pool_t pool;
+    uint64_t bits;
+    uint32_t b0;
+    uint32_t n;
+    uint32_t buckets;
+    uint32_t val;
+    uint32_t ii;
+    uint32_t jj;
+    double chi;
+    double e;
+    double df;
+
+    EntropyPool_Init( &pool, _eptest_mem, sizeof(_eptest_mem) );
+
+    HOST_CHECK( EntropyPool_RdRange( &pool, 5, &val ) == 0 );
+    HOST_CHECK( EntropyPool_RdRange( &pool, 0, &val ) == 0 );
+    val = 7;
+    HOST_CHECK( (EntropyPool_RdRange( &pool, 1, &val ) == 1) && (val == 0) );
+
+    for(jj=0; jj < sizeof(ranges) / sizeof(ranges[0]); jj++)
+    {
+        n = ranges[jj];
+        buckets = MIN( n, (uint32_t)EPTEST_BUCKETS );
+        memset( cnt, 0, sizeof(cnt) );
+        bits = 0;
+
+        for(ii=0; ii < EPTEST_DRAWS; ii++)
+        {
+            if( EntropyPool_Bits( &pool ) < 1024 )
+            {
+                _eptest_refill( &pool );
+            }
+            b0 = EntropyPool_Bits( &pool );
+            val = n;
+            HOST_CHECK( (EntropyPool_RdRange( &pool, n, &val ) == 1) && (val < n) );
+            bits += b0 - EntropyPool_Bits( &pool );
+            cnt[ (uint32_t)( (uint64_t)MIN( val, n - 1 ) * buckets / n ) ]++;
+        }
+
+        e = (double)EPTEST_DRAWS / buckets;
+        chi = 0;
+        for(ii=0; ii < buckets; ii++)
+        {
+            chi += (cnt[ii] - e) * (cnt[ii] - e) / e;
+        }
+        //bem longe do esperado (df), com folga para poucos graus de liberdade
+        df = buckets - 1;
+        HOST_CHECK( (chi <= df + 10) || ((chi - df - 10) * (chi - df - 10) < 72 * df) );
+
+        //potencia de 2: nunca rejeita
+        if( (n & (n - 1)) == 0 )
+        {
+            HOST_CHECK( bits == (uint64_t)EPTEST_DRAWS * (31 - ARCH_CLZ32( n )) );
+        }
+
+        printf( "n=%-10u %5.2f bits/draw  chi2/df %.2f\n", (unsigned)n, (double)bits / EPTEST_DRAWS, chi / df );
+    }
+}
+
+int main(void)
+{
+    Host_Seed( 1 );
+
+    _eptest_bits();
+    _eptest_range();
+
+#if defined(ENTROPYPOOL_FREE_RUNNING)
+    return Host_Result( "entropy_pool_test (free-running)" );
+#else
+    return Host_Result( "entropy_pool_test" );
+#endif
+}
@@ -0,0 +1,374 @@
+/**************************************************************************//**
+ * @file     framing_test.c
+ * @brief    Host self-test and throughput of the COBS and SLIP framing.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * For COBS and for SLIP:
+ * - random frames rich in delimiter and escape bytes (and empty ones) are
+ *   encoded from ring buffer segments, then decoded through small rings fed
+ *   in random chunks, and compared
+ * - malformed frames are dropped with #RES_ERR_FORMAT and oversized ones with
+ *   #RES_ERR_OVERFLOW, and the next frame is decoded
+ * - rings of elements wider than a byte are refused with #RES_ERR_SZ
+ *
+ * Build and run (from this directory):
+ *
+ *     cc -std=gnu99 -O2 -D__ARCH_AMD64__ -I../../includes -I.. -o framing_test \
+ *         framing_test.c ../../sources/common/framing.c ../../sources/common/ring_buffer.c
+ *     ./framing_test [-b]
+ *
+ * With -b it also prints the encode plus decode throughput on 64 KiB frames,
+ * and that of a byte-at-a-time SLIP decoder (RdOne/WrOne) for comparison.
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include "common/framing.h"
+#include "host_util.h"
+
+#define FMTEST_FRAMES       ( 4000 )
+#define FMTEST_FRAME_MAX    ( 600 )
+#define FMTEST_WIRE_SZ      ( 1U << 22 )
+#define FMTEST_BENCH_SZ     ( 1U << 16 )
+#define FMTEST_BENCH_REPS   ( 2000 )
+
+typedef res_t (*fmtest_enc_t)(const ringbuff_vec_t *pVec, uint32_t pVecN, ringbuff_t *pOut);
+typedef res_t (*fmtest_dec_t)(framing_dec_t *pDec, ringbuff_t *pIn, ringbuff_t *pOut, uint32_t *pLen);
+
+static uint8_t _fmtest_frames[FMTEST_FRAMES][FMTEST_FRAME_MAX];
+static uint32_t _fmtest_len[FMTEST_FRAMES];
+static uint8_t _fmtest_wire[FMTEST_WIRE_SZ];
+
+/*
+ * Random frames: mostly delimiters and escapes, some with long runs without them
+ */
+static void _fmtest_gen( void )
+{
+    static const uint8_t special[4] = { 0x00, SLIP_END, SLIP_ESC, 0xFF };
+    uint32_t ff;
+    uint32_t ii;
+    uint32_t k;
+
+    for(ff=0; ff < FMTEST_FRAMES; ff++)
+    {
+        _fmtest_len[ff] = ((ff % 50) == 0) ? 0 : Host_RandN( FMTEST_FRAME_MAX );
+        for(ii=0; ii < _fmtest_len[ff]; ii++)
+        {
+            k = Host_RandN( 8 );
+            if( (ff % 7) == 0 )
+            {
+                _fmtest_frames[ff][ii] = (uint8_t)(1 + Host_RandN( 250 ));
+            }
+            else
+            {
+                _fmtest_frames[ff][ii] = (k < 4) ? special[k] : (uint8_t)Host_Rand();
+            }
+        }
+    }
+}
+
+/*
+ * Encodes every frame from a ring at a random rotation, then decodes the wire
+ */
+static void _fmtest_roundTrip( fmtest_enc_t pEnc, fmtest_dec_t pDec, bool_t pSkipEmpty )
+{
+    static uint8_t encBuff[2048];
+    static uint8_t srcBuff[1024];
+    static uint8_t inBuff[131];
+    static uint8_t outBuff[1300];
+    uint8_t got[FMTEST_FRAME_MAX];
+    ringbuff_vec_t vec[2];
+    ringbuff_t enc;
+    ringbuff_t src;
+    ringbuff_t in;
+    ringbuff_t out;
+    framing_dec_t dec;
+    uint32_t wn = 0;
+    uint32_t wi = 0;
+    uint32_t ff;
+    uint32_t ii;
+    uint32_t rot;
+    uint32_t len;
+    uint32_t guard;
+    uint8_t el = 0;
+    res_t res;
+
+    RingBuff_Init( &enc, encBuff, sizeof(encBuff), 1 );
+    RingBuff_Init( &src, srcBuff, sizeof(srcBuff), 1 );
+
+    for(ff=0; ff < FMTEST_FRAMES; ff++)
+    {
+        RingBuff_Flush( &src );
+        rot = Host_RandN( 700 );
+        for(ii=0; ii < rot; ii++)
+        {
+            RingBuff_WrOne( &src, &el, false );
+            RingBuff_RdOne( &src, &el );
+        }
+        RingBuff_WrMany( &src, _fmtest_frames[ff], _fmtest_len[ff], false );
+        RingBuff_PeekSegs( &src, 0, _fmtest_len[ff], vec );
+
+        res = pEnc( vec, (vec[1].n > 0) ? 2 : ((vec[0].n > 0) ? 1 : 0), &enc );
+        if( res == RES_ERR_BUSY )
+        {
+            wn += RingBuff_RdMany( &enc, &_fmtest_wire[wn], FMTEST_WIRE_SZ - wn );
+            res = pEnc( vec, 2, &enc );
+        }
+        HOST_CHECK( res == RES_SUCCESS );
+
+        if( Host_RandN( 3 ) == 0 )
+        {
+            wn += RingBuff_RdMany( &enc, &_fmtest_wire[wn], FMTEST_WIRE_SZ - wn );
+        }
+    }
+    wn += RingBuff_RdMany( &enc, &_fmtest_wire[wn], FMTEST_WIRE_SZ - wn );
+
+    Framing_DecInit( &dec );
+    RingBuff_Init( &in, inBuff, sizeof(inBuff), 1 );
+    RingBuff_Init( &out, outBuff, sizeof(outBuff), 1 );
+    ff = 0;
+
+    for(guard=0; (ff < FMTEST_FRAMES) && (guard < 10000000); guard++)
+    {
+        //SLIP nao entrega quadros vazios
+        while( pSkipEmpty && (ff < FMTEST_FRAMES) && (_fmtest_len[ff] == 0) )
+        {
+            ff++;
+        }
+        if( ff == FMTEST_FRAMES )
+        {
+            break;
+        }
+
+        wi += RingBuff_WrMany( &in, &_fmtest_wire[wi], MIN( Host_RandN( 140 ), wn - wi ), false );
+        len = 0;
+        res = pDec( &dec, &in, &out, &len );
+        if( res == RES_SUCCESS )
+        {
+            HOST_CHECK( RingBuff_RdMany( &out, got, len ) == _fmtest_len[ff] );
+            HOST_CHECK( (len == _fmtest_len[ff]) && (memcmp( got, _fmtest_frames[ff], len ) == 0) );
+            ff++;
+        }
+        else
+        {
+            HOST_CHECK( res == RES_ERR_NO_MORE_RECORDS );
+        }
+    }
+    HOST_CHECK( ff == FMTEST_FRAMES );
+}
+
+/*
+ * Malformed and oversized frames are dropped, and the decoder resyncs
+ */
+static void _fmtest_errors( fmtest_enc_t pEnc, fmtest_dec_t pDec, bool_t pCobs )
+{
+    //SLIP: escape invalido e escape antes do delimitador; COBS: bloco cortado por um zero
+    static const uint8_t badSlip[] = { SLIP_END, 1, 2, SLIP_ESC, 0x05, 3, SLIP_END, 9, 9, SLIP_ESC, SLIP_END,
+                                       SLIP_END, 7, 8, SLIP_END };
+    static const uint8_t badCobs[] = { 0x05, 1, 2, 0x00, 0x03, 7, 8, 0x00 };
+    static const uint8_t goodSlip[] = { SLIP_END, 7, 8, SLIP_END };
+    static const uint8_t goodCobs[] = { 0x03, 7, 8, 0x00 };
+    static uint8_t inBuff[131];
+    static uint8_t outBuff[1300];
+    static uint8_t bigBuff[8192];
+    static uint8_t big[3000];
+    uint8_t got[FMTEST_FRAME_MAX];
+    uint8_t tmp[64];
+    ringbuff_vec_t vec;
+    ringbuff_t in;
+    ringbuff_t out;
+    ringbuff_t bigRb;
+    framing_dec_t dec;
+    uint32_t fmt = 0;
+    uint32_t ok = 0;
+    uint32_t ov = 0;
+    uint32_t len;
+    uint32_t k;
+    res_t res;
+
+    Framing_DecInit( &dec );
+    RingBuff_Init( &in, inBuff, sizeof(inBuff), 1 );
+    RingBuff_Init( &out, outBuff, sizeof(outBuff), 1 );
+
+    if( pCobs )
+    {
+        RingBuff_WrMany( &in, (void *)badCobs, sizeof(badCobs), false );
+    }
+    else
+    {
+        RingBuff_WrMany( &in, (void *)badSlip, sizeof(badSlip), false );
+    }
+    while( (res = pDec( &dec, &in, &out, &len )) != RES_ERR_NO_MORE_RECORDS )
+    {
+        if( res == RES_ERR_FORMAT )
+        {
+            fmt++;
+        }
+        else
+        {
+            HOST_CHECK( res == RES_SUCCESS );
+            RingBuff_RdMany( &out, got, len );
+            HOST_CHECK( (len == 2) && (got[0] == 7) && (got[1] == 8) );
+            ok++;
+        }
+    }
+    HOST_CHECK( fmt == (pCobs ? 1U : 2U) );
+    HOST_CHECK( ok == 1 );
+
+    //quadro maior que a saida, seguido de um bom, entregue aos poucos
+    memset( big, 0x11, sizeof(big) );
+    vec.ptr = big;
+    vec.n = sizeof(big);
+    RingBuff_Init( &bigRb, bigBuff, sizeof(bigBuff), 1 );
+    HOST_CHECK( pEnc( &vec, 1, &bigRb ) == RES_SUCCESS );
+    RingBuff_WrMany( &bigRb, (void *)(pCobs ? goodCobs : goodSlip), 4, false );
+
+    ok = 0;
+    while( (RingBuff_Used( &bigRb ) > 0) || (RingBuff_Used( &in ) > 0) )
+    {
+        k = RingBuff_RdMany( &bigRb, tmp, MIN( RingBuff_Free( &in ), (uint32_t)sizeof(tmp) ) );
+        RingBuff_WrMany( &in, tmp, k, false );
+
+        res = pDec( &dec, &in, &out, &len );
+        if( res == RES_ERR_OVERFLOW )
+        {
+            ov++;
+        }
+        else if( res == RES_SUCCESS )
+        {
+            RingBuff_RdMany( &out, got, len );
+            HOST_CHECK( (len == 2) && (got[0] == 7) );
+            ok++;
+        }
+    }
+    HOST_CHECK( ov == 1 );
+    HOST_CHECK( ok == 1 );
+
+    //elementos maiores que um byte: recusados, nada muda
+    RingBuff_Init( &bigRb, bigBuff, 64, 2 );
+    RingBuff_WrMany( &in, (void *)goodCobs, sizeof(goodCobs), false );
+    RingBuff_WrMany( &bigRb, big, 4, false );
+    vec.n = 2;
+    HOST_CHECK( pEnc( &vec, 1, &bigRb ) == RES_ERR_SZ );
+    HOST_CHECK( pDec( &dec, &bigRb, &out, &len ) == RES_ERR_SZ );
+    HOST_CHECK( pDec( &dec, &in, &bigRb, &len ) == RES_ERR_SZ );
+    HOST_CHECK( (RingBuff_Used( &bigRb ) == 4) && (RingBuff_Used( &in ) == sizeof(goodCobs)) );
+    HOST_CHECK( RingBuff_Used( &out ) == 0 );
+    RingBuff_Flush( &in );
+}
+
+static double _fmtest_bench( fmtest_enc_t pEnc, fmtest_dec_t pDec )
+{
+    static uint8_t pay[FMTEST_BENCH_SZ];
+    static uint8_t aBuff[4 * FMTEST_BENCH_SZ];
+    static uint8_t bBuff[4 * FMTEST_BENCH_SZ];
+    static uint8_t cBuff[2 * FMTEST_BENCH_SZ];
+    ringbuff_vec_t vec;
+    ringbuff_vec_t seg[2];
+    ringbuff_t a;
+    ringbuff_t b;
+    ringbuff_t c;
+    framing_dec_t dec;
+    uint32_t len;
+    uint32_t ii;
+    double t0;
+
+    for(ii=0; ii < sizeof(pay); ii++)
+    {
+        pay[ii] = (uint8_t)Host_Rand();
+    }
+    RingBuff_Init( &a, aBuff, sizeof(aBuff), 1 );
+    RingBuff_Init( &b, bBuff, sizeof(bBuff), 1 );
+    RingBuff_Init( &c, cBuff, sizeof(cBuff), 1 );
+    Framing_DecInit( &dec );
+    vec.ptr = pay;
+    vec.n = sizeof(pay);
+
+    t0 = Host_Now();
+    for(ii=0; ii < FMTEST_BENCH_REPS; ii++)
+    {
+        pEnc( &vec, 1, &a );
+        RingBuff_PeekSegs( &a, 0, RingBuff_Used( &a ), seg );
+        RingBuff_WrV( &b, seg, 2, false );
+        RingBuff_Flush( &a );
+        HOST_CHECK( pDec( &dec, &b, &c, &len ) == RES_SUCCESS );
+        RingBuff_Flush( &c );
+    }
+
+    return FMTEST_BENCH_REPS * (sizeof(pay) / 1e6) / (Host_Now() - t0);
+}
+
+/*
+ * Reference: SLIP encode, then decode a byte at a time
+ */
+static double _fmtest_benchPerByte( void )
+{
+    static uint8_t pay[FMTEST_BENCH_SZ];
+    static uint8_t aBuff[4 * FMTEST_BENCH_SZ];
+    static uint8_t cBuff[2 * FMTEST_BENCH_SZ];
+    ringbuff_vec_t vec;
+    ringbuff_t a;
+    ringbuff_t c;
+    uint32_t ii;
+    bool_t esc;
+    uint8_t el;
+    double t0;
+
+    for(ii=0; ii < sizeof(pay); ii++)
+    {
+        pay[ii] = (uint8_t)Host_Rand();
+    }
+    RingBuff_Init( &a, aBuff, sizeof(aBuff), 1 );
+    RingBuff_Init( &c, cBuff, sizeof(cBuff), 1 );
+    vec.ptr = pay;
+    vec.n = sizeof(pay);
+
+    t0 = Host_Now();
+    for(ii=0; ii < FMTEST_BENCH_REPS; ii++)
+    {
+        Slip_Encode( &vec, 1, &a );
+        esc = false;
+        while( RingBuff_RdOne( &a, &el ) > 0 )
+        {
+            if( esc )
+            {
+                el = (el == SLIP_ESC_END) ? SLIP_END : SLIP_ESC;
+                esc = false;
+                RingBuff_WrOne( &c, &el, false );
+            }
+            else if( el == SLIP_ESC )
+            {
+                esc = true;
+            }
+            else if( el != SLIP_END )
+            {
+                RingBuff_WrOne( &c, &el, false );
+            }
+        }
+        HOST_CHECK( RingBuff_Used( &c ) == sizeof(pay) );
+        RingBuff_Flush( &c );
+    }
+
+    return FMTEST_BENCH_REPS * (sizeof(pay) / 1e6) / (Host_Now() - t0);
+}
+
+int main(int argc, char **argv)
+{
+    Host_Seed( 1 );
+    _fmtest_gen();
+
+    _fmtest_roundTrip( Cobs_Encode, Cobs_Decode, false );
+    _fmtest_roundTrip( Slip_Encode, Slip_Decode, true );
+    _fmtest_errors( Cobs_Encode, Cobs_Decode, true );
+    _fmtest_errors( Slip_Encode, Slip_Decode, false );
+
+    if( (argc > 1) && (strcmp( argv[1], "-b" ) == 0) )
+    {
+        printf( "cobs encode+decode %.0f MB/s\n", _fmtest_bench( Cobs_Encode, Cobs_Decode ) );
+        printf( "slip encode+decode %.0f MB/s\n", _fmtest_bench( Slip_Encode, Slip_Decode ) );
+        printf( "slip encode+decode byte at a time %.0f MB/s\n", _fmtest_benchPerByte() );
+    }
+
+    return Host_Result( "framing_test" );
+}
@@ -0,0 +1,162 @@
+/**************************************************************************//**
+ * @file     ring_buffer_pers_test.c
+ * @brief    Host self-test of the persistent ring buffer.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * The region is a shared mapping. A child process writes, reads and discards
+ * at random on it and is killed (SIGKILL) at a random point, as a reset would
+ * do. After each kill, the ring is attached again and must hold consecutive
+ * elements, each of them intact. Also checks formatting of a garbage region,
+ * attaching with another geometry and a plain reattach.
+ *
+ * Build and run (from this directory), Linux only:
+ *
+ *     cc -std=gnu99 -D__ARCH_AMD64__ -I../../includes -I.. -o ring_buffer_pers_test \
+ *         ring_buffer_pers_test.c ../../sources/common/ring_buffer_pers.c ../../sources/common/crc.c \
+ *         ../../sources/common/ring_buffer.c
+ *     ./ring_buffer_pers_test
+ *
+ ******************************************************************************/
+
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "common/ring_buffer_pers.h"
+#include "host_util.h"
+
+#define RPTEST_ELS          ( 100 )     //arredondado para 64
+#define RPTEST_KILLS        ( 3000 )
+
+/** Element with redundant fields: a torn write breaks them */
+typedef struct
+{
+    uint32_t cnt;
+    uint32_t inv;
+    uint32_t hash;
+    uint32_t plus;
+}rptest_el_t;
+
+static void _rptest_make( rptest_el_t *pEl, uint32_t pCnt )
+{
+    pEl->cnt = pCnt;
+    pEl->inv = ~pCnt;
+    pEl->hash = pCnt * 2654435761U;
+    pEl->plus = pCnt + 7;
+}
+
+/*
+ * Checks that the elements are intact and consecutive. Gets the last one.
+ */
+static bool_t _rptest_valid( ringbuff_pers_t *pRb, uint32_t *pLast )
+{
+    rptest_el_t *el;
+    uint32_t n = RingBuffPers_Used( pRb );
+    uint32_t ii;
+
+    for(ii=0; ii < n; ii++)
+    {
+        el = RingBuffPers_PeekAt( pRb, ii );
+        if( (el == NULL) || (el->inv != ~el->cnt) || (el->hash != el->cnt * 2654435761U) || (el->plus != el->cnt + 7) )
+        {
+            return false;
+        }
+        if( (ii > 0) && (el->cnt != *pLast + 1) )
+        {
+            return false;
+        }
+        *pLast = el->cnt;
+    }
+
+    return true;
+}
+
+/*
+ * The child: random operations until killed
+ */
+static void _rptest_child( ringbuff_pers_t *pRb, uint32_t pNext )
+{
+    rptest_el_t el;
+
+    Host_Seed( (uint64_t)getpid() );
+    for(;;)
+    {
+        _rptest_make( &el, pNext++ );
+        RingBuffPers_WrOne( pRb, &el, true );
+        if( Host_RandN( 3 ) == 0 )
+        {
+            RingBuffPers_RdOne( pRb, NULL );
+        }
+        if( Host_RandN( 50 ) == 0 )
+        {
+            RingBuffPers_Discard( pRb, Host_RandN( 5 ) );
+        }
+    }
+}
+
+int main(void)
+{
+    const uint32_t sz = sizeof(ringbuff_pers_hdr_t) + RPTEST_ELS * sizeof(rptest_el_t);
+    ringbuff_pers_t rb;
+    ringbuff_pers_t rb2;
+    rptest_el_t el;
+    uint8_t *region;
+    uint32_t next = 1;
+    uint32_t last = 0;
+    uint32_t full = 0;
+    uint32_t ii;
+    pid_t pid;
+
+    region = mmap( NULL, sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0 );
+    if( region == MAP_FAILED )
+    {
+        perror( "mmap" );
+        return 1;
+    }
+    Host_Seed( 1 );
+
+    //lixo: formata um anel vazio
+    memset( region, 0xA5, sz );
+    HOST_CHECK( RingBuffPers_Attach( &rb, region, sz, sizeof(rptest_el_t) ) == RES_ERR_FORMAT );
+    HOST_CHECK( RingBuffPers_Sz( &rb ) == 64 );
+    HOST_CHECK( RingBuffPers_Used( &rb ) == 0 );
+
+    for(ii=1; ii <= 10; ii++)
+    {
+        _rptest_make( &el, ii );
+        RingBuffPers_WrOne( &rb, &el, true );
+    }
+    HOST_CHECK( RingBuffPers_Attach( &rb2, region, sz, sizeof(rptest_el_t) ) == RES_SUCCESS );
+    HOST_CHECK( RingBuffPers_Used( &rb2 ) == 10 );
+    HOST_CHECK( _rptest_valid( &rb2, &last ) && (last == 10) );
+
+    //outra geometria: formata
+    HOST_CHECK( RingBuffPers_Attach( &rb2, region, sz, 8 ) == RES_ERR_FORMAT );
+    HOST_CHECK( RingBuffPers_Attach( &rb, region, sz, sizeof(rptest_el_t) ) == RES_ERR_FORMAT );
+
+    for(ii=0; ii < RPTEST_KILLS; ii++)
+    {
+        HOST_CHECK( RingBuffPers_Attach( &rb, region, sz, sizeof(rptest_el_t) ) == RES_SUCCESS );
+        HOST_CHECK( _rptest_valid( &rb, &last ) );
+        if( RingBuffPers_Used( &rb ) > 0 )
+        {
+            next = last + 1;
+        }
+        full += ( RingBuffPers_Used( &rb ) == RingBuffPers_Sz( &rb ) );
+
+        pid = fork();
+        if( pid == 0 )
+        {
+            _rptest_child( &rb, next );
+        }
+        usleep( Host_RandN( 300 ) );
+        kill( pid, SIGKILL );
+        waitpid( pid, NULL, 0 );
+    }
+
+    printf( "%u kills, ring found full %u times\n", (unsigned)RPTEST_KILLS, (unsigned)full );
+
+    return Host_Result( "ring_buffer_pers_test" );
+}
@@ -0,0 +1,356 @@
+/**************************************************************************//**
+ * @file     ring_buffer_test.c
+ * @brief    Host self-test of the ring buffer.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * Random operations are checked against a reference model (a plain array
+ * shifted on every read), for random element and buffer sizes. Then a
+ * producer thread and a consumer thread stream a sequence through the Locked
+ * variants, in batches of varying size. In free-running mode, a SIGALRM
+ * handler plays an ISR writing in overwrite mode while #RingBuff_RdLatestSnap
+ * takes snapshots, which must never be torn.
+ *
+ * Build and run (from this directory):
+ *
+ *     cc -std=gnu99 -D__ARCH_AMD64__ -I../../includes -I.. -o ring_buffer_test \
+ *         ring_buffer_test.c ../../sources/common/ring_buffer.c -lpthread
+ *     ./ring_buffer_test
+ *
+ * Add -DRINGBUFF_FREE_RUNNING or -DRINGBUFF_INLINE_API -DNDEBUG for the other
+ * index scheme and the unchecked inline API. run_all.sh builds every variant.
+ * For the Locked variants, -fsanitize=thread also reports data races.
+ *
+ ******************************************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/time.h>
+#include "common/ring_buffer.h"
+#include "host_util.h"
+
+#define RBTEST_BUFF_SZ      ( 256 )
+#define RBTEST_DATA_SZ      ( 600 )
+#define RBTEST_LOCKED_N     ( 3000000 )
+#define RBTEST_SNAP_ELS     ( 256 )
+#define RBTEST_SNAP_N       ( 100000 )
+
+/** Reference model: the elements, oldest first */
+static struct
+{
+    uint8_t data[RBTEST_BUFF_SZ];
+    uint32_t n;
+    uint32_t cap;
+    uint32_t eSz;
+}_model;
+
+static void _model_wr( const uint8_t *pEl, uint32_t pN, bool_t pOw )
+{
+    uint32_t ii;
+
+    for(ii=0; ii < pN; ii++)
+    {
+        if( _model.n == _model.cap )
+        {
+            if( !pOw )
+            {
+                return;
+            }
+            memmove( _model.data, &_model.data[_model.eSz], (_model.n - 1) * _model.eSz );
+            _model.n--;
+        }
+        memcpy( &_model.data[_model.n * _model.eSz], &pEl[ii * _model.eSz], _model.eSz );
+        _model.n++;
+    }
+}
+
+/*
+ * Checks pN elements read against the model and removes them from it
+ */
+static void _model_rd( const uint8_t *pEl, uint32_t pN )
+{
+    HOST_CHECK( memcmp( pEl, _model.data, pN * _model.eSz ) == 0 );
+    memmove( _model.data, &_model.data[pN * _model.eSz], (_model.n - pN) * _model.eSz );
+    _model.n -= pN;
+}
+
+/*
+ * WrMany/WrV/RdV/RdMany: all-or-nothing batches, overwrite and the wrap
+ */
+static void _rbtest_batches( void )
+{
+    static uint8_t buff[RBTEST_BUFF_SZ];
+    uint8_t in[RBTEST_DATA_SZ];
+    uint8_t out[RBTEST_DATA_SZ];
+    ringbuff_vec_t vec[3];
+    ringbuff_t rb;
+    uint32_t iter;
+    uint32_t ii;
+    uint32_t n;
+    uint32_t a;
+    uint32_t b;
+    uint32_t res;
+    uint32_t exp;
+    bool_t ow;
+
+    for(iter=0; iter < 200000; iter++)
+    {
+        if( (iter % 1000) == 0 )
+        {
+            _model.eSz = 1 + Host_RandN( 5 );
+            _model.cap = RingBuff_Init( &rb, buff, _model.eSz + Host_RandN( 60 ), (uint8_t)_model.eSz );
+            _model.n = 0;
+        }
+
+        for(ii=0; ii < sizeof(in); ii++)
+        {
+            in[ii] = (uint8_t)Host_Rand();
+        }
+        n = Host_RandN( _model.cap + 3 );
+        ow = (bool_t)Host_RandN( 2 );
+
+        switch( Host_RandN( 5 ) )
+        {
+        case 0:
+            res = RingBuff_WrMany( &rb, in, n, ow );
+            exp = ow ? n : MIN( n, _model.cap - _model.n );
+            HOST_CHECK( res == exp );
+            _model_wr( in, exp, ow );
+            break;
+
+        case 1:
+            //lote em 3 vetores: entra inteiro ou nada
+            a = Host_RandN( n + 1 );
+            b = Host_RandN( n - a + 1 );
+            vec[0].ptr = in;
+            vec[0].n = a;
+            vec[1].ptr = &in[a * _model.eSz];
+            vec[1].n = b;
+            vec[2].ptr = &in[(a + b) * _model.eSz];
+            vec[2].n = n - a - b;
+            res = RingBuff_WrV( &rb, vec, 3, ow );
+            exp = ( (n > 0) && ((n <= _model.cap - _model.n) || (ow && (n <= _model.cap))) ) ? n : 0;
+            HOST_CHECK( res == exp );
+            _model_wr( in, exp, true );
+            break;
+
+        case 2:
+            a = Host_RandN( n + 1 );
+            vec[0].ptr = out;
+            vec[0].n = a;
+            vec[1].ptr = &out[a * _model.eSz];
+            vec[1].n = n - a;
+            res = RingBuff_RdV( &rb, vec, 2 );
+            exp = ( (n > 0) && (n <= _model.n) ) ? n : 0;
+            HOST_CHECK( res == exp );
+            _model_rd( out, exp );
+            break;
+
+        case 3:
+            //os mais novos, sem consumir
+            res = RingBuff_RdLatest( &rb, out, n );
+            exp = MIN( n, _model.n );
+            HOST_CHECK( res == exp );
+            HOST_CHECK( memcmp( out, &_model.data[(_model.n - exp) * _model.eSz], exp * _model.eSz ) == 0 );
+            break;
+
+        default:
+            res = RingBuff_RdMany( &rb, out, n );
+            exp = MIN( n, _model.n );
+            HOST_CHECK( res == exp );
+            _model_rd( out, exp );
+            break;
+        }
+
+        HOST_CHECK( RingBuff_Used( &rb ) == _model.n );
+    }
+}
+
+static ringbuff_t _rbtest_lrb;
+static arch_lock_t _rbtest_lock = ARCH_LOCK_INIT;
+
+static void *_rbtest_producer( void *pArg )
+{
+    uint32_t buff[7];
+    uint32_t val = 0;
+    uint32_t n;
+    uint32_t ii;
+
+    (void)pArg;
+    while( val < RBTEST_LOCKED_N )
+    {
+        n = MIN( 1 + val % 7, RBTEST_LOCKED_N - val );
+        for(ii=0; ii < n; ii++)
+        {
+            buff[ii] = val + ii;
+        }
+        n = ( n == 1 ) ? RingBuff_WrOneLocked( &_rbtest_lrb, &_rbtest_lock, buff )
+                       : RingBuff_WrManyLocked( &_rbtest_lrb, &_rbtest_lock, buff, n );
+        val += n;
+        if( n == 0 )
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Locked variants: one producer thread, one consumer thread, no overwrite
+ */
+static void _rbtest_locked( void )
+{
+    static uint32_t buff[64];
+    uint32_t rd[5];
+    uint32_t exp = 0;
+    uint32_t bad = 0;
+    uint32_t n;
+    uint32_t ii;
+    arch_crit_t a;
+    arch_crit_t b;
+    pthread_t thr;
+
+    //o lock e recursivo
+    a = Arch_CritEnter( &_rbtest_lock );
+    b = Arch_CritEnter( &_rbtest_lock );
+    HOST_CHECK( _rbtest_lock.depth == 2 );
+    Arch_CritExit( &_rbtest_lock, b );
+    Arch_CritExit( &_rbtest_lock, a );
+    HOST_CHECK( _rbtest_lock.owner == 0 );
+
+    RingBuff_Init( &_rbtest_lrb, buff, sizeof(buff), sizeof(uint32_t) );
+    if( pthread_create( &thr, NULL, _rbtest_producer, NULL ) != 0 )
+    {
+        HOST_CHECK( false );
+        return;
+    }
+
+    while( exp < RBTEST_LOCKED_N )
+    {
+        n = ( (exp % 5) == 0 ) ? RingBuff_RdOneLocked( &_rbtest_lrb, &_rbtest_lock, rd )
+                               : RingBuff_RdManyLocked( &_rbtest_lrb, &_rbtest_lock, rd, 1 + exp % 5 );
+        for(ii=0; ii < n; ii++)
+        {
+            bad += ( rd[ii] != exp++ );
+        }
+        if( n == 0 )
+        {
+            sched_yield();
+        }
+    }
+    pthread_join( thr, NULL );
+
+    HOST_CHECK( bad == 0 );
+    HOST_CHECK( RingBuff_UsedLocked( &_rbtest_lrb, &_rbtest_lock ) == 0 );
+    HOST_CHECK( RingBuff_RdOneLocked( &_rbtest_lrb, &_rbtest_lock, NULL ) == 0 );
+}
+
+#if defined(RINGBUFF_FREE_RUNNING)
+/** Element of the snapshot test: all words carry the sequence number */
+typedef struct
+{
+    uint32_t v[15];
+}rbtest_snap_el_t;
+
+static ringbuff_t _rbtest_srb;
+static uint32_t _rbtest_seq = 1;
+
+static void _rbtest_isr( int pSig )
+{
+    rbtest_snap_el_t el;
+    uint32_t ii;
+
+    (void)pSig;
+    for(ii=0; ii < 15; ii++)
+    {
+        el.v[ii] = _rbtest_seq;
+    }
+    _rbtest_seq++;
+    RingBuff_WrOne( &_rbtest_srb, &el, true );
+}
+
+/*
+ * Torn snapshot: elements not consecutive or not whole
+ */
+static bool_t _rbtest_torn( const rbtest_snap_el_t *pEl, uint32_t pN )
+{
+    uint32_t ii;
+    uint32_t k;
+
+    for(ii=0; ii < pN; ii++)
+    {
+        for(k=0; k < 15; k++)
+        {
+            if( pEl[ii].v[k] != pEl[0].v[0] + ii )
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/*
+ * RdLatestSnap against an "ISR" on the same core, writing every 20 us
+ */
+static void _rbtest_latestSnap( void )
+{
+    static rbtest_snap_el_t buff[RBTEST_SNAP_ELS];
+    static rbtest_snap_el_t out[RBTEST_SNAP_ELS];
+    struct itimerval it = { { 0, 20 }, { 0, 20 } };
+    struct itimerval off = { { 0, 0 }, { 0, 0 } };
+    uint32_t snaps = 0;
+    uint32_t torn = 0;
+    uint32_t plainTorn = 0;
+    uint32_t n;
+    uint32_t ii;
+
+    HOST_CHECK( RingBuff_Init( &_rbtest_srb, buff, sizeof(buff), sizeof(rbtest_snap_el_t) ) == RBTEST_SNAP_ELS );
+    for(ii=0; ii < RBTEST_SNAP_ELS; ii++)
+    {
+        _rbtest_isr( 0 );
+    }
+    signal( SIGALRM, _rbtest_isr );
+    setitimer( ITIMER_REAL, &it, NULL );
+
+    for(ii=0; ii < RBTEST_SNAP_N; ii++)
+    {
+        n = RingBuff_RdLatestSnap( &_rbtest_srb, out, RBTEST_SNAP_ELS, 8 );
+        if( n > 0 )
+        {
+            //o ISR pode entrar entre as leituras do tail e do head
+            HOST_CHECK( n + 1 >= RBTEST_SNAP_ELS );
+            snaps++;
+            torn += _rbtest_torn( out, n );
+        }
+        //sem a verificacao: para comparar
+        n = RingBuff_RdLatest( &_rbtest_srb, out, RBTEST_SNAP_ELS );
+        plainTorn += _rbtest_torn( out, n );
+    }
+
+    setitimer( ITIMER_REAL, &off, NULL );
+    signal( SIGALRM, SIG_DFL );
+
+    HOST_CHECK( torn == 0 );
+    HOST_CHECK( snaps > RBTEST_SNAP_N / 2 );
+    printf( "RdLatestSnap: %u of %u snapshots consistent, %u torn; RdLatest: %u torn\n",
+            (unsigned)snaps, (unsigned)RBTEST_SNAP_N, (unsigned)torn, (unsigned)plainTorn );
+}
+#endif
+
+int main(void)
+{
+    Host_Seed( 1 );
+
+    _rbtest_batches();
+    _rbtest_locked();
+#if defined(RINGBUFF_FREE_RUNNING)
+    _rbtest_latestSnap();
+#endif
+
+    return Host_Result( "ring_buffer_test" );
+}
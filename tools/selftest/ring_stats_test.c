@@ -0,0 +1,169 @@
+/**************************************************************************//**
+ * @file     ring_stats_test.c
+ * @brief    Host self-test of the sliding-window statistics.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * Random writes (with and without overwrite) and reads are checked against a
+ * reference window, and after each of them every statistic is compared with
+ * the one computed by brute force over that window.
+ *
+ * Build and run (from this directory):
+ *
+ *     cc -std=gnu99 -D__ARCH_AMD64__ -I../../includes -I.. -o ring_stats_test \
+ *         ring_stats_test.c ../../sources/common/ring_stats.c ../../sources/common/ring_buffer.c
+ *     ./ring_stats_test
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include "common/ring_stats.h"
+#include "host_util.h"
+
+#define RSTEST_BUFF_SZ      ( 3000 )
+#define RSTEST_VAL_BITS     ( 27 )      //janela de ate 250 amostras: soma dos quadrados cabe em 64 bits
+
+/** Reference window, oldest first */
+static struct
+{
+    int32_t val[RSTEST_BUFF_SZ / RINGSTATS_SAMPLE_SZ];
+    uint32_t n;
+    uint32_t cap;
+}_model;
+
+static uint32_t _rstest_isqrt( uint64_t pVal )
+{
+    uint64_t lo = 0;
+    uint64_t hi = 0xFFFFFFFFULL;
+    uint64_t mid;
+
+    while( lo < hi )
+    {
+        mid = (lo + hi + 1) / 2;
+        if( mid * mid <= pVal )
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid - 1;
+        }
+    }
+
+    return (uint32_t)lo;
+}
+
+/*
+ * Compares every statistic with the brute-force one
+ */
+static void _rstest_check( ring_stats_t *pSt )
+{
+    int64_t sum = 0;
+    uint64_t sumSq = 0;
+    int32_t mn;
+    int32_t mx;
+    int32_t val;
+    uint32_t rms;
+    uint32_t ii;
+
+    HOST_CHECK( RingStats_Used( pSt ) == _model.n );
+
+    if( _model.n == 0 )
+    {
+        HOST_CHECK( RingStats_Min( pSt, &val ) == 0 );
+        HOST_CHECK( RingStats_Max( pSt, &val ) == 0 );
+        HOST_CHECK( RingStats_Mean( pSt, &val ) == 0 );
+        HOST_CHECK( RingStats_Rms( pSt, &rms ) == 0 );
+        return;
+    }
+
+    mn = mx = _model.val[0];
+    for(ii=0; ii < _model.n; ii++)
+    {
+        sum += _model.val[ii];
+        sumSq += (uint64_t)((int64_t)_model.val[ii] * _model.val[ii]);
+        mn = MIN( mn, _model.val[ii] );
+        mx = MAX( mx, _model.val[ii] );
+    }
+
+    HOST_CHECK( (RingStats_Min( pSt, &val ) == _model.n) && (val == mn) );
+    HOST_CHECK( (RingStats_Max( pSt, &val ) == _model.n) && (val == mx) );
+    HOST_CHECK( (RingStats_Mean( pSt, &val ) == _model.n) && (val == (int32_t)(sum / (int64_t)_model.n)) );
+    HOST_CHECK( (RingStats_Rms( pSt, &rms ) == _model.n) && (rms == _rstest_isqrt( sumSq / _model.n )) );
+}
+
+static void _rstest_window( void )
+{
+    static uint32_t buff[RSTEST_BUFF_SZ / sizeof(uint32_t)];
+    ring_stats_t st;
+    uint32_t iter;
+    uint32_t res;
+    int32_t val;
+    uint32_t bits;
+    bool_t ow;
+
+    for(iter=0; iter < 400000; iter++)
+    {
+        if( (iter % 10000) == 0 )
+        {
+            //janelas pequenas sao as que mais despejam
+            _model.cap = RingStats_Init( &st, buff, Host_RandN( (iter % 20000) ? RSTEST_BUFF_SZ : 200 ) );
+            _model.n = 0;
+            if( _model.cap == 0 )
+            {
+                continue;
+            }
+        }
+        if( _model.cap == 0 )
+        {
+            continue;
+        }
+
+        //valores pequenos repetem, o que exercita empates nos deques
+        bits = Host_RandN( 2 ) ? 4 : RSTEST_VAL_BITS;
+        val = (int32_t)Host_RandN( 2U << bits ) - (int32_t)(1U << bits);
+        ow = (bool_t)Host_RandN( 2 );
+
+        if( Host_RandN( 3 ) < 2 )
+        {
+            res = RingStats_Wr( &st, val, ow );
+            if( _model.n < _model.cap )
+            {
+                HOST_CHECK( res == 1 );
+                _model.val[_model.n++] = val;
+            }
+            else if( ow )
+            {
+                HOST_CHECK( res == 1 );
+                memmove( _model.val, &_model.val[1], (_model.n - 1) * sizeof(int32_t) );
+                _model.val[_model.n - 1] = val;
+            }
+            else
+            {
+                HOST_CHECK( res == 0 );
+            }
+        }
+        else
+        {
+            res = RingStats_Rd( &st, &val );
+            HOST_CHECK( res == ((_model.n > 0) ? 1U : 0U) );
+            if( _model.n > 0 )
+            {
+                HOST_CHECK( val == _model.val[0] );
+                memmove( _model.val, &_model.val[1], (_model.n - 1) * sizeof(int32_t) );
+                _model.n--;
+            }
+        }
+
+        _rstest_check( &st );
+    }
+}
+
+int main(void)
+{
+    Host_Seed( 1 );
+
+    _rstest_window();
+
+    return Host_Result( "ring_stats_test" );
+}
@@ -0,0 +1,65 @@
+#!/bin/sh
+#
+# Builds and runs every host self-test in each ring buffer configuration,
+# under ASan/UBSan. Run from this directory. CC and CFLAGS may be overridden.
+#
+# Each line of TESTS is "<test>[:<tag>] <library sources, relative to sources/common>",
+# optionally followed by -D flags: a test built with other flags gets a tag.
+#
+
+CC=${CC:-cc}
+CFLAGS=${CFLAGS:--std=gnu99 -O1 -g -Wall -fsanitize=address,undefined -fno-sanitize-recover=all}
+SRC=../../sources/common
+OUT=${OUT:-./build}
+
+TESTS="
+ring_buffer_test ring_buffer.c
+ring_stats_test ring_stats.c ring_buffer.c
+crc_test:bitwise crc.c ring_buffer.c -DCRC_IMPL=0
+crc_test:table crc.c ring_buffer.c -DCRC_IMPL=1
+crc_test:slice8 crc.c ring_buffer.c -DCRC_IMPL=2
+framing_test framing.c ring_buffer.c
+conv_test conv.c ring_buffer.c
+entropy_pool_test entropy_pool.c
+entropy_pool_test:free_running entropy_pool.c -DENTROPYPOOL_FREE_RUNNING
+ring_buffer_pers_test ring_buffer_pers.c crc.c ring_buffer.c
+shm_chan_test:yield shm_chan.c
+shm_chan_test:futex shm_chan.c -DSHMCHAN_FUTEX
+trace_test:cb trace.c ring_buffer.c -DRINGBUFF_TRACE_ENABLE
+trace_test:tsc trace.c ring_buffer.c -DRINGBUFF_TRACE_ENABLE -DTRACE_TIMESTAMP()=((uint32_t)__builtin_ia32_rdtsc())
+"
+
+VARIANTS="
+default:
+free_running:-DRINGBUFF_FREE_RUNNING
+inline_unchecked:-DRINGBUFF_INLINE_API -DNDEBUG
+"
+
+mkdir -p "$OUT" || exit 1
+fails=0
+
+echo "$TESTS" | while read -r label srcs; do
+    [ -n "$label" ] || continue
+    test=${label%%:*}
+    paths=""
+    flags=""
+    for s in $srcs; do
+        case "$s" in
+            -*) flags="$flags $s" ;;
+            *) paths="$paths $SRC/$s" ;;
+        esac
+    done
+
+    echo "$VARIANTS" | while IFS=: read -r name defs; do
+        [ -n "$name" ] || continue
+        bin="$OUT/$(echo "$label" | tr : _)_$name"
+        if ! $CC $CFLAGS -D__ARCH_AMD64__ $defs $flags -I../../includes -I.. -o "$bin" "$test.c" $paths -lpthread; then
+            echo "$label ($name): build FAILED"
+            exit 1
+        fi
+        printf "[%s] " "$name"
+        "$bin" || exit 1
+    done || exit 1
+done || fails=1
+
+exit $fails
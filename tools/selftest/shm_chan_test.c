@@ -0,0 +1,163 @@
+/**************************************************************************//**
+ * @file     shm_chan_test.c
+ * @brief    Host self-test of the shared memory channel.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * The parent process creates the channel and streams sequence numbers in
+ * random batches, pausing now and then so the consumer has to wait. A forked
+ * consumer opens it by name, checks the order with #ShmChan_RdWait and that
+ * no wait outlasts the producer's pauses (a lost wake-up), prints its
+ * throughput and checks that a read on the drained channel times out.
+ * Also checks that a second creation of the same name fails.
+ *
+ * Build and run (from this directory), Linux only:
+ *
+ *     cc -std=gnu99 -O2 -D__ARCH_AMD64__ [-DSHMCHAN_FUTEX] -I../../includes -I.. -o shm_chan_test \
+ *         shm_chan_test.c ../../sources/common/shm_chan.c
+ *     ./shm_chan_test [elements]
+ *
+ ******************************************************************************/
+
+#include <sched.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "common/shm_chan.h"
+#include "host_util.h"
+
+#define SCTEST_N            ( 1000 )    //arredondado para 512
+#define SCTEST_BATCH        ( 64 )
+
+/*
+ * The consumer. The exit code tells what failed.
+ */
+static int _sctest_consumer( const char_t *pName, uint64_t pTotal )
+{
+    uint64_t buff[SCTEST_BATCH];
+    shm_chan_t ch;
+    uint64_t exp = 0;
+    uint32_t n;
+    uint32_t ii;
+    double t0;
+    double tw;
+
+    if( ShmChan_Open( &ch, pName ) != 512 )
+    {
+        return 2;
+    }
+
+    t0 = Host_Now();
+    while( exp < pTotal )
+    {
+        tw = Host_Now();
+        n = ShmChan_RdWait( &ch, buff, SCTEST_BATCH, 2000 );
+        if( n == 0 )
+        {
+            return 3;
+        }
+        //o produtor nunca para tanto tempo: o aviso se perdeu
+        if( Host_Now() - tw > 1.0 )
+        {
+            return 6;
+        }
+        for(ii=0; ii < n; ii++)
+        {
+            if( buff[ii] != exp++ )
+            {
+                return 4;
+            }
+        }
+    }
+    printf( "consumer: %.1f M el/s\n", (double)pTotal / (Host_Now() - t0) * 1e-6 );
+    fflush( stdout );
+
+    //canal vazio: tem que expirar
+    if( ShmChan_RdWait( &ch, buff, 1, 50 ) != 0 )
+    {
+        return 5;
+    }
+    ShmChan_Close( &ch );
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t buff[SCTEST_BATCH];
+    char_t name[64];
+    shm_chan_t wr;
+    shm_chan_t dup;
+    uint64_t total = 2000000;
+    uint64_t val = 0;
+    uint64_t pause = 0;
+    uint32_t k;
+    uint32_t n;
+    uint32_t ii;
+    int status = 0;
+    pid_t pid;
+    pid_t done = 0;
+
+    if( argc > 1 )
+    {
+        total = strtoull( argv[1], NULL, 0 );
+    }
+    Host_Seed( 1 );
+
+    snprintf( name, sizeof(name), "/shm_chan_test.%d", (int)getpid() );
+    ShmChan_Unlink( name );
+
+    HOST_CHECK( ShmChan_Create( &wr, name, SCTEST_N, sizeof(uint64_t) ) == 512 );
+    HOST_CHECK( ShmChan_Create( &dup, name, SCTEST_N, sizeof(uint64_t) ) == 0 );
+
+    pid = fork();
+    if( pid == 0 )
+    {
+        _exit( _sctest_consumer( name, total ) );
+    }
+
+    while( val < total )
+    {
+        k = (uint32_t)MIN( (uint64_t)(1 + Host_RandN( SCTEST_BATCH )), total - val );
+        for(ii=0; ii < k; ii++)
+        {
+            buff[ii] = val + ii;
+        }
+        n = ShmChan_Wr( &wr, buff, k );
+        val += n;
+        if( n < k )
+        {
+            //canal cheio: o consumidor pode ter saido com erro
+            done = waitpid( pid, &status, WNOHANG );
+            if( done != 0 )
+            {
+                break;
+            }
+            sched_yield();
+        }
+        //pausa: o consumidor esvazia o canal e espera
+        if( val >= pause )
+        {
+            usleep( 1000 );
+            pause += 0x40000;
+        }
+    }
+
+    if( done == 0 )
+    {
+        waitpid( pid, &status, 0 );
+    }
+    ShmChan_Close( &wr );
+    HOST_CHECK( ShmChan_Unlink( name ) == RES_SUCCESS );
+    HOST_CHECK( WIFEXITED( status ) && (WEXITSTATUS( status ) == 0) );
+    if( WIFEXITED( status ) && (WEXITSTATUS( status ) != 0) )
+    {
+        fprintf( stderr, "consumer exited with %d\n", WEXITSTATUS( status ) );
+    }
+
+#if defined(SHMCHAN_FUTEX)
+    return Host_Result( "shm_chan_test (futex)" );
+#else
+    return Host_Result( "shm_chan_test (yield)" );
+#endif
+}
@@ -0,0 +1,200 @@
+/**************************************************************************//**
+ * @file     trace_test.c
+ * @brief    Host self-test and cost per event of the trace buffer.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * Checks the records left by #TRACE and by the traced ring buffer functions
+ * (writes, rejects, overwrites and reads), the timestamps across a wrap of the
+ * counter, a disabled class, the overwrite of the oldest records,
+ * #Trace_Snapshot and #Trace_Clear.
+ *
+ * Build and run (from this directory):
+ *
+ *     cc -std=gnu99 -O2 -D__ARCH_AMD64__ -DRINGBUFF_TRACE_ENABLE -I../../includes -I.. -o trace_test \
+ *         trace_test.c ../../sources/common/trace.c ../../sources/common/ring_buffer.c
+ *     ./trace_test [-b]
+ *
+ * The timestamp comes from a callback. For an inline cycle counter read, as
+ * with the DWT on target, add '-DTRACE_TIMESTAMP()=((uint32_t)__builtin_ia32_rdtsc())'.
+ * With -b it also prints the cost of a #TRACE.
+ *
+ ******************************************************************************/
+
+#include <string.h>
+
+//a classe 10 fica desligada
+#define TRACE_ENABLE_MASK   ( ~(1UL << 10) )
+
+#include "common/trace.h"
+#include "host_util.h"
+
+#define TRTEST_RECS         ( 16 )
+#define TRTEST_TS_STEP      ( 100 )
+#define TRTEST_BENCH_N      ( 50000000 )
+
+#define TRTEST_EV_SLICE     TRACE_ID( TRACE_KIND_BEGIN, TRACE_CLASS_USER, 1 )
+#define TRTEST_EV_SLICE_END TRACE_ID( TRACE_KIND_END, TRACE_CLASS_USER, 1 )
+#define TRTEST_EV_USED      TRACE_ID( TRACE_KIND_COUNTER, TRACE_CLASS_USER, 2 )
+#define TRTEST_EV_TICK      TRACE_ID( TRACE_KIND_INSTANT, 9, 0 )
+#define TRTEST_EV_OFF       TRACE_ID( TRACE_KIND_INSTANT, 10, 0 )
+
+/** Expected record: the ring's address in a0 when rb is set */
+typedef struct
+{
+    uint16_t id;
+    bool_t rb;
+    uint32_t a;
+}trtest_exp_t;
+
+static uint8_t _trtest_buff[TRTEST_RECS * sizeof(trace_rec_t)];
+
+//perto do fim: o contador da a volta durante o teste
+static uint32_t _trtest_now = 0xFFFFFF00;
+
+static uint32_t _trtest_ts( void )
+{
+    _trtest_now += TRTEST_TS_STEP;
+    return _trtest_now;
+}
+
+static void _trtest_events( void )
+{
+    //com a API inline, WrOne e RdOne nao sao registrados
+#if defined(RINGBUFF_INLINE_API)
+    static const trtest_exp_t exp[] =
+    {
+        { TRTEST_EV_SLICE, false, 42 },
+        { TRACE_EV_RB_WR, true, 6 },
+        { TRACE_EV_RB_REJECT, true, 4 },
+        { TRACE_EV_RB_WR, true, 2 },
+        { TRACE_EV_RB_RD, true, 3 },
+        { TRACE_EV_RB_RD, true, 2 },
+        { TRTEST_EV_USED, false, 0 },
+        { TRTEST_EV_SLICE_END, false, 0 },
+    };
+#else
+    static const trtest_exp_t exp[] =
+    {
+        { TRTEST_EV_SLICE, false, 42 },
+        { TRACE_EV_RB_WR, true, 6 },
+        { TRACE_EV_RB_REJECT, true, 4 },
+        { TRACE_EV_RB_WR, true, 2 },
+        { TRACE_EV_RB_OVERWRITE, true, 1 },
+        { TRACE_EV_RB_WR, true, 1 },
+        { TRACE_EV_RB_REJECT, true, 1 },
+        { TRACE_EV_RB_RD, true, 3 },
+        { TRACE_EV_RB_RD, true, 2 },
+        { TRACE_EV_RB_RD, true, 1 },
+        { TRTEST_EV_USED, false, 0 },
+        { TRTEST_EV_SLICE_END, false, 0 },
+    };
+#endif
+    trace_rec_t snap[2 * TRTEST_RECS];
+    uint8_t buff[8];
+    uint8_t el[8] = { 0 };
+    ringbuff_t rb;
+    uint32_t n;
+    uint32_t ii;
+
+    RingBuff_Init( &rb, buff, sizeof(buff), 1 );
+
+    TRACE( TRTEST_EV_SLICE, 7, 42 );
+    RingBuff_WrMany( &rb, el, 6, false );
+    RingBuff_WrMany( &rb, el, 6, false );   //cabem 2, 4 recusados
+    RingBuff_WrOne( &rb, el, true );        //sobrescreve 1
+    RingBuff_WrOne( &rb, el, false );       //recusado
+    RingBuff_RdMany( &rb, el, 3 );
+    RingBuff_RdMany( &rb, NULL, 2 );        //descarta
+    RingBuff_RdOne( &rb, el );
+    TRACE( TRTEST_EV_OFF, 1, 1 );           //classe desligada: nada
+    TRACE( TRTEST_EV_USED, 0, 0 );
+    TRACE( TRTEST_EV_SLICE_END, 7, 0 );
+
+    n = Trace_Snapshot( snap, 2 * TRTEST_RECS );
+    HOST_CHECK( n == sizeof(exp) / sizeof(exp[0]) );
+    HOST_CHECK( Trace_Used() == n );
+
+    for(ii=0; ii < MIN( n, (uint32_t)(sizeof(exp) / sizeof(exp[0])) ); ii++)
+    {
+        HOST_CHECK( snap[ii].id == exp[ii].id );
+        HOST_CHECK( snap[ii].rsvd == 0 );
+        if( exp[ii].rb )
+        {
+            HOST_CHECK( snap[ii].a0 == (uint32_t)(uintptr_t)&rb );
+            HOST_CHECK( snap[ii].a1 == exp[ii].a );
+        }
+#if defined(TRACE_TIMESTAMP_CB)
+        //passos constantes, inclusive na volta do contador
+        HOST_CHECK( snap[ii].ts == (uint32_t)(0xFFFFFF00 + (ii + 1) * TRTEST_TS_STEP) );
+#endif
+    }
+}
+
+/*
+ * The buffer keeps the newest records
+ */
+static void _trtest_overwrite( void )
+{
+    trace_rec_t snap[5];
+    uint32_t ii;
+
+    for(ii=0; ii < 40; ii++)
+    {
+        TRACE( TRTEST_EV_TICK, ii, 0 );
+    }
+    HOST_CHECK( Trace_Used() == TRTEST_RECS );
+
+    HOST_CHECK( Trace_Snapshot( snap, 5 ) == 5 );
+    for(ii=0; ii < 5; ii++)
+    {
+        HOST_CHECK( (snap[ii].id == TRTEST_EV_TICK) && (snap[ii].a0 == 35 + ii) );
+    }
+
+    Trace_Clear();
+    HOST_CHECK( Trace_Used() == 0 );
+    HOST_CHECK( Trace_Snapshot( snap, 5 ) == 0 );
+    HOST_CHECK( Trace_Snapshot( NULL, 5 ) == 0 );
+}
+
+static void _trtest_bench( void )
+{
+    static uint8_t big[1024 * sizeof(trace_rec_t)];
+    uint32_t ii;
+    double t0;
+
+    Trace_Init( big, sizeof(big), _trtest_ts );
+
+    t0 = Host_Now();
+    for(ii=0; ii < TRTEST_BENCH_N; ii++)
+    {
+        TRACE( TRTEST_EV_TICK, ii, 3 );
+    }
+#if defined(TRACE_TIMESTAMP_CB)
+    printf( "TRACE, callback timestamp: %.2f ns/event\n", (Host_Now() - t0) * 1e9 / TRTEST_BENCH_N );
+#else
+    printf( "TRACE, inline timestamp: %.2f ns/event\n", (Host_Now() - t0) * 1e9 / TRTEST_BENCH_N );
+#endif
+}
+
+int main(int argc, char **argv)
+{
+#if defined(TRACE_TIMESTAMP_CB)
+    HOST_CHECK( Trace_Init( _trtest_buff, sizeof(_trtest_buff), NULL ) == 0 );
+#endif
+    HOST_CHECK( Trace_Init( _trtest_buff, sizeof(_trtest_buff), _trtest_ts ) == TRTEST_RECS );
+
+    _trtest_events();
+    _trtest_overwrite();
+
+    if( (argc > 1) && (strcmp( argv[1], "-b" ) == 0) )
+    {
+        _trtest_bench();
+    }
+
+#if defined(TRACE_TIMESTAMP_CB)
+    return Host_Result( "trace_test (callback)" );
+#else
+    return Host_Result( "trace_test (inline timestamp)" );
+#endif
+}
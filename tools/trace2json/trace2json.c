@@ -0,0 +1,197 @@
+/**************************************************************************//**
+ * @file     trace2json.c
+ * @brief    Host tool: converts a trace buffer dump to Chrome trace JSON.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * The input is a file of #trace_rec_t records, oldest first, as copied by
+ * #Trace_Snapshot. The output opens in chrome://tracing and in Perfetto.
+ *
+ * Build and use (from this directory):
+ *
+ *     cc -D__ARCH_AMD64__ -I../../includes -o trace2json trace2json.c
+ *     ./trace2json [-f ticks_per_second] [-n names.txt] dump.bin > trace.json
+ *
+ * The 32-bit timestamps may wrap: they are unwrapped assuming less than one
+ * wrap between consecutive records. Timestamps default to 1 tick = 1 us.
+ *
+ * The names file has one "<event ID> <name>" pair per line, the ID in decimal
+ * or 0x hex. Events without a name are shown as "c<class>.e<number>".
+ *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "api_config.h"
+#include "common/trace.h"
+
+#define T2J_NAME_SZ     ( 48 )
+
+static char_t _t2j_names[ 1 << 16 ][ T2J_NAME_SZ ];
+
+static uint32_t _t2j_le32( const uint8_t *pBuff )
+{
+    return (uint32_t)pBuff[0] | ((uint32_t)pBuff[1] << 8) | ((uint32_t)pBuff[2] << 16) | ((uint32_t)pBuff[3] << 24);
+}
+
+static void _t2j_defaultNames( void )
+{
+    strcpy( _t2j_names[TRACE_EV_RB_WR], "rb.wr" );
+    strcpy( _t2j_names[TRACE_EV_RB_RD], "rb.rd" );
+    strcpy( _t2j_names[TRACE_EV_RB_OVERWRITE], "rb.overwrite" );
+    strcpy( _t2j_names[TRACE_EV_RB_REJECT], "rb.reject" );
+}
+
+static int _t2j_loadNames( const char_t *pPath )
+{
+    FILE *f = fopen( pPath, "r" );
+    char_t line[128];
+    char_t name[T2J_NAME_SZ];
+    long id;
+
+    if( f == NULL )
+    {
+        return -1;
+    }
+
+    while( fgets( line, sizeof(line), f ) != NULL )
+    {
+        if( (sscanf( line, "%li %47s", &id, name ) == 2) && (id >= 0) && (id <= 0xFFFF) )
+        {
+            strcpy( _t2j_names[id], name );
+        }
+    }
+
+    fclose( f );
+    return 0;
+}
+
+/*
+ * Writes a JSON string, escaping what the names file may bring
+ */
+static void _t2j_str( const char_t *pStr )
+{
+    putchar( '"' );
+    for( ; *pStr != 0; pStr++ )
+    {
+        if( (*pStr == '"') || (*pStr == '\\') )
+        {
+            putchar( '\\' );
+        }
+        if( (uint8_t)*pStr >= 0x20 )
+        {
+            putchar( *pStr );
+        }
+    }
+    putchar( '"' );
+}
+
+static void _t2j_name( uint16_t pId )
+{
+    char_t def[T2J_NAME_SZ];
+
+    if( _t2j_names[pId][0] == 0 )
+    {
+        snprintf( def, sizeof(def), "c%u.e%u", (unsigned)TRACE_ID_CLASS( pId ), (unsigned)TRACE_ID_NUM( pId ) );
+        _t2j_str( def );
+    }
+    else
+    {
+        _t2j_str( _t2j_names[pId] );
+    }
+}
+
+int main( int argc, char **argv )
+{
+    const char_t *inPath = NULL;
+    double hz = 1e6;
+    uint8_t raw[sizeof(trace_rec_t)];
+    trace_rec_t rec;
+    uint64_t ts = 0;
+    uint32_t prevTs = 0;
+    uint32_t count = 0;
+    FILE *in;
+    int ii;
+
+    _t2j_defaultNames();
+
+    for( ii = 1; ii < argc; ii++ )
+    {
+        if( (strcmp( argv[ii], "-f" ) == 0) && (ii + 1 < argc) )
+        {
+            hz = strtod( argv[++ii], NULL );
+        }
+        else if( (strcmp( argv[ii], "-n" ) == 0) && (ii + 1 < argc) )
+        {
+            if( _t2j_loadNames( argv[++ii] ) != 0 )
+            {
+                fprintf( stderr, "trace2json: can't read %s\n", argv[ii] );
+                return EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            inPath = argv[ii];
+        }
+    }
+
+    if( (inPath == NULL) || !(hz > 0) )
+    {
+        fprintf( stderr, "usage: trace2json [-f ticks_per_second] [-n names.txt] dump.bin > trace.json\n" );
+        return EXIT_FAILURE;
+    }
+
+    in = fopen( inPath, "rb" );
+    if( in == NULL )
+    {
+        fprintf( stderr, "trace2json: can't open %s\n", inPath );
+        return EXIT_FAILURE;
+    }
+
+    printf( "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n" );
+
+    while( fread( raw, sizeof(raw), 1, in ) == 1 )
+    {
+        //o dump vem do MCU: little-endian, independente do host
+        rec.ts = _t2j_le32( &raw[0] );
+        rec.id = (uint16_t)( raw[4] | (raw[5] << 8) );
+        rec.a0 = _t2j_le32( &raw[8] );
+        rec.a1 = _t2j_le32( &raw[12] );
+
+        ts = (count == 0) ? rec.ts : ts + (uint32_t)(rec.ts - prevTs);
+        prevTs = rec.ts;
+
+        printf( "%s{\"name\":", (count > 0) ? ",\n" : "" );
+        _t2j_name( rec.id );
+        printf( ",\"cat\":\"c%u\",\"pid\":1,\"ts\":%.3f,", (unsigned)TRACE_ID_CLASS( rec.id ), (double)ts * 1e6 / hz );
+
+        switch( TRACE_ID_KIND( rec.id ) )
+        {
+        case TRACE_KIND_BEGIN:
+            printf( "\"ph\":\"B\",\"tid\":%" PRIu32 ",\"args\":{\"a1\":%" PRIu32 "}}", rec.a0, rec.a1 );
+            break;
+
+        case TRACE_KIND_END:
+            printf( "\"ph\":\"E\",\"tid\":%" PRIu32 "}", rec.a0 );
+            break;
+
+        case TRACE_KIND_COUNTER:
+            printf( "\"ph\":\"C\",\"tid\":0,\"args\":{\"%" PRIu32 "\":%" PRIu32 "}}", rec.a1, rec.a0 );
+            break;
+
+        default:
+            printf( "\"ph\":\"i\",\"s\":\"t\",\"tid\":0,\"args\":{\"a0\":\"0x%08" PRIX32 "\",\"a1\":%" PRIu32 "}}",
+                    rec.a0, rec.a1 );
+            break;
+        }
+
+        count++;
+    }
+
+    printf( "\n]}\n" );
+    fclose( in );
+
+    fprintf( stderr, "trace2json: %" PRIu32 " records\n", count );
+    return EXIT_SUCCESS;
+}
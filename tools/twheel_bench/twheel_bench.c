@@ -0,0 +1,267 @@
+/**************************************************************************//**
+ * @file     twheel_bench.c
+ * @brief    Host check and benchmark of the timer wheel.
+ * @date     October/2026
+ * @author   Artur Rodrigues (securitoys at outlook.com)
+ *
+ * First checks the wheel against a model, with 1 to #TWHEEL_LEVELS_MAX levels
+ * and across the wrap of the tick counter: random starts, stops and ticks,
+ * with restarts and stops from the expiry callback. Each timer must expire
+ * exactly on its tick.
+ *
+ * Then, for N from 1k to 1M timers, starts N timers with 1..30000 ticks,
+ * stops half of them and ticks until all expired. Prints the cost of a start,
+ * a stop and an expiry, and of an insert in a sorted list.
+ *
+ * Build and run (from this directory):
+ *
+ *     cc -std=gnu99 -O2 -D__ARCH_AMD64__ -I../../includes -I.. -o twheel_bench \
+ *         twheel_bench.c ../../sources/common/timer_wheel.c
+ *     ./twheel_bench
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include "common/timer_wheel.h"
+#include "host_util.h"
+
+#define TWB_TIMERS          ( 2000 )
+#define TWB_STEPS           ( 4000 )
+#define TWB_BENCH_TICKS     ( 30000 )
+#define TWB_LIST_MAX        ( 100000 )
+
+/** Timer of the model check */
+typedef struct
+{
+    twheel_tmr_t tmr;
+    uint32_t due;       ///< Expected expiry tick
+    bool_t on;
+}twb_tmr_t;
+
+/** Node of the sorted list */
+typedef struct twb_node_s
+{
+    struct twb_node_s *next;
+    uint32_t expires;
+}twb_node_t;
+
+static twb_tmr_t _twb_tmrs[TWB_TIMERS];
+static uint32_t _twb_fired;
+
+/*
+ * Timeouts: short, medium and beyond the range of a few levels
+ */
+static uint32_t _twb_ticks( void )
+{
+    switch( Host_RandN( 5 ) )
+    {
+    case 0:
+        return Host_RandN( 70 );
+    case 1:
+        return Host_RandN( 5000 );
+    case 2:
+        return Host_RandN( 300000 );
+    case 3:
+        return Host_RandN( 1U << 26 );
+    default:
+        return 1;
+    }
+}
+
+static void _twb_start( twheel_t *pW, twb_tmr_t *pT, uint32_t pTicks )
+{
+    TimerWheel_Start( pW, &pT->tmr, pTicks );
+    pT->on = true;
+    pT->due = pW->now + MAX( pTicks, 1U ) - 1;
+}
+
+static void _twb_checkCb( twheel_t *pW, uint32_t pN, void *pCtx )
+{
+    twheel_tmr_t *tmr;
+    twb_tmr_t *t;
+    twb_tmr_t *other;
+    uint32_t got = 0;
+
+    (void)pCtx;
+    while( (tmr = TimerWheel_PopExpired( pW )) != NULL )
+    {
+        t = tmr->ctx;
+        got++;
+        _twb_fired++;
+
+        //o tick em curso ja avancou now
+        HOST_CHECK( t->on && (t->due == pW->now - 1) );
+        HOST_CHECK( !TimerWheel_IsRunning( tmr ) );
+        t->on = false;
+
+        if( Host_RandN( 4 ) == 0 )
+        {
+            _twb_start( pW, t, _twb_ticks() );
+        }
+        //para outro, talvez do mesmo lote
+        if( Host_RandN( 8 ) == 0 )
+        {
+            other = &_twb_tmrs[Host_RandN( TWB_TIMERS )];
+            HOST_CHECK( TimerWheel_Stop( pW, &other->tmr ) == (uint32_t)other->on );
+            other->on = false;
+        }
+    }
+    HOST_CHECK( got <= pN );
+}
+
+static void _twb_check( void )
+{
+    static void *slots[TWHEEL_LEVELS_MAX * TWHEEL_SLOTS];
+    twb_tmr_t *t;
+    twheel_t w;
+    uint32_t lvl;
+    uint32_t step;
+    uint32_t used;
+    uint32_t ii;
+
+    for(lvl=1; lvl <= TWHEEL_LEVELS_MAX; lvl++)
+    {
+        HOST_CHECK( TimerWheel_Init( &w, slots, TWHEEL_BUFF_SZ( lvl ), _twb_checkCb, NULL ) == lvl );
+        //atravessa a volta do contador
+        w.now = 0xFFFFFFFF - 100000 * lvl;
+        for(ii=0; ii < TWB_TIMERS; ii++)
+        {
+            TimerWheel_TmrInit( &_twb_tmrs[ii].tmr, &_twb_tmrs[ii] );
+            _twb_tmrs[ii].on = false;
+        }
+        _twb_fired = 0;
+
+        for(step=0; step < TWB_STEPS; step++)
+        {
+            for(ii=0; ii < 5; ii++)
+            {
+                t = &_twb_tmrs[Host_RandN( TWB_TIMERS )];
+                if( Host_RandN( 3 ) == 0 )
+                {
+                    HOST_CHECK( TimerWheel_Stop( &w, &t->tmr ) == (uint32_t)t->on );
+                    t->on = false;
+                }
+                else
+                {
+                    _twb_start( &w, t, _twb_ticks() );
+                }
+            }
+            TimerWheel_Tick( &w, Host_RandN( 3000 ) );
+
+            //nenhum ficou para tras, e a contagem bate
+            used = 0;
+            for(ii=0; ii < TWB_TIMERS; ii++)
+            {
+                t = &_twb_tmrs[ii];
+                HOST_CHECK( !t->on || ((int32_t)(t->due - w.now) >= 0) );
+                HOST_CHECK( TimerWheel_IsRunning( &t->tmr ) == t->on );
+                used += t->on;
+            }
+            HOST_CHECK( TimerWheel_Used( &w ) == used );
+        }
+        printf( "%u levels: %u expired\n", (unsigned)lvl, (unsigned)_twb_fired );
+    }
+
+    HOST_CHECK( TimerWheel_Init( &w, slots, TWHEEL_BUFF_SZ( 1 ) - 1, _twb_checkCb, NULL ) == 0 );
+    HOST_CHECK( TimerWheel_Init( &w, NULL, sizeof(slots), _twb_checkCb, NULL ) == 0 );
+}
+
+static void _twb_benchCb( twheel_t *pW, uint32_t pN, void *pCtx )
+{
+    (void)pN;
+    (void)pCtx;
+    while( TimerWheel_PopExpired( pW ) != NULL )
+    {
+        _twb_fired++;
+    }
+}
+
+static void _twb_bench( uint32_t pN )
+{
+    static void *slots[4 * TWHEEL_SLOTS];
+    twheel_tmr_t *tmrs = malloc( pN * sizeof(twheel_tmr_t) );
+    uint32_t *ticks = malloc( pN * sizeof(uint32_t) );
+    twb_node_t *nodes;
+    twb_node_t *head = NULL;
+    twb_node_t **pp;
+    twheel_t w;
+    uint32_t ii;
+    double t0;
+    double t1;
+    double t2;
+    double t3;
+
+    if( (tmrs == NULL) || (ticks == NULL) )
+    {
+        HOST_CHECK( false );
+        free( tmrs );
+        free( ticks );
+        return;
+    }
+
+    TimerWheel_Init( &w, slots, sizeof(slots), _twb_benchCb, NULL );
+    for(ii=0; ii < pN; ii++)
+    {
+        TimerWheel_TmrInit( &tmrs[ii], NULL );
+        ticks[ii] = 1 + Host_RandN( TWB_BENCH_TICKS );
+    }
+
+    t0 = Host_Now();
+    for(ii=0; ii < pN; ii++)
+    {
+        TimerWheel_Start( &w, &tmrs[ii], ticks[ii] );
+    }
+    t1 = Host_Now();
+    for(ii=0; ii < pN; ii+=2)
+    {
+        TimerWheel_Stop( &w, &tmrs[ii] );
+    }
+    t2 = Host_Now();
+    _twb_fired = 0;
+    TimerWheel_Tick( &w, TWB_BENCH_TICKS + 1 );
+    t3 = Host_Now();
+
+    HOST_CHECK( (_twb_fired == pN / 2) && (TimerWheel_Used( &w ) == 0) );
+    printf( "N=%7u  start %6.1f ns  stop %6.1f ns  expire %6.1f ns/timer (%.1f ns/tick)",
+            (unsigned)pN, (t1 - t0) * 1e9 / pN, (t2 - t1) * 1e9 / (pN / 2),
+            (t3 - t2) * 1e9 / MAX( _twb_fired, 1U ), (t3 - t2) * 1e9 / (TWB_BENCH_TICKS + 1) );
+
+    //lista ordenada: insercao O(N)
+    nodes = (pN <= TWB_LIST_MAX) ? malloc( pN * sizeof(twb_node_t) ) : NULL;
+    if( nodes != NULL )
+    {
+        t0 = Host_Now();
+        for(ii=0; ii < pN; ii++)
+        {
+            pp = &head;
+            while( (*pp != NULL) && ((*pp)->expires <= ticks[ii]) )
+            {
+                pp = &(*pp)->next;
+            }
+            nodes[ii].expires = ticks[ii];
+            nodes[ii].next = *pp;
+            *pp = &nodes[ii];
+        }
+        printf( "  sorted-list insert %9.1f ns", (Host_Now() - t0) * 1e9 / pN );
+        free( nodes );
+    }
+    printf( "\n" );
+
+    free( tmrs );
+    free( ticks );
+}
+
+int main(void)
+{
+    uint32_t n;
+
+    Host_Seed( 1 );
+    _twb_check();
+
+    for(n=1000; n <= 1000000; n*=10)
+    {
+        _twb_bench( n );
+    }
+
+    return Host_Result( "twheel_bench" );
+}